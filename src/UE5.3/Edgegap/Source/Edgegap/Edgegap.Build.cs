@@ -51,6 +51,7 @@ public class Edgegap : ModuleRules
                 "LauncherServices",
                 "DerivedDataCache",
                 "HTTP",
+                "HTTPServer",
                 "Json",
                 "JsonUtilities",
                 "ImageWrapper",
@@ -78,7 +79,10 @@ public class Edgegap : ModuleRules
                 "SettingsEditor",
                 "Zen",
                 "DeveloperSettings",
-                "DesktopWidgets"
+                "DesktopWidgets",
+                "Sockets",
+                "Networking",
+                "EdgegapServer"
             }
         );
 
@@ -2,7 +2,17 @@
 #include "Developer/Settings/Public/ISettingsModule.h"
 #include "APIToken/APITokenSettings.h"
 #include "APIToken/APITokenSettingsCustomization.h"
+#include "Deployments/EdgegapDeploymentPoller.h"
+#include "Deployments/EdgegapPublicIPCache.h"
+#include "Deployments/EdgegapTimeToReadyTracker.h"
+#include "Deployments/EdgegapLatencyProbe.h"
+#include "Deployments/EdgegapReadyWaiter.h"
+#include "Deployments/EdgegapPlayOnDeployment.h"
+#include "Deployments/EdgegapStateSnapshot.h"
+#include "Deployments/SEdgegapContainerLogView.h"
+#include "Mock/EdgegapMockApiServer.h"
 #include "UObject/Package.h"
+#include "Editor.h"
 #include "Features/IModularFeatures.h"
 	
 IMPLEMENT_MODULE(Edgegap, Edgegap);
@@ -15,6 +25,14 @@ void Edgegap::StartupModule()
 	PropertyModule.RegisterCustomPropertyTypeLayout(FAPITokenSettings::StaticStruct()->GetFName(), FOnGetPropertyTypeCustomizationInstance::CreateStatic(&FAPITokenSettingsCustomization::MakeInstance));
 	PropertyModule.RegisterCustomClassLayout(UEdgegapSettings::StaticClass()->GetFName(), FOnGetDetailCustomizationInstance::CreateStatic(&FEdgegapSettingsDetails::MakeInstance));
 
+	FEdgegapDeploymentPoller::Get().Startup();
+	FEdgegapStateSnapshot::Get().Startup();
+	FEdgegapPublicIPCache::Get().Startup();
+	FEdgegapTimeToReadyTracker::Get().Startup();
+	FEdgegapLatencyProbe::Get().Startup();
+	FEdgegapReadyWaiter::Get().Startup();
+	SEdgegapContainerLogView::RegisterTabSpawner();
+
     EdgegapPluginCommands::Register();
 
     PluginCommands = MakeShareable(new FUICommandList);
@@ -24,6 +42,11 @@ void Edgegap::StartupModule()
         FExecuteAction::CreateRaw(this, &Edgegap::Do_BuildAndPush),
         FCanExecuteAction::CreateRaw(this, &Edgegap::Can_BuildAndPush));
 
+    PluginCommands->MapAction(
+        EdgegapPluginCommands::Get().DeployAndPlayCommand,
+        FExecuteAction::CreateRaw(this, &Edgegap::Do_DeployAndPlay),
+        FCanExecuteAction::CreateRaw(this, &Edgegap::Can_DeployAndPlay));
+
     PluginCommands->MapAction(
         EdgegapPluginCommands::Get().SettingsCommand,
         FExecuteAction::CreateRaw(this, &Edgegap::Do_OpenSettings),
@@ -55,6 +78,16 @@ void Edgegap::StartupModule()
 
 void Edgegap::ShutdownModule()
 {
+	SEdgegapContainerLogView::UnregisterTabSpawner();
+	FEdgegapTimeToReadyTracker::Get().Shutdown();
+	FEdgegapLatencyProbe::Get().Shutdown();
+	FEdgegapPlayOnDeployment::Get().Shutdown();
+	FEdgegapReadyWaiter::Get().Shutdown();
+	FEdgegapStateSnapshot::Get().Shutdown();
+	FEdgegapDeploymentPoller::Get().Shutdown();
+	FEdgegapPublicIPCache::Get().Shutdown();
+	FEdgegapMockApiServer::Get().Stop();
+
 	if (UObjectInitialized())
 	{
 		UnregisterSettings();
@@ -88,6 +121,9 @@ TSharedRef<SWidget> Edgegap::MakeEdgegapMenu()
         MainSection.AddMenuEntryWithCommandList(
             EdgegapPluginCommands::Get().BuildAndPushCommand,
             PluginCommands);
+        MainSection.AddMenuEntryWithCommandList(
+            EdgegapPluginCommands::Get().DeployAndPlayCommand,
+            PluginCommands);
         MainSection.AddMenuEntryWithCommandList(
             EdgegapPluginCommands::Get().SettingsCommand,
             PluginCommands);
@@ -148,6 +184,13 @@ void EdgegapPluginCommands::RegisterCommands()
         EUserInterfaceActionType::Button,
         FInputChord());
 
+    UI_COMMAND(
+        DeployAndPlayCommand,
+        "Deploy and Play",
+        "Reuses a ready deployment of the last pushed version or deploys one, then starts clients connected to it.",
+        EUserInterfaceActionType::Button,
+        FInputChord());
+
     UI_COMMAND(
         SettingsCommand,
         "Settings...",
@@ -163,7 +206,17 @@ void Edgegap::Do_BuildAndPush()
 
 bool Edgegap::Can_BuildAndPush()
 {
-    return bCanBuildAndPush;
+    return bCanBuildAndPush && !FEdgegapSettingsDetails::bBuildAndPushInFlight;
+}
+
+void Edgegap::Do_DeployAndPlay()
+{
+    FEdgegapPlayOnDeployment::Get().Start();
+}
+
+bool Edgegap::Can_DeployAndPlay()
+{
+    return !FEdgegapPlayOnDeployment::Get().IsInProgress() && GEditor && !GEditor->IsPlaySessionInProgress();
 }
 
 void Edgegap::Do_OpenSettings()
@@ -97,6 +97,8 @@ private:
 
 	void Do_BuildAndPush();
 	bool Can_BuildAndPush();
+	void Do_DeployAndPlay();
+	bool Can_DeployAndPlay();
 	void Do_OpenSettings();
 	bool Can_OpenSettings();
 
@@ -123,5 +125,6 @@ public:
 
 public:
 	TSharedPtr<FUICommandInfo> BuildAndPushCommand;
+	TSharedPtr<FUICommandInfo> DeployAndPlayCommand;
 	TSharedPtr<FUICommandInfo> SettingsCommand;
 };
@@ -0,0 +1,339 @@
+#include "EdgegapBatchDeploy.h"
+#include "EdgegapDeploymentPoller.h"
+#include "EdgegapDeploymentRequests.h"
+#include "EdgegapPublicIPCache.h"
+#include "EdgegapRequestFanOut.h"
+#include "EdgegapSettings.h"
+#include "EdgegapSettingsDetails.h"
+#include "Widgets/Notifications/SNotificationList.h"
+#include "Framework/Notifications/NotificationManager.h"
+
+#define LOCTEXT_NAMESPACE "EdgegapBatchDeploy"
+
+namespace
+{
+	const float TimeoutCheckRate = 1.0f;
+}
+
+TSharedPtr<FEdgegapBatchDeploy> FEdgegapBatchDeploy::Latest;
+TArray<TSharedRef<FEdgegapBatchDeploy>> FEdgegapBatchDeploy::ActiveBatches;
+
+TSharedRef<FEdgegapBatchDeploy> FEdgegapBatchDeploy::Start(const FString& AppName, const FString& VersionName, const FString& API_key, int32 Count, const TArray<FString>& PlayerIPs)
+{
+	TSharedRef<FEdgegapBatchDeploy> Batch = MakeShareable(new FEdgegapBatchDeploy());
+
+	Batch->AppName = AppName;
+	Batch->VersionName = VersionName;
+	Batch->API_key = API_key;
+	Batch->StartTime = FPlatformTime::Seconds();
+	Batch->Deployments.SetNum(FMath::Max(Count, 1));
+
+	for (int32 Index = 0; Index < Batch->Deployments.Num(); ++Index)
+	{
+		if (PlayerIPs.Num() > 0)
+		{
+			Batch->Deployments[Index].IPList.Add(PlayerIPs[Index % PlayerIPs.Num()]);
+		}
+	}
+
+	Latest = Batch;
+	ActiveBatches.Add(Batch);
+
+	FEdgegapDeploymentPoller& Poller = FEdgegapDeploymentPoller::Get();
+	Poller.OnDeploymentsUpdated().AddSP(Batch, &FEdgegapBatchDeploy::HandleDeploymentsUpdated);
+	Poller.AddWatcher(&Batch.Get());
+
+	Batch->TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(Batch, &FEdgegapBatchDeploy::Tick), TimeoutCheckRate);
+
+	UE_LOG(EdgegapLog, Log, TEXT("BatchDeploy: Deploying %s %d times"), *VersionName, Batch->Deployments.Num());
+
+	if (PlayerIPs.Num() > 0)
+	{
+		Batch->Launch(FString());
+	}
+	else
+	{
+		TWeakPtr<FEdgegapBatchDeploy> WeakBatch = Batch;
+		FEdgegapPublicIPCache::Get().ResolvePublicIP([WeakBatch](const FString& PublicIP)
+		{
+			if (TSharedPtr<FEdgegapBatchDeploy> Batch = WeakBatch.Pin())
+			{
+				Batch->Launch(PublicIP);
+			}
+		});
+	}
+
+	return Batch;
+}
+
+void FEdgegapBatchDeploy::Launch(const FString& PublicIP)
+{
+	if (bFinished)
+	{
+		return;
+	}
+
+	for (FEdgegapBatchDeployment& Deployment : Deployments)
+	{
+		if (Deployment.IPList.Num() > 0)
+		{
+			continue;
+		}
+
+		if (PublicIP.IsEmpty())
+		{
+			UE_LOG(EdgegapLog, Warning, TEXT("BatchDeploy: Could not determine the public IP, nothing deployed"));
+
+			for (FEdgegapBatchDeployment& NotSent : Deployments)
+			{
+				NotSent.State = FEdgegapBatchDeployment::EState::Failed;
+				NotSent.Error = TEXT("Could not determine the public IP, set a Public IP Override in the Deployments settings");
+			}
+
+			bRequestsDone = true;
+			CheckFinished();
+			return;
+		}
+
+		Deployment.IPList.Add(PublicIP);
+	}
+
+	const int32 MaxConcurrency = GetDefault<UEdgegapSettings>()->BatchDeployConcurrency;
+	TWeakPtr<FEdgegapBatchDeploy> WeakThis = AsShared();
+
+	FanOut = FEdgegapRequestFanOut::Start(Deployments.Num(), MaxConcurrency, [WeakThis](int32 JobIndex, FEdgegapRequestFanOut::FJobDone Done)
+	{
+		TSharedPtr<FEdgegapBatchDeploy> This = WeakThis.Pin();
+		if (!This.IsValid() || This->bFinished)
+		{
+			Done(false, 0.0);
+			return;
+		}
+
+		This->Deployments[JobIndex].RequestedTime = FPlatformTime::Seconds();
+
+		FEdgegapDeploymentRequests::Deploy(This->AppName, This->VersionName, This->API_key, This->Deployments[JobIndex].IPList, [WeakThis, JobIndex, Done, API_key = This->API_key](const FEdgegapRequestResult& Result)
+		{
+			TSharedPtr<FEdgegapBatchDeploy> This = WeakThis.Pin();
+
+			// Accepted after the batch timed out or was cancelled, nobody waits for it
+			if (Result.bSucceeded && (!This.IsValid() || This->bFinished))
+			{
+				UE_LOG(EdgegapLog, Log, TEXT("BatchDeploy: Stopping %s, deployed after the batch ended"), *Result.RequestID);
+				FEdgegapDeploymentRequests::StopMany({ Result.RequestID }, API_key);
+			}
+			else if (This.IsValid())
+			{
+				FEdgegapBatchDeployment& Deployment = This->Deployments[JobIndex];
+
+				if (Result.bSucceeded)
+				{
+					Deployment.State = FEdgegapBatchDeployment::EState::Requested;
+					Deployment.RequestID = Result.RequestID;
+				}
+				else if (Result.RetryAfter <= 0.0)
+				{
+					UE_LOG(EdgegapLog, Warning, TEXT("BatchDeploy: Deployment %d failed, %s"), JobIndex, *Result.Error);
+
+					Deployment.State = FEdgegapBatchDeployment::EState::Failed;
+					Deployment.Error = Result.Error;
+				}
+			}
+
+			Done(Result.bSucceeded, Result.RetryAfter);
+		});
+	}, [WeakThis](int32 NumSucceeded, int32 NumFailed)
+	{
+		if (TSharedPtr<FEdgegapBatchDeploy> This = WeakThis.Pin())
+		{
+			UE_LOG(EdgegapLog, Log, TEXT("BatchDeploy: %d deploy requests accepted, %d failed after %.1fs"), NumSucceeded, NumFailed, FPlatformTime::Seconds() - This->StartTime);
+
+			// Requests given up on after repeated rate limiting never got a state of their own
+			for (FEdgegapBatchDeployment& Deployment : This->Deployments)
+			{
+				if (Deployment.State == FEdgegapBatchDeployment::EState::Queued)
+				{
+					Deployment.State = FEdgegapBatchDeployment::EState::Failed;
+					Deployment.Error = TEXT("Not sent");
+				}
+			}
+
+			This->bRequestsDone = true;
+			FEdgegapDeploymentPoller::Get().ExpectTransition();
+			FEdgegapDeploymentPoller::Get().PollNow(This->API_key);
+
+			This->CheckFinished();
+		}
+	});
+}
+
+void FEdgegapBatchDeploy::Cancel()
+{
+	if (FanOut.IsValid())
+	{
+		FanOut->Cancel();
+	}
+
+	CheckFinished(TEXT("Cancelled"));
+}
+
+bool FEdgegapBatchDeploy::Tick(float DeltaTime)
+{
+	if (FPlatformTime::Seconds() - StartTime > GetDefault<UEdgegapSettings>()->BatchReadyTimeout)
+	{
+		CheckFinished(TEXT("Timed out"));
+	}
+
+	return !bFinished;
+}
+
+void FEdgegapBatchDeploy::HandleDeploymentsUpdated(const TArray<TSharedPtr<FDeploymentStatusListItem>>& InDeployments)
+{
+	if (bFinished)
+	{
+		return;
+	}
+
+	TMap<FString, const FDeploymentStatusListItem*> ByRequestID;
+	ByRequestID.Reserve(InDeployments.Num());
+	for (const TSharedPtr<FDeploymentStatusListItem>& Item : InDeployments)
+	{
+		ByRequestID.Add(Item->RequestID, Item.Get());
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	for (FEdgegapBatchDeployment& Deployment : Deployments)
+	{
+		if (Deployment.State != FEdgegapBatchDeployment::EState::Requested)
+		{
+			continue;
+		}
+
+		const FDeploymentStatusListItem* const* Item = ByRequestID.Find(Deployment.RequestID);
+		if (!Item)
+		{
+			continue;
+		}
+
+		if ((*Item)->DeploymentReady)
+		{
+			Deployment.State = FEdgegapBatchDeployment::EState::Ready;
+			Deployment.ReadyTime = Now;
+		}
+		else if (!(*Item)->IsTransitioning())
+		{
+			Deployment.State = FEdgegapBatchDeployment::EState::Failed;
+			Deployment.Error = (*Item)->DeploymentStatus;
+		}
+	}
+
+	CheckFinished();
+}
+
+void FEdgegapBatchDeploy::CheckFinished(const TCHAR* GiveUpReason)
+{
+	if (bFinished)
+	{
+		return;
+	}
+
+	int32 NumReady = 0;
+	int32 NumPending = 0;
+	TArray<double> TimesToReady;
+
+	for (FEdgegapBatchDeployment& Deployment : Deployments)
+	{
+		switch (Deployment.State)
+		{
+		case FEdgegapBatchDeployment::EState::Ready:
+			++NumReady;
+			TimesToReady.Add(Deployment.ReadyTime - Deployment.RequestedTime);
+			break;
+		case FEdgegapBatchDeployment::EState::Queued:
+		case FEdgegapBatchDeployment::EState::Requested:
+			++NumPending;
+			break;
+		default:
+			break;
+		}
+	}
+
+	if (!GiveUpReason && (NumPending > 0 || !bRequestsDone))
+	{
+		return;
+	}
+
+	// Deployments given up on would otherwise keep running (and billing) on Edgegap
+	TArray<FString> Abandoned;
+
+	for (FEdgegapBatchDeployment& Deployment : Deployments)
+	{
+		if (Deployment.State == FEdgegapBatchDeployment::EState::Requested)
+		{
+			Abandoned.Add(Deployment.RequestID);
+		}
+
+		if (Deployment.State == FEdgegapBatchDeployment::EState::Queued || Deployment.State == FEdgegapBatchDeployment::EState::Requested)
+		{
+			Deployment.State = FEdgegapBatchDeployment::EState::Failed;
+			Deployment.Error = GiveUpReason;
+		}
+	}
+
+	if (Abandoned.Num() > 0)
+	{
+		UE_LOG(EdgegapLog, Log, TEXT("BatchDeploy: Stopping %d deployments that were not ready"), Abandoned.Num());
+		FEdgegapDeploymentRequests::StopMany(Abandoned, API_key);
+	}
+
+	bFinished = true;
+	FinishTime = FPlatformTime::Seconds();
+
+	FEdgegapDeploymentPoller& Poller = FEdgegapDeploymentPoller::Get();
+	Poller.OnDeploymentsUpdated().RemoveAll(this);
+	Poller.RemoveWatcher(this);
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	TimesToReady.Sort();
+	const double Median = TimesToReady.Num() > 0 ? TimesToReady[TimesToReady.Num() / 2] : 0.0;
+	const double Slowest = TimesToReady.Num() > 0 ? TimesToReady.Last() : 0.0;
+
+	UE_LOG(EdgegapLog, Log, TEXT("BatchDeploy: %d/%d deployments ready after %.1fs (time to ready median %.1fs, slowest %.1fs)"),
+		NumReady, Deployments.Num(), FinishTime - StartTime, Median, Slowest);
+
+	FNotificationInfo Info(GetSummary());
+	Info.ExpireDuration = 5.0f;
+	FSlateNotificationManager::Get().AddNotification(Info);
+
+	// May release the last reference, keep this alive until we return
+	TSharedRef<FEdgegapBatchDeploy> KeepAlive = AsShared();
+	ActiveBatches.Remove(KeepAlive);
+}
+
+FText FEdgegapBatchDeploy::GetSummary() const
+{
+	int32 NumReady = 0;
+	int32 NumFailed = 0;
+
+	for (const FEdgegapBatchDeployment& Deployment : Deployments)
+	{
+		NumReady += Deployment.State == FEdgegapBatchDeployment::EState::Ready;
+		NumFailed += Deployment.State == FEdgegapBatchDeployment::EState::Failed;
+	}
+
+	const double Elapsed = (bFinished ? FinishTime : FPlatformTime::Seconds()) - StartTime;
+
+	if (bFinished)
+	{
+		return FText::Format(LOCTEXT("BatchFinished", "Batch: {0}/{1} ready, {2} failed, finished in {3}s"),
+			NumReady, Deployments.Num(), NumFailed, FText::AsNumber(FMath::RoundToInt(Elapsed)));
+	}
+
+	return FText::Format(LOCTEXT("BatchRunning", "Batch: {0}/{1} ready, {2} failed, {3}s elapsed"),
+		NumReady, Deployments.Num(), NumFailed, FText::AsNumber(FMath::RoundToInt(Elapsed)));
+}
+
+#undef LOCTEXT_NAMESPACE
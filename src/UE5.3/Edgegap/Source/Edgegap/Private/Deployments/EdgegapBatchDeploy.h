@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "EdgegapDeploymentTypes.h"
+
+class FEdgegapRequestFanOut;
+
+struct FEdgegapBatchDeployment
+{
+	enum class EState : uint8
+	{
+		Queued,
+		Requested,
+		Ready,
+		Failed
+	};
+
+	EState State = EState::Queued;
+	TArray<FString> IPList;
+	FString RequestID;
+	FString Error;
+	double RequestedTime = 0.0;
+	double ReadyTime = 0.0;
+};
+
+/**
+ * Deploys the same version N times through a bounded fan-out and follows every deployment through
+ * the shared poller until it is ready, failed or timed out, then reports the aggregate time-to-all-ready.
+ */
+class FEdgegapBatchDeploy : public TSharedFromThis<FEdgegapBatchDeploy>
+{
+public:
+	/**
+	 * @param	PlayerIPs	Spread round-robin over the deployments, one each. Empty uses this machine's public IP.
+	 */
+	static TSharedRef<FEdgegapBatchDeploy> Start(const FString& AppName, const FString& VersionName, const FString& API_key, int32 Count, const TArray<FString>& PlayerIPs);
+
+	/** The most recently started batch, kept after it finished so its result can still be shown */
+	static TSharedPtr<FEdgegapBatchDeploy> GetLatest() { return Latest; }
+
+	/** Stops sending deploys and stops the deployments that aren't ready yet */
+	void Cancel();
+
+	bool IsFinished() const { return bFinished; }
+
+	FText GetSummary() const;
+
+	const TArray<FEdgegapBatchDeployment>& GetDeployments() const { return Deployments; }
+
+private:
+	FEdgegapBatchDeploy() {}
+
+	void Launch(const FString& PublicIP);
+	void HandleDeploymentsUpdated(const TArray<TSharedPtr<FDeploymentStatusListItem>>& InDeployments);
+	bool Tick(float DeltaTime);
+
+	/** @param	GiveUpReason	When set, finishes now and fails whatever is still pending with it. */
+	void CheckFinished(const TCHAR* GiveUpReason = nullptr);
+
+	FString AppName;
+	FString VersionName;
+	FString API_key;
+
+	TArray<FEdgegapBatchDeployment> Deployments;
+	TSharedPtr<FEdgegapRequestFanOut> FanOut;
+
+	// Drives the ready timeout, polls may keep failing
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	double StartTime = 0.0;
+	double FinishTime = 0.0;
+	bool bRequestsDone = false;
+	bool bFinished = false;
+
+	static TSharedPtr<FEdgegapBatchDeploy> Latest;
+	static TArray<TSharedRef<FEdgegapBatchDeploy>> ActiveBatches;
+};
@@ -0,0 +1,228 @@
+#include "EdgegapContainerLogs.h"
+#include "EdgegapRequestFanOut.h"
+#include "EdgegapSettings.h"
+#include "EdgegapSettingsDetails.h"
+#include "HttpModule.h"
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+	const float LogTickRate = 0.25f;
+
+	// Longer lines are cut, so a single runaway line can't defeat the line limit
+	const int32 MaxLineLength = 4096;
+}
+
+FEdgegapContainerLogStream::FEdgegapContainerLogStream(const FString& InRequestID, const FString& InAPI_key)
+	: RequestID(InRequestID)
+	, API_key(InAPI_key)
+	, Lines(GetDefault<UEdgegapSettings>()->ContainerLogMaxLines)
+{
+}
+
+FEdgegapContainerLogStream::~FEdgegapContainerLogStream()
+{
+	Stop();
+}
+
+void FEdgegapContainerLogStream::Start()
+{
+	if (!TickerHandle.IsValid())
+	{
+		NextFetchTime = 0.0;
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FEdgegapContainerLogStream::Tick), LogTickRate);
+	}
+}
+
+void FEdgegapContainerLogStream::Stop()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
+
+bool FEdgegapContainerLogStream::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	if (!bRequestInFlight && Now >= NextFetchTime)
+	{
+		NextFetchTime = Now + GetDefault<UEdgegapSettings>()->ContainerLogPollInterval;
+		Fetch();
+	}
+
+	return true;
+}
+
+void FEdgegapContainerLogStream::Fetch()
+{
+	const FString endpoint = FString::Printf(TEXT("v1/deployment/%s/container-logs"), *RequestID);
+
+	FString URL = FString::Printf(TEXT("%s%s"), *UEdgegapSettings::GetApiBaseURL(), *endpoint);
+
+	FHttpRequestRef Request = FHttpModule::Get().CreateRequest();
+
+	Request->SetURL(URL);
+	Request->SetVerb("GET");
+	Request->SetHeader(TEXT("User-Agent"), TEXT("X-UnrealEngine-Agent"));
+	Request->SetHeader(TEXT("Authorization"), *API_key);
+
+	TWeakPtr<FEdgegapContainerLogStream> WeakThis = AsShared();
+	const FCursor PreviousCursor = Cursor;
+
+	Request->OnProcessRequestComplete().BindLambda([WeakThis, PreviousCursor](FHttpRequestPtr Request, FHttpResponsePtr ResponsePtr, bool bWasSuccessful)
+	{
+		TSharedPtr<FEdgegapContainerLogStream> This = WeakThis.Pin();
+		if (!This.IsValid())
+		{
+			return;
+		}
+
+		if (!bWasSuccessful || !ResponsePtr.IsValid() || ResponsePtr->GetResponseCode() < 200 || ResponsePtr->GetResponseCode() > 299)
+		{
+			This->bRequestInFlight = false;
+			This->LastError = FString::Printf(TEXT("HTTP request failed with code %d"), ResponsePtr.IsValid() ? ResponsePtr->GetResponseCode() : 0);
+
+			// Logs aren't worth eating into the rate limit the rest of the plugin shares
+			const double RetryAfter = FEdgegapRequestFanOut::GetRetryAfter(ResponsePtr);
+			if (RetryAfter > 0.0)
+			{
+				This->NextFetchTime = FMath::Max(This->NextFetchTime, FPlatformTime::Seconds() + RetryAfter);
+			}
+
+			UE_LOG(EdgegapLog, Verbose, TEXT("ContainerLogs: %s, %s"), *This->RequestID, *This->LastError);
+			return;
+		}
+
+		// A long running server's log is megabytes, keep splitting and matching it off the game thread
+		Async(EAsyncExecution::ThreadPool, [WeakThis, PreviousCursor, ResponsePtr]()
+		{
+			TArray<FString> NewLines;
+			FCursor NewCursor = PreviousCursor;
+			bool bRestarted = false;
+
+			FString Logs;
+			TSharedPtr<FJsonObject> JsonObject;
+			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponsePtr->GetContentAsString());
+			const bool bParsed = FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid() && JsonObject->TryGetStringField(TEXT("logs"), Logs);
+			if (bParsed)
+			{
+				FindNewLines(Logs, PreviousCursor, NewLines, NewCursor, bRestarted);
+			}
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, bParsed, NewLines = MoveTemp(NewLines), NewCursor, bRestarted]() mutable
+			{
+				TSharedPtr<FEdgegapContainerLogStream> This = WeakThis.Pin();
+				if (!This.IsValid())
+				{
+					return;
+				}
+
+				if (!bParsed)
+				{
+					This->bRequestInFlight = false;
+					This->LastError = TEXT("Could not parse the logs response");
+
+					UE_LOG(EdgegapLog, Verbose, TEXT("ContainerLogs: %s, %s"), *This->RequestID, *This->LastError);
+					return;
+				}
+
+				This->HandleNewLines(MoveTemp(NewLines), NewCursor, bRestarted);
+			});
+		});
+	});
+
+	bRequestInFlight = true;
+
+	if (!Request->ProcessRequest())
+	{
+		bRequestInFlight = false;
+		LastError = TEXT("Could not process HTTP request");
+	}
+}
+
+void FEdgegapContainerLogStream::HandleNewLines(TArray<FString>&& NewLines, const FCursor& NewCursor, bool bRestarted)
+{
+	bRequestInFlight = false;
+	LastError.Reset();
+	Cursor = NewCursor;
+
+	if (bRestarted && NextLineNumber > 1)
+	{
+		NewLines.Insert(TEXT("--- Log restarted ---"), 0);
+	}
+
+	if (NewLines.Num() == 0)
+	{
+		return;
+	}
+
+	// Only the last capacity lines of a burst would survive anyway
+	const int32 First = FMath::Max(NewLines.Num() - Lines.GetCapacity(), 0);
+	NextLineNumber += First;
+
+	TArray<FEdgegapLogLinePtr> Added;
+	Added.Reserve(NewLines.Num() - First);
+
+	for (int32 Index = First; Index < NewLines.Num(); ++Index)
+	{
+		TSharedRef<FEdgegapLogLine> Line = MakeShared<FEdgegapLogLine>();
+		Line->Number = NextLineNumber++;
+		Line->Text = NewLines[Index].Len() > MaxLineLength ? NewLines[Index].Left(MaxLineLength) + TEXT("...") : MoveTemp(NewLines[Index]);
+
+		Lines.Add(Line);
+		Added.Add(Line);
+	}
+
+	LinesAdded.Broadcast(Added);
+}
+
+void FEdgegapContainerLogStream::FindNewLines(const FString& Logs, const FCursor& Cursor, TArray<FString>& OutNewLines, FCursor& OutCursor, bool& bOutRestarted)
+{
+	// Line start and length of every complete line, the last one may still be written to and waits for the next fetch
+	TArray<TPair<int32, int32>> LineRanges;
+
+	int32 LineStart = 0;
+	for (int32 Index = 0; Index < Logs.Len(); ++Index)
+	{
+		if (Logs[Index] == TEXT('\n'))
+		{
+			const int32 LineEnd = Index > LineStart && Logs[Index - 1] == TEXT('\r') ? Index - 1 : Index;
+			LineRanges.Emplace(LineStart, LineEnd - LineStart);
+			LineStart = Index + 1;
+		}
+	}
+
+	auto GetLine = [&Logs, &LineRanges](int32 LineIndex)
+	{
+		return Logs.Mid(LineRanges[LineIndex].Key, LineRanges[LineIndex].Value);
+	};
+
+	int32 Start = 0;
+	bOutRestarted = false;
+
+	if (Cursor.NumLines > 0)
+	{
+		if (LineRanges.Num() >= Cursor.NumLines && GetLine(Cursor.NumLines - 1) == Cursor.LastLine)
+		{
+			Start = Cursor.NumLines;
+		}
+		else
+		{
+			bOutRestarted = true;
+		}
+	}
+
+	OutNewLines.Reserve(LineRanges.Num() - Start);
+	for (int32 LineIndex = Start; LineIndex < LineRanges.Num(); ++LineIndex)
+	{
+		OutNewLines.Add(GetLine(LineIndex));
+	}
+
+	OutCursor.NumLines = LineRanges.Num();
+	OutCursor.LastLine = LineRanges.Num() > 0 ? GetLine(LineRanges.Num() - 1) : FString();
+}
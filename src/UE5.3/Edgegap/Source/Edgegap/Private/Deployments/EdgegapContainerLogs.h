@@ -0,0 +1,116 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+/** Fixed capacity FIFO, adding to a full buffer overwrites the oldest element */
+template<typename ElementType>
+class TEdgegapRingBuffer
+{
+public:
+	explicit TEdgegapRingBuffer(int32 InCapacity)
+		: Capacity(FMath::Max(InCapacity, 1))
+	{
+		Elements.Reserve(Capacity);
+	}
+
+	/** Returns whether an element was evicted to make room. */
+	bool Add(ElementType Element)
+	{
+		if (Elements.Num() < Capacity)
+		{
+			Elements.Add(MoveTemp(Element));
+			return false;
+		}
+
+		Elements[Head] = MoveTemp(Element);
+		Head = (Head + 1) % Capacity;
+		return true;
+	}
+
+	/** Index 0 is the oldest element */
+	const ElementType& operator[](int32 Index) const
+	{
+		return Elements[(Head + Index) % Elements.Num()];
+	}
+
+	int32 Num() const { return Elements.Num(); }
+	int32 GetCapacity() const { return Capacity; }
+
+	void Reset()
+	{
+		Elements.Reset();
+		Head = 0;
+	}
+
+private:
+	TArray<ElementType> Elements;
+	int32 Capacity;
+	int32 Head = 0;
+};
+
+struct FEdgegapLogLine
+{
+	// Counts every line received, evicted ones included
+	uint64 Number = 0;
+	FString Text;
+};
+
+typedef TSharedPtr<const FEdgegapLogLine> FEdgegapLogLinePtr;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnEdgegapLogLinesAdded, const TArray<FEdgegapLogLinePtr>&);
+
+/**
+ * Tails the container logs of one deployment into a ring buffer of Container Log Max Lines.
+ *
+ * v1/deployment/{request_id}/container-logs has no offset or cursor and returns the whole log, so the stream remembers
+ * how many lines it saw and the last of them, and only new lines past that point are split, kept and broadcast.
+ * That work happens on the thread pool, a log that shrank or no longer matches (container restarted) is taken as new.
+ */
+class FEdgegapContainerLogStream : public TSharedFromThis<FEdgegapContainerLogStream>
+{
+public:
+	FEdgegapContainerLogStream(const FString& InRequestID, const FString& InAPI_key);
+	~FEdgegapContainerLogStream();
+
+	void Start();
+	void Stop();
+
+	const FString& GetRequestID() const { return RequestID; }
+	const TEdgegapRingBuffer<FEdgegapLogLinePtr>& GetLines() const { return Lines; }
+
+	/** Lines received overall, the buffer holds the most recent ones */
+	uint64 GetNumReceived() const { return NextLineNumber - 1; }
+
+	const FString& GetLastError() const { return LastError; }
+
+	FOnEdgegapLogLinesAdded& OnLinesAdded() { return LinesAdded; }
+
+private:
+	struct FCursor
+	{
+		int32 NumLines = 0;
+		FString LastLine;
+	};
+
+	bool Tick(float DeltaTime);
+	void Fetch();
+	void HandleNewLines(TArray<FString>&& NewLines, const FCursor& NewCursor, bool bRestarted);
+
+	/** Splits Logs into lines and returns the ones after Cursor, sets bOutRestarted when Cursor isn't found. */
+	static void FindNewLines(const FString& Logs, const FCursor& Cursor, TArray<FString>& OutNewLines, FCursor& OutCursor, bool& bOutRestarted);
+
+	FString RequestID;
+	FString API_key;
+
+	TEdgegapRingBuffer<FEdgegapLogLinePtr> Lines;
+	uint64 NextLineNumber = 1;
+
+	FCursor Cursor;
+	FString LastError;
+
+	FOnEdgegapLogLinesAdded LinesAdded;
+	FTSTicker::FDelegateHandle TickerHandle;
+	bool bRequestInFlight = false;
+	double NextFetchTime = 0.0;
+};
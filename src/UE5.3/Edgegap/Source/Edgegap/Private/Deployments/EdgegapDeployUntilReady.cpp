@@ -0,0 +1,68 @@
+#include "EdgegapDeployUntilReady.h"
+#include "EdgegapReadyWaiter.h"
+#include "EdgegapSettings.h"
+
+FEdgegapDeployHandle::FEdgegapDeployHandle()
+{
+	Future = Promise.GetFuture().Share();
+}
+
+void FEdgegapDeployHandle::Cancel()
+{
+	if (bFinished)
+	{
+		return;
+	}
+
+	Result.Error = TEXT("Cancelled");
+	Finish();
+}
+
+void FEdgegapDeployHandle::Finish()
+{
+	if (bFinished)
+	{
+		return;
+	}
+
+	bFinished = true;
+
+	// Listeners may drop the last reference to this handle
+	TSharedRef<FEdgegapDeployHandle> KeepAlive = AsShared();
+
+	Promise.SetValue(Result);
+	Finished.Broadcast(Result);
+}
+
+TSharedRef<FEdgegapDeployHandle> FEdgegapDeployUntilReady::Start(const FEdgegapDeployParams& Params)
+{
+	check(IsInGameThread());
+
+	const UEdgegapSettings* Settings = GetDefault<UEdgegapSettings>();
+
+	TSharedRef<FEdgegapDeployHandle> Handle = MakeShareable(new FEdgegapDeployHandle());
+
+	Handle->Params = Params;
+	if (Handle->Params.AppName.IsEmpty())
+	{
+		Handle->Params.AppName = Settings->ApplicationName.ToString();
+	}
+	if (Handle->Params.VersionName.IsEmpty())
+	{
+		Handle->Params.VersionName = Settings->VersionName;
+	}
+	if (Handle->Params.API_key.IsEmpty())
+	{
+		Handle->Params.API_key = Settings->APIToken.APIToken;
+	}
+	if (Handle->Params.Timeout <= 0.0f)
+	{
+		Handle->Params.Timeout = Settings->BatchReadyTimeout;
+	}
+
+	Handle->StartTime = FPlatformTime::Seconds();
+	Handle->Deadline = Handle->StartTime + Handle->Params.Timeout;
+
+	FEdgegapReadyWaiter::Get().Add(Handle);
+	return Handle;
+}
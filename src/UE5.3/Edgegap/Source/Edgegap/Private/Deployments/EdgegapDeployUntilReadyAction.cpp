@@ -0,0 +1,42 @@
+#include "EdgegapDeployUntilReadyAction.h"
+
+UEdgegapDeployUntilReadyAction* UEdgegapDeployUntilReadyAction::DeployUntilReady(const FString& AppName, const FString& VersionName, float TimeoutSeconds)
+{
+	UEdgegapDeployUntilReadyAction* Action = NewObject<UEdgegapDeployUntilReadyAction>();
+	Action->Params.AppName = AppName;
+	Action->Params.VersionName = VersionName;
+	Action->Params.Timeout = TimeoutSeconds;
+	return Action;
+}
+
+void UEdgegapDeployUntilReadyAction::Activate()
+{
+	// Editor utilities have no game instance to register with, stay rooted until the deploy finished
+	AddToRoot();
+
+	Handle = FEdgegapDeployUntilReady::Start(Params);
+
+	if (Handle->IsFinished())
+	{
+		HandleFinished(Handle->GetResult());
+		return;
+	}
+
+	Handle->OnFinished().AddUObject(this, &UEdgegapDeployUntilReadyAction::HandleFinished);
+}
+
+void UEdgegapDeployUntilReadyAction::HandleFinished(const FEdgegapDeployResult& Result)
+{
+	if (Result.bSucceeded)
+	{
+		OnReady.Broadcast(Result.Address, Result.RequestID, FString());
+	}
+	else
+	{
+		OnFailed.Broadcast(FString(), Result.RequestID, Result.Error);
+	}
+
+	Handle.Reset();
+	RemoveFromRoot();
+	SetReadyToDestroy();
+}
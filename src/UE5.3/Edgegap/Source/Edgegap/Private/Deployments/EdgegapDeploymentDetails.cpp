@@ -0,0 +1,281 @@
+#include "EdgegapDeploymentDetails.h"
+#include "EdgegapSettings.h"
+#include "EdgegapSettingsDetails.h"
+#include "HttpModule.h"
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+
+#define LOCTEXT_NAMESPACE "EdgegapDeploymentDetails"
+
+namespace
+{
+	// Entries this much older than the TTL are dropped on the next request
+	const double EvictAfterTTLs = 10.0;
+}
+
+FText FEdgegapDeploymentDetails::ToText() const
+{
+	TArray<FString> Lines;
+
+	Lines.Add(FString::Printf(TEXT("%s  %s%s"), *RequestID, *Status, bReady ? TEXT(" (ready)") : TEXT("")));
+
+	if (bError && !ErrorDetail.IsEmpty())
+	{
+		Lines.Add(FString::Printf(TEXT("Error: %s"), *ErrorDetail));
+	}
+
+	if (!AppName.IsEmpty())
+	{
+		Lines.Add(FString::Printf(TEXT("Application: %s %s"), *AppName, *AppVersion));
+	}
+
+	Lines.Add(FString::Printf(TEXT("Host: %s (%s)"), *FQDN, *PublicIP));
+
+	if (!City.IsEmpty() || !Country.IsEmpty())
+	{
+		Lines.Add(FString::Printf(TEXT("Location: %s, %s, %s (%.3f, %.3f)"), *City, *Country, *Continent, Latitude, Longitude));
+	}
+
+	Lines.Add(FString::Printf(TEXT("Started: %s, running for %s"), *StartTime, *FTimespan::FromSeconds(ElapsedTime).ToString(TEXT("%h:%m:%s"))));
+
+	for (const FEdgegapDeploymentPort& Port : Ports)
+	{
+		Lines.Add(FString::Printf(TEXT("Port %s: %d -> %d/%s  %s"), *Port.Name, Port.External, Port.Internal, *Port.Protocol, *Port.Link));
+	}
+
+	if (Tags.Num() > 0)
+	{
+		Lines.Add(FString::Printf(TEXT("Tags: %s"), *FString::Join(Tags, TEXT(", "))));
+	}
+
+	for (const TPair<FString, FString>& Field : OtherFields)
+	{
+		Lines.Add(FString::Printf(TEXT("%s: %s"), *Field.Key, *Field.Value));
+	}
+
+	return FText::FromString(FString::Join(Lines, LINE_TERMINATOR));
+}
+
+bool FEdgegapDeploymentDetails::Parse(const FString& Response, TSharedPtr<FEdgegapDeploymentDetails>& OutDetails, FString& OutError)
+{
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response);
+
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	{
+		OutError = FString::Printf(TEXT("Could not deserialize response into Json, Response:%s"), *Response);
+		return false;
+	}
+
+	if (!JsonObject->HasField(TEXT("request_id")))
+	{
+		FString message;
+		JsonObject->TryGetStringField(TEXT("message"), message);
+		OutError = FString::Printf(TEXT("Failed, message:%s"), *message);
+		return false;
+	}
+
+	TSharedPtr<FEdgegapDeploymentDetails> Details = MakeShared<FEdgegapDeploymentDetails>();
+
+	static const TSet<FString> KnownFields = {
+		TEXT("request_id"), TEXT("current_status"), TEXT("status"), TEXT("fqdn"), TEXT("public_ip"), TEXT("app_name"), TEXT("app_version"),
+		TEXT("start_time"), TEXT("elapsed_time"), TEXT("running"), TEXT("error"), TEXT("error_detail"), TEXT("location"), TEXT("ports"), TEXT("tags")
+	};
+
+	JsonObject->TryGetStringField(TEXT("request_id"), Details->RequestID);
+	if (!JsonObject->TryGetStringField(TEXT("current_status"), Details->Status))
+	{
+		JsonObject->TryGetStringField(TEXT("status"), Details->Status);
+	}
+	JsonObject->TryGetStringField(TEXT("fqdn"), Details->FQDN);
+	JsonObject->TryGetStringField(TEXT("public_ip"), Details->PublicIP);
+	JsonObject->TryGetStringField(TEXT("app_name"), Details->AppName);
+	JsonObject->TryGetStringField(TEXT("app_version"), Details->AppVersion);
+	JsonObject->TryGetStringField(TEXT("start_time"), Details->StartTime);
+	JsonObject->TryGetNumberField(TEXT("elapsed_time"), Details->ElapsedTime);
+	JsonObject->TryGetBoolField(TEXT("running"), Details->bReady);
+	JsonObject->TryGetBoolField(TEXT("error"), Details->bError);
+	JsonObject->TryGetStringField(TEXT("error_detail"), Details->ErrorDetail);
+
+	const TSharedPtr<FJsonObject>* Location = nullptr;
+	if (JsonObject->TryGetObjectField(TEXT("location"), Location))
+	{
+		(*Location)->TryGetStringField(TEXT("city"), Details->City);
+		(*Location)->TryGetStringField(TEXT("country"), Details->Country);
+		(*Location)->TryGetStringField(TEXT("continent"), Details->Continent);
+		(*Location)->TryGetNumberField(TEXT("latitude"), Details->Latitude);
+		(*Location)->TryGetNumberField(TEXT("longitude"), Details->Longitude);
+	}
+
+	const TSharedPtr<FJsonObject>* Ports = nullptr;
+	if (JsonObject->TryGetObjectField(TEXT("ports"), Ports))
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& PortPair : (*Ports)->Values)
+		{
+			const TSharedPtr<FJsonObject>* PortObject = nullptr;
+			if (!PortPair.Value->TryGetObject(PortObject))
+			{
+				continue;
+			}
+
+			FEdgegapDeploymentPort& Port = Details->Ports.AddDefaulted_GetRef();
+			Port.Name = PortPair.Key;
+			(*PortObject)->TryGetStringField(TEXT("protocol"), Port.Protocol);
+			(*PortObject)->TryGetStringField(TEXT("link"), Port.Link);
+			(*PortObject)->TryGetNumberField(TEXT("external"), Port.External);
+			(*PortObject)->TryGetNumberField(TEXT("internal"), Port.Internal);
+		}
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* Tags = nullptr;
+	if (JsonObject->TryGetArrayField(TEXT("tags"), Tags))
+	{
+		for (const TSharedPtr<FJsonValue>& Tag : *Tags)
+		{
+			Details->Tags.Add(Tag->AsString());
+		}
+	}
+
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : JsonObject->Values)
+	{
+		FString Value;
+		if (!KnownFields.Contains(Field.Key) && Field.Value.IsValid() && Field.Value->TryGetString(Value) && !Value.IsEmpty())
+		{
+			Details->OtherFields.Emplace(Field.Key, Value);
+		}
+	}
+
+	OutDetails = Details;
+	return true;
+}
+
+FEdgegapDeploymentDetailsCache& FEdgegapDeploymentDetailsCache::Get()
+{
+	static FEdgegapDeploymentDetailsCache Instance;
+	return Instance;
+}
+
+void FEdgegapDeploymentDetailsCache::Request(const FString& RequestID, const FString& API_key, FOnDetailsLoaded OnLoaded)
+{
+	Trim();
+
+	FEntry& Entry = Entries.FindOrAdd(RequestID);
+
+	const bool bFresh = Entry.Details.IsValid() && FPlatformTime::Seconds() - Entry.FetchTime < GetDefault<UEdgegapSettings>()->DeploymentDetailsCacheTTL;
+	if (bFresh)
+	{
+		OnLoaded(Entry.Details, FString());
+		return;
+	}
+
+	Entry.PendingCallbacks.Add(MoveTemp(OnLoaded));
+
+	if (!Entry.bInFlight)
+	{
+		Entry.bInFlight = true;
+		Fetch(RequestID, API_key);
+	}
+}
+
+FEdgegapDeploymentDetailsPtr FEdgegapDeploymentDetailsCache::Find(const FString& RequestID) const
+{
+	const FEntry* Entry = Entries.Find(RequestID);
+	return Entry ? Entry->Details : nullptr;
+}
+
+void FEdgegapDeploymentDetailsCache::Invalidate(const FString& RequestID)
+{
+	if (FEntry* Entry = Entries.Find(RequestID))
+	{
+		Entry->FetchTime = 0.0;
+	}
+}
+
+void FEdgegapDeploymentDetailsCache::Fetch(const FString& RequestID, const FString& API_key)
+{
+	const FString endpoint = FString::Printf(TEXT("v1/status/%s"), *RequestID);
+
+	FString URL = FString::Printf(TEXT("%s%s"), *UEdgegapSettings::GetApiBaseURL(), *endpoint);
+
+	FHttpRequestRef Request = FHttpModule::Get().CreateRequest();
+
+	Request->SetURL(URL);
+	Request->SetVerb("GET");
+	Request->SetHeader(TEXT("User-Agent"), TEXT("X-UnrealEngine-Agent"));
+	Request->SetHeader(TEXT("Authorization"), *API_key);
+
+	Request->OnProcessRequestComplete().BindLambda([this, RequestID](FHttpRequestPtr Request, FHttpResponsePtr ResponsePtr, bool bWasSuccessful)
+	{
+		if (!bWasSuccessful || !ResponsePtr.IsValid() || ResponsePtr->GetResponseCode() < 200 || ResponsePtr->GetResponseCode() > 299)
+		{
+			Finish(RequestID, nullptr, FString::Printf(TEXT("HTTP request failed with code %d and response: %s"),
+				ResponsePtr.IsValid() ? ResponsePtr->GetResponseCode() : 0, ResponsePtr.IsValid() ? *ResponsePtr->GetContentAsString() : TEXT("")));
+			return;
+		}
+
+		// Same as the deployment list, decode off the game thread
+		Async(EAsyncExecution::ThreadPool, [this, RequestID, ResponsePtr]()
+		{
+			TSharedPtr<FEdgegapDeploymentDetails> Details;
+			FString Error;
+			FEdgegapDeploymentDetails::Parse(ResponsePtr->GetContentAsString(), Details, Error);
+
+			AsyncTask(ENamedThreads::GameThread, [this, RequestID, Details, Error]()
+			{
+				Finish(RequestID, Details, Error);
+			});
+		});
+	});
+
+	if (!Request->ProcessRequest())
+	{
+		Finish(RequestID, nullptr, TEXT("Could not process HTTP request"));
+	}
+}
+
+void FEdgegapDeploymentDetailsCache::Finish(const FString& RequestID, FEdgegapDeploymentDetailsPtr Details, const FString& Error)
+{
+	FEntry* Entry = Entries.Find(RequestID);
+	if (!Entry)
+	{
+		return;
+	}
+
+	if (Details.IsValid())
+	{
+		Entry->Details = Details;
+		Entry->FetchTime = FPlatformTime::Seconds();
+	}
+	else
+	{
+		UE_LOG(EdgegapLog, Warning, TEXT("DeploymentDetails: %s"), *Error);
+	}
+
+	Entry->bInFlight = false;
+
+	// A failed refresh still hands out what we had, along with the error
+	const FEdgegapDeploymentDetailsPtr Result = Entry->Details;
+
+	TArray<FOnDetailsLoaded> Callbacks = MoveTemp(Entry->PendingCallbacks);
+	for (const FOnDetailsLoaded& Callback : Callbacks)
+	{
+		Callback(Result, Error);
+	}
+}
+
+void FEdgegapDeploymentDetailsCache::Trim()
+{
+	const double MaxAge = GetDefault<UEdgegapSettings>()->DeploymentDetailsCacheTTL * EvictAfterTTLs;
+	const double Now = FPlatformTime::Seconds();
+
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (!It->Value.bInFlight && Now - It->Value.FetchTime > MaxAge)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
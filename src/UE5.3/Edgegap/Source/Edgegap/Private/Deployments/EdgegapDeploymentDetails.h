@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FEdgegapDeploymentPort
+{
+	FString Name;
+	FString Protocol;
+	FString Link;
+	int32 External = 0;
+	int32 Internal = 0;
+};
+
+/** Everything v1/status/{request_id} reports about one deployment, read only once parsed */
+struct FEdgegapDeploymentDetails
+{
+	FString RequestID;
+	FString Status;
+	FString FQDN;
+	FString PublicIP;
+	FString AppName;
+	FString AppVersion;
+	FString StartTime;
+	int32 ElapsedTime = 0;
+	bool bReady = false;
+	bool bError = false;
+	FString ErrorDetail;
+
+	FString City;
+	FString Country;
+	FString Continent;
+	double Latitude = 0.0;
+	double Longitude = 0.0;
+
+	TArray<FEdgegapDeploymentPort> Ports;
+	TArray<FString> Tags;
+
+	// Remaining scalar fields (resource usage, limits, ...) as reported, so new API fields show up without a plugin update
+	TArray<TPair<FString, FString>> OtherFields;
+
+	/** Multi-line summary for the details pane */
+	FText ToText() const;
+
+	static bool Parse(const FString& Response, TSharedPtr<FEdgegapDeploymentDetails>& OutDetails, FString& OutError);
+};
+
+typedef TSharedPtr<const FEdgegapDeploymentDetails> FEdgegapDeploymentDetailsPtr;
+
+/**
+ * Fetches v1/status/{request_id} on demand and caches the result per request ID for Deployment Details Cache TTL,
+ * so selecting rows back and forth doesn't hit the API while the deployment list itself stays a single cheap call.
+ */
+class FEdgegapDeploymentDetailsCache
+{
+public:
+	typedef TFunction<void(FEdgegapDeploymentDetailsPtr Details, const FString& Error)> FOnDetailsLoaded;
+
+	static FEdgegapDeploymentDetailsCache& Get();
+
+	/** Calls back right away with fresh cached details, otherwise once the fetch (shared with other callers) finished. On error Details are the stale ones, if any. */
+	void Request(const FString& RequestID, const FString& API_key, FOnDetailsLoaded OnLoaded);
+
+	/** Cached details even when stale, null when never loaded. */
+	FEdgegapDeploymentDetailsPtr Find(const FString& RequestID) const;
+
+	void Invalidate(const FString& RequestID);
+
+private:
+	struct FEntry
+	{
+		FEdgegapDeploymentDetailsPtr Details;
+		double FetchTime = 0.0;
+		bool bInFlight = false;
+		TArray<FOnDetailsLoaded> PendingCallbacks;
+	};
+
+	void Fetch(const FString& RequestID, const FString& API_key);
+	void Finish(const FString& RequestID, FEdgegapDeploymentDetailsPtr Details, const FString& Error);
+	void Trim();
+
+	TMap<FString, FEntry> Entries;
+};
@@ -0,0 +1,429 @@
+#include "EdgegapDeploymentPoller.h"
+#include "EdgegapSettings.h"
+#include "EdgegapSettingsDetails.h"
+#include "HttpModule.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/App.h"
+#include "Async/Async.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+#define LOCTEXT_NAMESPACE "EdgegapLog"
+
+namespace
+{
+	// How often the ticker checks whether a poll is due, not the poll interval itself
+	const float PollerTickRate = 0.25f;
+}
+
+FEdgegapDeploymentPoller& FEdgegapDeploymentPoller::Get()
+{
+	static FEdgegapDeploymentPoller Instance;
+	return Instance;
+}
+
+void FEdgegapDeploymentPoller::Startup()
+{
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FEdgegapDeploymentPoller::Tick), PollerTickRate);
+	}
+}
+
+void FEdgegapDeploymentPoller::Shutdown()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	// Drops a response that is still being parsed
+	++PollGeneration;
+	bRequestInFlight = false;
+
+	Watchers.Empty();
+	PendingCompletions.Empty();
+	DeploymentsUpdated.Clear();
+}
+
+void FEdgegapDeploymentPoller::AddWatcher(const void* Owner, TFunction<bool()> IsActive)
+{
+	const bool bWasWatched = HasActiveWatcher();
+
+	Watchers.Add(Owner, MoveTemp(IsActive));
+
+	// Coming back from a pause, the last result may be arbitrarily old
+	if (!bWasWatched)
+	{
+		NextPollTime = 0.0;
+	}
+}
+
+void FEdgegapDeploymentPoller::RemoveWatcher(const void* Owner)
+{
+	Watchers.Remove(Owner);
+}
+
+void FEdgegapDeploymentPoller::PollNow(const FString& API_key, FSimpleDelegate OnComplete)
+{
+	if (!API_key.IsEmpty())
+	{
+		PendingAPIKey = API_key;
+	}
+
+	if (OnComplete.IsBound())
+	{
+		PendingCompletions.Add(OnComplete);
+	}
+
+	bPollRequested = true;
+}
+
+void FEdgegapDeploymentPoller::RestoreDeployments(TArray<TSharedPtr<FDeploymentStatusListItem>>&& InDeployments, const FDateTime& SavedTime)
+{
+	if (bPolledOnce)
+	{
+		return;
+	}
+
+	Deployments = MoveTemp(InDeployments);
+	bRestored = true;
+	RestoredTime = SavedTime;
+
+	// Whatever was on its way back then is checked on quickly once something watches
+	bAnyTransitioning = Deployments.ContainsByPredicate([](const TSharedPtr<FDeploymentStatusListItem>& Deployment)
+	{
+		return Deployment->IsTransitioning();
+	});
+
+	DeploymentsRestored.Broadcast();
+}
+
+void FEdgegapDeploymentPoller::ExpectTransition(float Seconds)
+{
+	ExpectTransitionUntil = FMath::Max(ExpectTransitionUntil, FPlatformTime::Seconds() + Seconds);
+}
+
+bool FEdgegapDeploymentPoller::HasActiveWatcher() const
+{
+	for (const TPair<const void*, TFunction<bool()>>& Watcher : Watchers)
+	{
+		if (!Watcher.Value || Watcher.Value())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+double FEdgegapDeploymentPoller::GetNextInterval() const
+{
+	const UEdgegapSettings* EdgegapSettings = GetDefault<UEdgegapSettings>();
+
+	const double FastInterval = FMath::Max(EdgegapSettings->TransitioningPollInterval, 0.5f);
+	const double SteadyInterval = FMath::Max(EdgegapSettings->SteadyPollInterval, FastInterval);
+	const double MaxBackoff = FMath::Max(EdgegapSettings->MaxPollBackoff, SteadyInterval);
+
+	if (ConsecutiveErrors > 0)
+	{
+		return FMath::Min(FastInterval * FMath::Pow(2.0, ConsecutiveErrors), MaxBackoff);
+	}
+
+	const bool bWantsFastPolling = bAnyTransitioning || FPlatformTime::Seconds() < ExpectTransitionUntil;
+
+	// Nobody is looking at a backgrounded editor, steady is fast enough there
+	if (!bWantsFastPolling || !FApp::HasFocus())
+	{
+		return SteadyInterval;
+	}
+
+	return FastInterval;
+}
+
+bool FEdgegapDeploymentPoller::Tick(float DeltaTime)
+{
+	if (bRequestInFlight)
+	{
+		return true;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	if (Now < RateLimitedUntil)
+	{
+		return true;
+	}
+
+	const bool bUserRequested = bPollRequested;
+
+	if (!bUserRequested)
+	{
+		if (!GetDefault<UEdgegapSettings>()->bEnableStatusPolling || Now < NextPollTime || !HasActiveWatcher())
+		{
+			return true;
+		}
+	}
+
+	const FString API_key = PendingAPIKey.IsEmpty() ? GetDefault<UEdgegapSettings>()->APIToken.APIToken : PendingAPIKey;
+
+	bPollRequested = false;
+	PendingAPIKey.Empty();
+
+	if (API_key.IsEmpty())
+	{
+		// Nothing to poll with until a token is set, back off like a failed poll
+		FinishPoll(false);
+		return true;
+	}
+
+	SendRequest(API_key, bUserRequested);
+	return true;
+}
+
+void FEdgegapDeploymentPoller::SendRequest(const FString& API_key, bool bUserRequested)
+{
+	const FString endpoint = FString::Printf(TEXT("v1/deployments"));
+
+	FString URL = FString::Printf(TEXT("%s%s"), *UEdgegapSettings::GetApiBaseURL(), *endpoint);
+
+	FHttpRequestRef Request = FHttpModule::Get().CreateRequest();
+
+	// Set request fields
+	Request->SetURL(URL);
+	Request->SetVerb("GET");
+	Request->SetHeader(TEXT("User-Agent"), TEXT("X-UnrealEngine-Agent"));
+
+	Request->SetHeader("Content-Type", "application/json");
+	Request->SetHeader(TEXT("Authorization"), *API_key);
+
+	Request->OnProcessRequestComplete().BindLambda([this, API_key, bUserRequested](FHttpRequestPtr Request, FHttpResponsePtr ResponsePtr, bool bWasSuccessful)
+	{
+		HandleResponse(ResponsePtr, bWasSuccessful, API_key, bUserRequested);
+	});
+
+	bRequestInFlight = true;
+
+	if (!Request->ProcessRequest())
+	{
+		UE_LOG(EdgegapLog, Error, TEXT("DeploymentPoller: Could not process HTTP request"));
+
+		bRequestInFlight = false;
+		FinishPoll(false);
+	}
+}
+
+void FEdgegapDeploymentPoller::HandleResponse(FHttpResponsePtr ResponsePtr, bool bWasSuccessful, const FString& API_key, bool bUserRequested)
+{
+	const int32 ResponseCode = ResponsePtr.IsValid() ? ResponsePtr->GetResponseCode() : 0;
+
+	if (ResponseCode == 429)
+	{
+		const FString RetryAfter = ResponsePtr->GetHeader(TEXT("Retry-After"));
+		const double RetryAfterSeconds = RetryAfter.IsNumeric() ? FCString::Atod(*RetryAfter) : GetDefault<UEdgegapSettings>()->MaxPollBackoff;
+
+		RateLimitedUntil = FPlatformTime::Seconds() + RetryAfterSeconds;
+		UE_LOG(EdgegapLog, Warning, TEXT("DeploymentPoller: Rate limited, holding polls for %.1fs"), RetryAfterSeconds);
+
+		bRequestInFlight = false;
+		FinishPoll(false);
+		return;
+	}
+
+	if (!bWasSuccessful || ResponseCode < 200 || ResponseCode > 299)
+	{
+		FString Response = ResponsePtr.IsValid() ? ResponsePtr->GetContentAsString() : FString();
+		UE_LOG(EdgegapLog, Warning, TEXT("DeploymentPoller: HTTP request failed with code %d and response: %s"), ResponseCode, *Response);
+
+		bRequestInFlight = false;
+		FinishPoll(false);
+		return;
+	}
+
+	// Decoding a long listing takes a while, so it happens on the thread pool and the game thread only swaps in
+	// the finished list. The poll counts as in flight until then so polls can't overlap.
+	const uint32 Generation = PollGeneration;
+
+	Async(EAsyncExecution::ThreadPool, [this, ResponsePtr, API_key, bUserRequested, Generation]()
+	{
+		TArray<TSharedPtr<FDeploymentStatusListItem>> NewDeployments;
+		FString Error;
+
+		const bool bParsed = ParseDeployments(ResponsePtr->GetContentAsString(), API_key, NewDeployments, Error);
+
+		const bool bNewAnyTransitioning = NewDeployments.ContainsByPredicate([](const TSharedPtr<FDeploymentStatusListItem>& Deployment)
+		{
+			return Deployment->IsTransitioning();
+		});
+
+		AsyncTask(ENamedThreads::GameThread, [this, Generation, bParsed, bUserRequested, bNewAnyTransitioning, NewDeployments = MoveTemp(NewDeployments), Error = MoveTemp(Error)]() mutable
+		{
+			// Shut down (and maybe started again) while parsing
+			if (Generation != PollGeneration)
+			{
+				return;
+			}
+
+			bRequestInFlight = false;
+
+			if (!bParsed)
+			{
+				UE_LOG(EdgegapLog, Error, TEXT("DeploymentPoller: %s"), *Error);
+
+				if (bUserRequested)
+				{
+					FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
+					Info.ExpireDuration = 3.0f;
+					FSlateNotificationManager::Get().AddNotification(Info);
+				}
+
+				FinishPoll(false);
+				return;
+			}
+
+			bAnyTransitioning = bNewAnyTransitioning;
+			bPolledOnce = true;
+			bRestored = false;
+
+			MergeDeployments(NewDeployments);
+
+			Deployments = MoveTemp(NewDeployments);
+			DeploymentsUpdated.Broadcast(Deployments);
+
+			FinishPoll(true);
+		});
+	});
+}
+
+void FEdgegapDeploymentPoller::MergeDeployments(TArray<TSharedPtr<FDeploymentStatusListItem>>& InOutDeployments) const
+{
+	TMap<FString, TSharedPtr<FDeploymentStatusListItem>> PreviousByRequestID;
+	PreviousByRequestID.Reserve(Deployments.Num());
+	for (const TSharedPtr<FDeploymentStatusListItem>& Deployment : Deployments)
+	{
+		PreviousByRequestID.Add(Deployment->RequestID, Deployment);
+	}
+
+	int32 NumAdded = 0;
+	int32 NumChanged = 0;
+
+	for (TSharedPtr<FDeploymentStatusListItem>& Deployment : InOutDeployments)
+	{
+		if (const TSharedPtr<FDeploymentStatusListItem>* Previous = PreviousByRequestID.Find(Deployment->RequestID))
+		{
+			NumChanged += (*Previous)->UpdateFrom(*Deployment);
+			Deployment = *Previous;
+		}
+		else
+		{
+			++NumAdded;
+		}
+	}
+
+	UE_LOG(EdgegapLog, Verbose, TEXT("DeploymentPoller: %d deployments, %d added, %d changed, %d removed"),
+		InOutDeployments.Num(), NumAdded, NumChanged, Deployments.Num() + NumAdded - InOutDeployments.Num());
+}
+
+void FEdgegapDeploymentPoller::FinishPoll(bool bSucceeded)
+{
+	ConsecutiveErrors = bSucceeded ? 0 : ConsecutiveErrors + 1;
+	NextPollTime = FPlatformTime::Seconds() + GetNextInterval();
+
+	TArray<FSimpleDelegate> Completions = MoveTemp(PendingCompletions);
+	for (const FSimpleDelegate& Completion : Completions)
+	{
+		Completion.ExecuteIfBound();
+	}
+}
+
+bool FEdgegapDeploymentPoller::ParseDeployments(const FString& Response, const FString& API_key, TArray<TSharedPtr<FDeploymentStatusListItem>>& OutDeployments, FString& OutError)
+{
+	TSharedPtr<FJsonValue> JsonValue;
+	// Create a reader pointer to read the json data
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response);
+
+	if (!FJsonSerializer::Deserialize(Reader, JsonValue) || !JsonValue.IsValid() || !JsonValue->AsObject().IsValid())
+	{
+		OutError = FString::Printf(TEXT("Could not deserialize response into Json, Response:%s"), *Response);
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject> JsonObject = JsonValue->AsObject();
+
+	const TArray<TSharedPtr<FJsonValue>>* Data = nullptr;
+	if (!JsonObject->TryGetArrayField(TEXT("data"), Data))
+	{
+		FString message;
+		JsonObject->TryGetStringField(TEXT("message"), message);
+		OutError = FString::Printf(TEXT("Failed, message:%s"), *message);
+		return false;
+	}
+
+	OutDeployments.Reserve(Data->Num());
+
+	for (const TSharedPtr<FJsonValue>& deployment : *Data)
+	{
+		const TSharedPtr<FJsonObject> DeploymentObject = deployment->AsObject();
+		if (!DeploymentObject.IsValid())
+		{
+			continue;
+		}
+
+		FString link;
+		int32 EchoPort = 0;
+
+		const TSharedPtr<FJsonObject>* ports_obj = nullptr;
+		const TSharedPtr<FJsonObject>* obj_field_gameport = nullptr;
+		const TSharedPtr<FJsonObject>* obj_field_echo = nullptr;
+		if (DeploymentObject->TryGetObjectField(TEXT("ports"), ports_obj))
+		{
+			if ((*ports_obj)->TryGetObjectField(TEXT("gameport"), obj_field_gameport))
+			{
+				(*obj_field_gameport)->TryGetStringField(TEXT("link"), link);
+			}
+
+			if ((*ports_obj)->TryGetObjectField(TEXT("echo"), obj_field_echo))
+			{
+				(*obj_field_echo)->TryGetNumberField(TEXT("external"), EchoPort);
+			}
+		}
+
+		if (link.IsEmpty())
+		{
+			link = "Empty";
+		}
+
+		FString RequestID = DeploymentObject->GetStringField("request_id");
+		FString Status = DeploymentObject->GetStringField("status");
+		bool bReady = DeploymentObject->GetBoolField("ready");
+
+		TSharedPtr<FDeploymentStatusListItem> Item = MakeShareable(new FDeploymentStatusListItem(link, Status, RequestID, API_key, bReady));
+		DeploymentObject->TryGetStringField(TEXT("app_name"), Item->AppName);
+		DeploymentObject->TryGetStringField(TEXT("app_version"), Item->AppVersion);
+		DeploymentObject->TryGetStringField(TEXT("public_ip"), Item->PublicIP);
+		Item->EchoPort = EchoPort;
+
+		FString StartTime;
+		if (DeploymentObject->TryGetStringField(TEXT("start_time"), StartTime) && !FDateTime::ParseIso8601(*StartTime, Item->StartTime))
+		{
+			FDateTime::Parse(StartTime, Item->StartTime);
+		}
+
+		const TSharedPtr<FJsonObject>* LocationObject = nullptr;
+		if (DeploymentObject->TryGetObjectField(TEXT("location"), LocationObject))
+		{
+			FString City, Country;
+			(*LocationObject)->TryGetStringField(TEXT("city"), City);
+			(*LocationObject)->TryGetStringField(TEXT("country"), Country);
+			Item->Location = City.IsEmpty() ? Country : Country.IsEmpty() ? City : FString::Printf(TEXT("%s, %s"), *City, *Country);
+		}
+
+		OutDeployments.Add(Item);
+	}
+
+	return true;
+}
+
+#undef LOCTEXT_NAMESPACE
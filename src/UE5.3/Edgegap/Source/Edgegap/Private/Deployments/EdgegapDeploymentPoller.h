@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "EdgegapDeploymentTypes.h"
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnEdgegapDeploymentsUpdated, const TArray<TSharedPtr<FDeploymentStatusListItem>>&);
+
+/**
+ * Background poller for v1/deployments.
+ *
+ * Polls at the transitioning interval while any deployment is on its way to ready, at the steady
+ * interval otherwise, and not at all while nothing is watching. Failed polls back off exponentially
+ * and a 429 holds every poll (manual ones included) until Retry-After has passed.
+ */
+class FEdgegapDeploymentPoller
+{
+public:
+	static FEdgegapDeploymentPoller& Get();
+
+	void Startup();
+	void Shutdown();
+
+	/**
+	 * Registers an owner interested in deployment status. Polling pauses when no watcher is active.
+	 * @param	IsActive	Optional, lets e.g. a hidden panel stay registered without keeping the poller awake
+	 */
+	void AddWatcher(const void* Owner, TFunction<bool()> IsActive = TFunction<bool()>());
+	void RemoveWatcher(const void* Owner);
+
+	/** Polls as soon as the rate limit allows, coalescing with a poll already in flight. OnComplete fires when that poll finishes. */
+	void PollNow(const FString& API_key = FString(), FSimpleDelegate OnComplete = FSimpleDelegate());
+
+	/** Keeps the transitioning interval for a while, e.g. right after a deploy that may not be listed yet. */
+	void ExpectTransition(float Seconds = 30.0f);
+
+	FOnEdgegapDeploymentsUpdated& OnDeploymentsUpdated() { return DeploymentsUpdated; }
+
+	const TArray<TSharedPtr<FDeploymentStatusListItem>>& GetDeployments() const { return Deployments; }
+
+	/**
+	 * Shows a list saved by an earlier session until the first poll answers, ignored once a poll did.
+	 * Not broadcast through OnDeploymentsUpdated since it isn't news about the account, views already open
+	 * pick it up through OnDeploymentsRestored.
+	 */
+	void RestoreDeployments(TArray<TSharedPtr<FDeploymentStatusListItem>>&& InDeployments, const FDateTime& SavedTime);
+
+	FSimpleMulticastDelegate& OnDeploymentsRestored() { return DeploymentsRestored; }
+
+	/** Whether GetDeployments is still the restored list, GetRestoredTime (UTC) tells how old it is */
+	bool IsRestored() const { return bRestored; }
+	const FDateTime& GetRestoredTime() const { return RestoredTime; }
+
+private:
+	bool Tick(float DeltaTime);
+	bool HasActiveWatcher() const;
+	double GetNextInterval() const;
+
+	void SendRequest(const FString& API_key, bool bUserRequested);
+	void HandleResponse(FHttpResponsePtr ResponsePtr, bool bWasSuccessful, const FString& API_key, bool bUserRequested);
+	void FinishPoll(bool bSucceeded);
+
+	/** Swaps in the existing item of every deployment that is still listed, updated in place, so identity is stable across polls. */
+	void MergeDeployments(TArray<TSharedPtr<FDeploymentStatusListItem>>& InOutDeployments) const;
+
+	static bool ParseDeployments(const FString& Response, const FString& API_key, TArray<TSharedPtr<FDeploymentStatusListItem>>& OutDeployments, FString& OutError);
+
+	FTSTicker::FDelegateHandle TickerHandle;
+	FOnEdgegapDeploymentsUpdated DeploymentsUpdated;
+	FSimpleMulticastDelegate DeploymentsRestored;
+
+	TMap<const void*, TFunction<bool()>> Watchers;
+	TArray<TSharedPtr<FDeploymentStatusListItem>> Deployments;
+
+	TArray<FSimpleDelegate> PendingCompletions;
+	FString PendingAPIKey;
+	bool bPollRequested = false;
+	bool bRequestInFlight = false;
+	bool bAnyTransitioning = false;
+	uint32 PollGeneration = 0;
+
+	bool bPolledOnce = false;
+	bool bRestored = false;
+	FDateTime RestoredTime;
+
+	int32 ConsecutiveErrors = 0;
+	double NextPollTime = 0.0;
+	double RateLimitedUntil = 0.0;
+	double ExpectTransitionUntil = 0.0;
+};
@@ -0,0 +1,173 @@
+#include "EdgegapDeploymentRequests.h"
+#include "EdgegapRequestFanOut.h"
+#include "EdgegapDeploymentPoller.h"
+#include "EdgegapTimeToReadyTracker.h"
+#include "EdgegapSettings.h"
+#include "EdgegapSettingsDetails.h"
+#include "HttpModule.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+void FEdgegapDeploymentRequests::Deploy(const FString& AppName, const FString& VersionName, const FString& API_key, const TArray<FString>& IPList, FOnRequestComplete OnComplete)
+{
+	const FString endpoint = FString::Printf(TEXT("v1/deploy"));
+
+	FString URL = FString::Printf(TEXT("%s%s"), *UEdgegapSettings::GetApiBaseURL(), *endpoint);
+
+	FHttpRequestRef Request = FHttpModule::Get().CreateRequest();
+
+	// Set request fields
+	Request->SetURL(URL);
+	Request->SetVerb("POST");
+	Request->SetHeader(TEXT("User-Agent"), TEXT("X-UnrealEngine-Agent"));
+
+	Request->SetHeader("Content-Type", "application/json");
+	Request->SetHeader(TEXT("Authorization"), *API_key);
+
+	// prepare json data
+	FString JsonString;
+	TSharedRef<TJsonWriter<TCHAR>> JsonWriter = TJsonWriterFactory<TCHAR>::Create(&JsonString);
+	JsonWriter->WriteObjectStart();
+	JsonWriter->WriteValue(TEXT("app_name"), AppName);
+	JsonWriter->WriteValue(TEXT("version_name"), VersionName);
+
+	JsonWriter->WriteArrayStart(TEXT("ip_list"));
+	for (const FString& IP : IPList)
+	{
+		JsonWriter->WriteValue(IP);
+	}
+	JsonWriter->WriteArrayEnd();
+
+	JsonWriter->WriteObjectEnd();
+	JsonWriter->Close();
+
+	// Insert the content into the request
+	Request->SetContentAsString(JsonString);
+
+	const double SentTime = FPlatformTime::Seconds();
+
+	Request->OnProcessRequestComplete().BindLambda([OnComplete, VersionName, SentTime](FHttpRequestPtr Request, FHttpResponsePtr ResponsePtr, bool bWasSuccessful)
+	{
+		FEdgegapRequestResult Result;
+		Result.RetryAfter = FEdgegapRequestFanOut::GetRetryAfter(ResponsePtr);
+
+		const FString Response = ResponsePtr.IsValid() ? ResponsePtr->GetContentAsString() : FString();
+
+		TSharedPtr<FJsonValue> JsonValue;
+		// Create a reader pointer to read the json data
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response);
+		const bool bIsJson = FJsonSerializer::Deserialize(Reader, JsonValue) && JsonValue.IsValid() && JsonValue->AsObject().IsValid();
+
+		if (!bWasSuccessful || !ResponsePtr.IsValid() || ResponsePtr->GetResponseCode() < 200 || ResponsePtr->GetResponseCode() > 299)
+		{
+			Result.Error = FString::Printf(TEXT("HTTP request failed with code %d and response: %s"), ResponsePtr.IsValid() ? ResponsePtr->GetResponseCode() : 0, *Response);
+		}
+		else if (!bIsJson)
+		{
+			Result.Error = FString::Printf(TEXT("Could not deserialize response into Json, Response:%s"), *Response);
+		}
+		else if (JsonValue->AsObject()->HasField("message"))
+		{
+			Result.Error = FString::Printf(TEXT("Failed, message:%s"), *JsonValue->AsObject()->GetStringField("message"));
+		}
+		else
+		{
+			Result.bSucceeded = true;
+			JsonValue->AsObject()->TryGetStringField(TEXT("request_id"), Result.RequestID);
+
+			FEdgegapTimeToReadyTracker::Get().NotifyRequested(Result.RequestID, VersionName, SentTime);
+		}
+
+		OnComplete(Result);
+	});
+
+	if (!Request->ProcessRequest())
+	{
+		FEdgegapRequestResult Result;
+		Result.Error = TEXT("Could not process HTTP request");
+
+		OnComplete(Result);
+	}
+}
+
+void FEdgegapDeploymentRequests::Stop(const FString& RequestID, const FString& API_key, FOnRequestComplete OnComplete)
+{
+	const FString endpoint = FString::Printf(TEXT("v1/stop/%s"), *RequestID);
+
+	FString URL = FString::Printf(TEXT("%s%s"), *UEdgegapSettings::GetApiBaseURL(), *endpoint);
+
+	FHttpRequestRef Request = FHttpModule::Get().CreateRequest();
+
+	Request->SetURL(URL);
+	Request->SetVerb("DELETE");
+	Request->SetHeader(TEXT("User-Agent"), TEXT("X-UnrealEngine-Agent"));
+	Request->SetHeader(TEXT("Authorization"), *API_key);
+
+	Request->OnProcessRequestComplete().BindLambda([OnComplete, RequestID](FHttpRequestPtr Request, FHttpResponsePtr ResponsePtr, bool bWasSuccessful)
+	{
+		FEdgegapRequestResult Result;
+		Result.RequestID = RequestID;
+		Result.RetryAfter = FEdgegapRequestFanOut::GetRetryAfter(ResponsePtr);
+
+		if (!bWasSuccessful || !ResponsePtr.IsValid() || ResponsePtr->GetResponseCode() < 200 || ResponsePtr->GetResponseCode() > 299)
+		{
+			Result.Error = FString::Printf(TEXT("HTTP request failed with code %d and response: %s"), ResponsePtr.IsValid() ? ResponsePtr->GetResponseCode() : 0, ResponsePtr.IsValid() ? *ResponsePtr->GetContentAsString() : TEXT(""));
+		}
+		else
+		{
+			Result.bSucceeded = true;
+		}
+
+		OnComplete(Result);
+	});
+
+	if (!Request->ProcessRequest())
+	{
+		FEdgegapRequestResult Result;
+		Result.RequestID = RequestID;
+		Result.Error = TEXT("Could not process HTTP request");
+
+		OnComplete(Result);
+	}
+}
+
+void FEdgegapDeploymentRequests::StopMany(const TArray<FString>& RequestIDs, const FString& API_key, TFunction<void(int32 NumStopped, int32 NumFailed)> OnAllDone)
+{
+	if (RequestIDs.Num() == 0)
+	{
+		if (OnAllDone)
+		{
+			OnAllDone(0, 0);
+		}
+		return;
+	}
+
+	UE_LOG(EdgegapLog, Log, TEXT("StopMany: Stopping %d deployments"), RequestIDs.Num());
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	FEdgegapRequestFanOut::Start(RequestIDs.Num(), GetDefault<UEdgegapSettings>()->BatchDeployConcurrency, [RequestIDs, API_key](int32 JobIndex, FEdgegapRequestFanOut::FJobDone Done)
+	{
+		Stop(RequestIDs[JobIndex], API_key, [Done](const FEdgegapRequestResult& Result)
+		{
+			if (!Result.bSucceeded && Result.RetryAfter <= 0.0)
+			{
+				UE_LOG(EdgegapLog, Warning, TEXT("StopMany: Could not stop %s, %s"), *Result.RequestID, *Result.Error);
+			}
+
+			Done(Result.bSucceeded, Result.RetryAfter);
+		});
+	}, [API_key, StartTime, OnAllDone](int32 NumSucceeded, int32 NumFailed)
+	{
+		UE_LOG(EdgegapLog, Log, TEXT("StopMany: %d stopped, %d failed in %.1fs"), NumSucceeded, NumFailed, FPlatformTime::Seconds() - StartTime);
+
+		FEdgegapDeploymentPoller::Get().ExpectTransition();
+		FEdgegapDeploymentPoller::Get().PollNow(API_key);
+
+		if (OnAllDone)
+		{
+			OnAllDone(NumSucceeded, NumFailed);
+		}
+	});
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FEdgegapRequestResult
+{
+	bool bSucceeded = false;
+
+	/** Request ID of the deployment, new one for a deploy */
+	FString RequestID;
+
+	/** API message or transport error, set on failure */
+	FString Error;
+
+	/** Positive when the API rate limited the request */
+	double RetryAfter = 0.0;
+};
+
+/**
+ * Bare v1 deployment requests, without any UI around them.
+ * Used by the single deploy button as well as the batch operations.
+ */
+class FEdgegapDeploymentRequests
+{
+public:
+	typedef TFunction<void(const FEdgegapRequestResult&)> FOnRequestComplete;
+
+	static void Deploy(const FString& AppName, const FString& VersionName, const FString& API_key, const TArray<FString>& IPList, FOnRequestComplete OnComplete);
+
+	static void Stop(const FString& RequestID, const FString& API_key, FOnRequestComplete OnComplete);
+
+	/**
+	 * Stops several deployments in parallel, at most BatchDeployConcurrency at a time, then refreshes the
+	 * deployment list once instead of after every stop.
+	 */
+	static void StopMany(const TArray<FString>& RequestIDs, const FString& API_key, TFunction<void(int32 NumStopped, int32 NumFailed)> OnAllDone = TFunction<void(int32, int32)>());
+};
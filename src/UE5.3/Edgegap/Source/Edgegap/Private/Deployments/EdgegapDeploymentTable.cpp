@@ -0,0 +1,301 @@
+#include "EdgegapDeploymentTable.h"
+#include "EdgegapLatencyProbe.h"
+
+const FName FEdgegapDeploymentTable::StatusColumn("Status");
+const FName FEdgegapDeploymentTable::VersionColumn("Version");
+const FName FEdgegapDeploymentTable::AgeColumn("Age");
+const FName FEdgegapDeploymentTable::LocationColumn("Location");
+const FName FEdgegapDeploymentTable::LatencyColumn("Latency");
+
+int32 FEdgegapDeploymentTable::GetColumnIndex(FName Column)
+{
+	if (Column == StatusColumn)
+	{
+		return Column_Status;
+	}
+	if (Column == VersionColumn)
+	{
+		return Column_Version;
+	}
+	if (Column == AgeColumn)
+	{
+		return Column_Age;
+	}
+	if (Column == LocationColumn)
+	{
+		return Column_Location;
+	}
+	if (Column == LatencyColumn)
+	{
+		return Column_Latency;
+	}
+
+	return INDEX_NONE;
+}
+
+void FEdgegapDeploymentTable::SetDeployments(const TArray<TSharedPtr<FDeploymentStatusListItem>>& Deployments)
+{
+	bool bSameRows = Rows.Num() == Deployments.Num();
+	for (int32 Index = 0; bSameRows && Index < Rows.Num(); ++Index)
+	{
+		bSameRows = Rows[Index].Item == Deployments[Index];
+	}
+
+	if (!bSameRows)
+	{
+		// Rows of items that stay listed move over with their keys
+		TMap<const FDeploymentStatusListItem*, int32> PreviousRows;
+		PreviousRows.Reserve(Rows.Num());
+		for (int32 Index = 0; Index < Rows.Num(); ++Index)
+		{
+			PreviousRows.Add(Rows[Index].Item.Get(), Index);
+		}
+
+		TArray<FRow> NewRows;
+		NewRows.Reserve(Deployments.Num());
+		for (const TSharedPtr<FDeploymentStatusListItem>& Deployment : Deployments)
+		{
+			const int32* PreviousIndex = PreviousRows.Find(Deployment.Get());
+			if (PreviousIndex)
+			{
+				NewRows.Add(MoveTemp(Rows[*PreviousIndex]));
+			}
+			else
+			{
+				NewRows.AddDefaulted_GetRef().Item = Deployment;
+			}
+		}
+
+		Rows = MoveTemp(NewRows);
+
+		for (bool& bDirty : bIndexDirty)
+		{
+			bDirty = true;
+		}
+
+		bViewDirty = true;
+		bFilterNarrowed = false;
+	}
+
+	for (FRow& Row : Rows)
+	{
+		UpdateKeys(Row);
+	}
+}
+
+void FEdgegapDeploymentTable::UpdateKeys(FRow& Row)
+{
+	const FDeploymentStatusListItem& Item = *Row.Item;
+	if (Row.bKeysValid && Row.Revision == Item.Revision)
+	{
+		return;
+	}
+
+	const FString StatusKey = Item.DeploymentReady ? Item.DeploymentStatus + TEXT(" (ready)") : Item.DeploymentStatus;
+
+	bIndexDirty[Column_Status] |= !Row.bKeysValid || Row.StatusKey != StatusKey;
+	bIndexDirty[Column_Version] |= !Row.bKeysValid || Row.VersionKey != Item.AppVersion;
+	bIndexDirty[Column_Age] |= !Row.bKeysValid || Row.StartTime != Item.StartTime;
+	bIndexDirty[Column_Location] |= !Row.bKeysValid || Row.LocationKey != Item.Location;
+
+	Row.StatusKey = StatusKey;
+	Row.VersionKey = Item.AppVersion;
+	Row.StartTime = Item.StartTime;
+	Row.LocationKey = Item.Location;
+	Row.SearchText = FString::Join(TArray<FString>{ Item.RequestID, Item.DeploymentIP, StatusKey, Item.AppName, Item.AppVersion, Item.Location }, TEXT(" ")).ToLower();
+
+	if (!Row.bKeysValid)
+	{
+		Row.Latency = GetLatencyKey(Row);
+		bIndexDirty[Column_Latency] = true;
+	}
+
+	Row.Revision = Item.Revision;
+	Row.bKeysValid = true;
+
+	// Changed text can move the row in or out of the filter
+	bViewDirty = true;
+	bFilterNarrowed = false;
+}
+
+float FEdgegapDeploymentTable::GetLatencyKey(const FRow& Row) const
+{
+	// Unmeasured rows sort after measured ones
+	const FEdgegapLatencyHistory* History = FEdgegapLatencyProbe::Get().Find(Row.Item->RequestID);
+	return History && History->LastRTT >= 0.0f ? History->LastRTT : MAX_flt;
+}
+
+void FEdgegapDeploymentTable::RefreshLatency()
+{
+	for (FRow& Row : Rows)
+	{
+		const float Latency = GetLatencyKey(Row);
+		if (Latency != Row.Latency)
+		{
+			Row.Latency = Latency;
+			bIndexDirty[Column_Latency] = true;
+		}
+	}
+
+	if (bIndexDirty[Column_Latency] && SortColumn == LatencyColumn)
+	{
+		bViewDirty = true;
+		bFilterNarrowed = false;
+	}
+}
+
+void FEdgegapDeploymentTable::SetSort(FName Column, EColumnSortMode::Type Mode)
+{
+	if (GetColumnIndex(Column) == INDEX_NONE)
+	{
+		Mode = EColumnSortMode::None;
+	}
+
+	if (Column == SortColumn && Mode == SortMode)
+	{
+		return;
+	}
+
+	SortColumn = Mode == EColumnSortMode::None ? NAME_None : Column;
+	SortMode = Mode;
+
+	if (SortColumn == LatencyColumn)
+	{
+		RefreshLatency();
+	}
+
+	bViewDirty = true;
+	bFilterNarrowed = false;
+}
+
+void FEdgegapDeploymentTable::SetFilter(const FString& Filter)
+{
+	TArray<FString> Terms;
+	Filter.ToLower().ParseIntoArrayWS(Terms);
+
+	if (Terms == FilterTerms)
+	{
+		return;
+	}
+
+	// Every previous term still contained in a new one (typing on) can only remove rows
+	bool bNarrowed = !bViewDirty;
+	for (int32 Index = 0; bNarrowed && Index < FilterTerms.Num(); ++Index)
+	{
+		bNarrowed = Terms.IsValidIndex(Index) && Terms[Index].Contains(FilterTerms[Index]);
+	}
+
+	FilterTerms = MoveTemp(Terms);
+	bFilterNarrowed = bNarrowed;
+	bViewDirty = true;
+}
+
+const TArray<int32>& FEdgegapDeploymentTable::GetIndex(int32 Column)
+{
+	TArray<int32>& Index = Indexes[Column];
+
+	if (!bIndexDirty[Column] && Index.Num() == Rows.Num())
+	{
+		return Index;
+	}
+
+	Index.SetNumUninitialized(Rows.Num(), false);
+	for (int32 RowIndex = 0; RowIndex < Rows.Num(); ++RowIndex)
+	{
+		Index[RowIndex] = RowIndex;
+	}
+
+	switch (Column)
+	{
+	case Column_Status:
+		Index.StableSort([this](int32 A, int32 B) { return Rows[A].StatusKey < Rows[B].StatusKey; });
+		break;
+	case Column_Version:
+		Index.StableSort([this](int32 A, int32 B) { return Rows[A].VersionKey < Rows[B].VersionKey; });
+		break;
+	case Column_Age:
+		// Newest first, so ascending reads as increasing age
+		Index.StableSort([this](int32 A, int32 B) { return Rows[A].StartTime > Rows[B].StartTime; });
+		break;
+	case Column_Location:
+		Index.StableSort([this](int32 A, int32 B) { return Rows[A].LocationKey < Rows[B].LocationKey; });
+		break;
+	case Column_Latency:
+		Index.StableSort([this](int32 A, int32 B) { return Rows[A].Latency < Rows[B].Latency; });
+		break;
+	}
+
+	bIndexDirty[Column] = false;
+	return Index;
+}
+
+bool FEdgegapDeploymentTable::PassesFilter(const FRow& Row) const
+{
+	for (const FString& Term : FilterTerms)
+	{
+		if (!Row.SearchText.Contains(Term, ESearchCase::CaseSensitive))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FEdgegapDeploymentTable::UpdateView()
+{
+	if (!bViewDirty)
+	{
+		return false;
+	}
+
+	bViewDirty = false;
+
+	if (bFilterNarrowed)
+	{
+		bFilterNarrowed = false;
+
+		// Order is unchanged, only drop what the longer terms no longer match
+		int32 NumKept = 0;
+		for (int32 Position = 0; Position < ViewRows.Num(); ++Position)
+		{
+			if (PassesFilter(Rows[ViewRows[Position]]))
+			{
+				if (NumKept != Position)
+				{
+					ViewRows[NumKept] = ViewRows[Position];
+					View[NumKept] = MoveTemp(View[Position]);
+				}
+				NumKept++;
+			}
+		}
+
+		ViewRows.SetNum(NumKept, false);
+		View.SetNum(NumKept, false);
+		return true;
+	}
+
+	ScratchView.Reset();
+	ScratchViewRows.Reset();
+
+	const int32 Column = GetColumnIndex(SortColumn);
+	const TArray<int32>* Index = Column != INDEX_NONE && SortMode != EColumnSortMode::None ? &GetIndex(Column) : nullptr;
+	const bool bAscending = SortMode != EColumnSortMode::Descending;
+
+	for (int32 Position = 0; Position < Rows.Num(); ++Position)
+	{
+		const int32 SortedPosition = bAscending ? Position : Rows.Num() - 1 - Position;
+		const int32 RowIndex = Index ? (*Index)[SortedPosition] : Position;
+
+		if (PassesFilter(Rows[RowIndex]))
+		{
+			ScratchView.Add(Rows[RowIndex].Item);
+			ScratchViewRows.Add(RowIndex);
+		}
+	}
+
+	// Swapping keeps both allocations around for the next rebuild
+	Swap(View, ScratchView);
+	Swap(ViewRows, ScratchViewRows);
+	return true;
+}
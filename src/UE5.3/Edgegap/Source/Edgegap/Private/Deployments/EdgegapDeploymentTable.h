@@ -0,0 +1,98 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "EdgegapDeploymentTypes.h"
+
+/**
+ * Sorted and filtered view over the poller's deployments for the Current Deployments list.
+ *
+ * Every row caches its sort keys and a lowercase search string, recomputed only when the item's Revision moved.
+ * Each sortable column keeps an index (row order by that key) that is rebuilt only when a key of that column or the set
+ * of rows changed, so switching sort or direction and typing in the filter walk an existing index into a reused array.
+ */
+class FEdgegapDeploymentTable
+{
+public:
+	static const FName StatusColumn;
+	static const FName VersionColumn;
+	static const FName AgeColumn;
+	static const FName LocationColumn;
+	static const FName LatencyColumn;
+
+	/** Takes the latest list, rows of items seen before keep their keys unless the item changed. */
+	void SetDeployments(const TArray<TSharedPtr<FDeploymentStatusListItem>>& Deployments);
+
+	/** Latency moves every probe, its keys are only refreshed on demand (each poll while sorting by it). */
+	void RefreshLatency();
+
+	/** EColumnSortMode::None keeps the API's order. */
+	void SetSort(FName Column, EColumnSortMode::Type Mode);
+	EColumnSortMode::Type GetSortMode(FName Column) const { return Column == SortColumn ? SortMode : EColumnSortMode::None; }
+	FName GetSortColumn() const { return SortColumn; }
+
+	/** Whitespace separated terms, a row has to contain all of them (case insensitive). */
+	void SetFilter(const FString& Filter);
+
+	/** Rows to show, stable address for ListItemsSource. Returns whether it changed since the last call. */
+	bool UpdateView();
+	const TArray<TSharedPtr<FDeploymentStatusListItem>>& GetView() const { return View; }
+
+	int32 NumRows() const { return Rows.Num(); }
+
+private:
+	enum EColumn : uint8
+	{
+		Column_Status,
+		Column_Version,
+		Column_Age,
+		Column_Location,
+		Column_Latency,
+		Column_Num
+	};
+
+	struct FRow
+	{
+		TSharedPtr<FDeploymentStatusListItem> Item;
+		uint32 Revision = 0;
+		bool bKeysValid = false;
+
+		FString StatusKey;
+		FString VersionKey;
+		FDateTime StartTime;
+		FString LocationKey;
+		float Latency = MAX_flt;
+
+		FString SearchText;
+	};
+
+	static int32 GetColumnIndex(FName Column);
+
+	/** Recomputes the row's keys when stale, marking the indexes of the keys that changed. */
+	void UpdateKeys(FRow& Row);
+	float GetLatencyKey(const FRow& Row) const;
+
+	const TArray<int32>& GetIndex(int32 Column);
+	bool PassesFilter(const FRow& Row) const;
+
+	TArray<FRow> Rows;
+
+	TArray<int32> Indexes[Column_Num];
+	bool bIndexDirty[Column_Num] = { true, true, true, true, true };
+
+	FName SortColumn;
+	EColumnSortMode::Type SortMode = EColumnSortMode::None;
+
+	TArray<FString> FilterTerms;
+
+	// Filter terms that only narrow the previous ones can filter the current view instead of every row
+	bool bFilterNarrowed = false;
+	bool bViewDirty = true;
+
+	// View and the row index of each of its items
+	TArray<TSharedPtr<FDeploymentStatusListItem>> View;
+	TArray<int32> ViewRows;
+
+	TArray<TSharedPtr<FDeploymentStatusListItem>> ScratchView;
+	TArray<int32> ScratchViewRows;
+};
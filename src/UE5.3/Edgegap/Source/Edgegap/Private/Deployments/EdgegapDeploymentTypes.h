@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FDeploymentStatusListItem
+{
+public:
+	FString DeploymentIP, DeploymentStatus, RequestID, API_Key;
+
+	bool DeploymentReady;
+
+	// Only set when the deployments list reports them
+	FString AppName, AppVersion;
+	FDateTime StartTime;
+	FString Location;
+
+	// Where the server module answers latency probes, EchoPort is 0 when the version doesn't expose an "echo" port
+	FString PublicIP;
+	int32 EchoPort = 0;
+
+	// Bumped whenever UpdateFrom changes anything, lets views cache what they derive from an item
+	uint32 Revision = 0;
+
+	FDeploymentStatusListItem() {}
+
+	FDeploymentStatusListItem(FString InDeploymentIP, FString InDeploymentStatus, FString InRequestID, FString InAPI_Key, bool InDeploymentReady)
+		: DeploymentIP(InDeploymentIP)
+		, DeploymentStatus(InDeploymentStatus)
+		, RequestID(InRequestID)
+		, API_Key(InAPI_Key)
+		, DeploymentReady(InDeploymentReady)
+	{
+	}
+
+	/** Copies the state of a newer listing of the same deployment, returns whether anything changed. */
+	bool UpdateFrom(const FDeploymentStatusListItem& Other)
+	{
+		const bool bChanged = DeploymentIP != Other.DeploymentIP || DeploymentStatus != Other.DeploymentStatus || DeploymentReady != Other.DeploymentReady
+			|| AppName != Other.AppName || AppVersion != Other.AppVersion || API_Key != Other.API_Key
+			|| PublicIP != Other.PublicIP || EchoPort != Other.EchoPort || StartTime != Other.StartTime || Location != Other.Location;
+
+		if (bChanged)
+		{
+			const uint32 NextRevision = Revision + 1;
+			*this = Other;
+			Revision = NextRevision;
+		}
+
+		return bChanged;
+	}
+
+	/** Whether the deployment is still on its way to ready (or to being torn down) and worth polling quickly. */
+	bool IsTransitioning() const
+	{
+		if (DeploymentReady)
+		{
+			return false;
+		}
+
+		return !DeploymentStatus.Contains(TEXT("ERROR")) && !DeploymentStatus.Equals(TEXT("Status.TERMINATED"));
+	}
+};
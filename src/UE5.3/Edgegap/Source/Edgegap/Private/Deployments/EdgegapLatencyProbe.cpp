@@ -0,0 +1,291 @@
+#include "EdgegapLatencyProbe.h"
+#include "EdgegapDeploymentPoller.h"
+#include "EdgegapSettings.h"
+#include "EdgegapSettingsDetails.h"
+#include "EdgegapLatencyEcho.h"
+#include "Async/Async.h"
+#include "Common/UdpSocketBuilder.h"
+#include "Common/UdpSocketReceiver.h"
+#include "SocketSubsystem.h"
+#include "Sockets.h"
+
+#define LOCTEXT_NAMESPACE "EdgegapLatencyProbe"
+
+namespace
+{
+	const float ProbeTickRate = 0.1f;
+
+	// A probe that took longer than this counts as lost, a late echo is ignored
+	const double ProbeTimeout = 2.0;
+
+	// Enough for a minute of sparkline at the default interval
+	const int32 MaxSamples = 60;
+
+	// The socket is let go once nothing watched for this long
+	const double CloseSocketAfter = 30.0;
+
+	// Magic followed by the sequence number
+	const int32 ProbeSize = UE_ARRAY_COUNT(FEdgegapLatencyEcho::Magic) + sizeof(uint32);
+}
+
+FText FEdgegapLatencyHistory::ToText() const
+{
+	if (LastRTT < 0.0f)
+	{
+		if (NumLost > 0)
+		{
+			return LOCTEXT("Lost", "lost");
+		}
+
+		return NumSent > 0 ? LOCTEXT("Pending", "pending") : LOCTEXT("NoEcho", "no echo");
+	}
+
+	FString Text = FString::Printf(TEXT("%.0f ms ±%.0f"), LastRTT, Jitter);
+
+	if (NumLost > 0)
+	{
+		Text += FString::Printf(TEXT(", %.0f%% lost"), 100.0f * NumLost / FMath::Max(NumSent, 1));
+	}
+
+	return FText::FromString(Text);
+}
+
+FEdgegapLatencyProbe& FEdgegapLatencyProbe::Get()
+{
+	static FEdgegapLatencyProbe Instance;
+	return Instance;
+}
+
+void FEdgegapLatencyProbe::Startup()
+{
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FEdgegapLatencyProbe::Tick), ProbeTickRate);
+	}
+}
+
+void FEdgegapLatencyProbe::Shutdown()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	CloseSocket();
+
+	Watchers.Empty();
+	Histories.Empty();
+}
+
+void FEdgegapLatencyProbe::AddWatcher(const void* Owner, TFunction<bool()> IsActive)
+{
+	Watchers.Add(Owner, MoveTemp(IsActive));
+}
+
+void FEdgegapLatencyProbe::RemoveWatcher(const void* Owner)
+{
+	Watchers.Remove(Owner);
+}
+
+bool FEdgegapLatencyProbe::HasActiveWatcher() const
+{
+	for (const TPair<const void*, TFunction<bool()>>& Watcher : Watchers)
+	{
+		if (!Watcher.Value || Watcher.Value())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool FEdgegapLatencyProbe::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	for (auto It = Pending.CreateIterator(); It; ++It)
+	{
+		if (Now - It->Value.SentTime > ProbeTimeout)
+		{
+			if (FEdgegapLatencyHistory* History = Histories.Find(It->Value.RequestID))
+			{
+				History->NumLost++;
+				AddSample(*History, -1.0f);
+			}
+
+			It.RemoveCurrent();
+		}
+	}
+
+	const float Interval = GetDefault<UEdgegapSettings>()->LatencyProbeInterval;
+
+	if (Interval <= 0.0f || !HasActiveWatcher())
+	{
+		if (Socket && Now - LastActiveTime > CloseSocketAfter)
+		{
+			CloseSocket();
+		}
+
+		return true;
+	}
+
+	LastActiveTime = Now;
+
+	if (Now >= NextProbeTime)
+	{
+		NextProbeTime = Now + Interval;
+		SendProbes();
+	}
+
+	return true;
+}
+
+bool FEdgegapLatencyProbe::OpenSocket()
+{
+	if (Socket)
+	{
+		return true;
+	}
+
+	Socket = FUdpSocketBuilder(TEXT("EdgegapLatencyProbe"))
+		.AsNonBlocking()
+		.BoundToPort(0)
+		.Build();
+
+	if (!Socket)
+	{
+		UE_LOG(EdgegapLog, Warning, TEXT("LatencyProbe: Could not create a UDP socket"));
+		return false;
+	}
+
+	Receiver = MakeUnique<FUdpSocketReceiver>(Socket, FTimespan::FromMilliseconds(100), TEXT("EdgegapLatencyProbe"));
+	Receiver->OnDataReceived().BindLambda([this](const FArrayReaderPtr& Data, const FIPv4Endpoint& Sender)
+	{
+		const double ReceivedTime = FPlatformTime::Seconds();
+
+		if (Data->Num() != ProbeSize || !FEdgegapLatencyEcho::IsProbe(Data->GetData(), Data->Num()))
+		{
+			return;
+		}
+
+		uint32 Sequence = 0;
+		FMemory::Memcpy(&Sequence, Data->GetData() + UE_ARRAY_COUNT(FEdgegapLatencyEcho::Magic), sizeof(Sequence));
+
+		AsyncTask(ENamedThreads::GameThread, [this, Sequence, ReceivedTime]()
+		{
+			HandleEcho(Sequence, ReceivedTime);
+		});
+	});
+	Receiver->Start();
+
+	return true;
+}
+
+void FEdgegapLatencyProbe::CloseSocket()
+{
+	Receiver.Reset();
+
+	if (Socket)
+	{
+		Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+		Socket = nullptr;
+	}
+
+	// Echoes still on their way find nothing to match
+	Pending.Empty();
+}
+
+void FEdgegapLatencyProbe::SendProbes()
+{
+	const TArray<TSharedPtr<FDeploymentStatusListItem>>& Deployments = FEdgegapDeploymentPoller::Get().GetDeployments();
+
+	TSet<FString> Listed;
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+
+	for (const TSharedPtr<FDeploymentStatusListItem>& Deployment : Deployments)
+	{
+		if (!Deployment->DeploymentReady || Deployment->EchoPort <= 0 || Deployment->PublicIP.IsEmpty())
+		{
+			continue;
+		}
+
+		Listed.Add(Deployment->RequestID);
+
+		if (!OpenSocket())
+		{
+			return;
+		}
+
+		TSharedRef<FInternetAddr> Address = SocketSubsystem->CreateInternetAddr();
+		bool bIsValid = false;
+		Address->SetIp(*Deployment->PublicIP, bIsValid);
+		Address->SetPort(Deployment->EchoPort);
+
+		if (!bIsValid)
+		{
+			continue;
+		}
+
+		const uint32 Sequence = NextSequence++;
+
+		uint8 Probe[ProbeSize];
+		FMemory::Memcpy(Probe, FEdgegapLatencyEcho::Magic, UE_ARRAY_COUNT(FEdgegapLatencyEcho::Magic));
+		FMemory::Memcpy(Probe + UE_ARRAY_COUNT(FEdgegapLatencyEcho::Magic), &Sequence, sizeof(Sequence));
+
+		FPendingProbe& PendingProbe = Pending.Add(Sequence);
+		PendingProbe.RequestID = Deployment->RequestID;
+		PendingProbe.SentTime = FPlatformTime::Seconds();
+
+		int32 BytesSent = 0;
+		Socket->SendTo(Probe, ProbeSize, BytesSent, *Address);
+
+		Histories.FindOrAdd(Deployment->RequestID).NumSent++;
+	}
+
+	// Forget deployments that are gone or no longer ready
+	for (auto It = Histories.CreateIterator(); It; ++It)
+	{
+		if (!Listed.Contains(It->Key))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FEdgegapLatencyProbe::HandleEcho(uint32 Sequence, double ReceivedTime)
+{
+	FPendingProbe PendingProbe;
+	if (!Pending.RemoveAndCopyValue(Sequence, PendingProbe))
+	{
+		return;
+	}
+
+	if (FEdgegapLatencyHistory* History = Histories.Find(PendingProbe.RequestID))
+	{
+		AddSample(*History, (ReceivedTime - PendingProbe.SentTime) * 1000.0);
+	}
+}
+
+void FEdgegapLatencyProbe::AddSample(FEdgegapLatencyHistory& History, float RTT)
+{
+	if (RTT >= 0.0f)
+	{
+		if (History.LastRTT >= 0.0f)
+		{
+			History.Jitter += (FMath::Abs(RTT - History.LastRTT) - History.Jitter) / 16.0f;
+		}
+
+		History.LastRTT = RTT;
+	}
+
+	History.Samples.Add(RTT);
+	if (History.Samples.Num() > MaxSamples)
+	{
+		History.Samples.RemoveAt(0, History.Samples.Num() - MaxSamples);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
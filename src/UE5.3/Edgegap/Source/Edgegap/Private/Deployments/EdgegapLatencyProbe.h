@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+class FSocket;
+class FUdpSocketReceiver;
+
+/** Recent round trips to one deployment */
+struct FEdgegapLatencyHistory
+{
+	// Round trip times in ms, oldest first, negative for a probe that never came back
+	TArray<float> Samples;
+
+	float LastRTT = -1.0f;
+
+	// Smoothed difference between consecutive round trips, as RFC 3550 computes interarrival jitter
+	float Jitter = 0.0f;
+
+	int32 NumSent = 0;
+	int32 NumLost = 0;
+
+	/** e.g. "42 ms ±3, 1% lost" */
+	FText ToText() const;
+};
+
+/**
+ * Measures RTT and jitter from the workstation to every ready deployment that exposes an "echo" port, by sending small
+ * UDP probes the EdgegapServer module sends back. Echoes are timestamped on a receiver thread so the editor's frame
+ * time doesn't end up in the numbers.
+ *
+ * Probes at Latency Probe Interval while something watches, e.g. the deployment list being visible.
+ */
+class FEdgegapLatencyProbe
+{
+public:
+	static FEdgegapLatencyProbe& Get();
+
+	void Startup();
+	void Shutdown();
+
+	/** Same as the poller's watchers, probing stops when none is active. */
+	void AddWatcher(const void* Owner, TFunction<bool()> IsActive = TFunction<bool()>());
+	void RemoveWatcher(const void* Owner);
+
+	/** Null until a probe was sent to the deployment. */
+	const FEdgegapLatencyHistory* Find(const FString& RequestID) const { return Histories.Find(RequestID); }
+
+private:
+	struct FPendingProbe
+	{
+		FString RequestID;
+		double SentTime = 0.0;
+	};
+
+	bool Tick(float DeltaTime);
+	bool HasActiveWatcher() const;
+
+	bool OpenSocket();
+	void CloseSocket();
+
+	void SendProbes();
+	void HandleEcho(uint32 Sequence, double ReceivedTime);
+	void AddSample(FEdgegapLatencyHistory& History, float RTT);
+
+	FTSTicker::FDelegateHandle TickerHandle;
+	TMap<const void*, TFunction<bool()>> Watchers;
+
+	FSocket* Socket = nullptr;
+	TUniquePtr<FUdpSocketReceiver> Receiver;
+
+	TMap<uint32, FPendingProbe> Pending;
+	TMap<FString, FEdgegapLatencyHistory> Histories;
+
+	uint32 NextSequence = 1;
+	double NextProbeTime = 0.0;
+	double LastActiveTime = 0.0;
+};
@@ -0,0 +1,250 @@
+#include "EdgegapPlayOnDeployment.h"
+#include "EdgegapDeploymentPoller.h"
+#include "EdgegapLatencyProbe.h"
+#include "EdgegapSettings.h"
+#include "EdgegapSettingsDetails.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "Settings/LevelEditorPlaySettings.h"
+#include "UObject/Package.h"
+#include "Widgets/Notifications/SNotificationList.h"
+#include "Framework/Notifications/NotificationManager.h"
+
+#define LOCTEXT_NAMESPACE "EdgegapPlayOnDeployment"
+
+FEdgegapPlayOnDeployment& FEdgegapPlayOnDeployment::Get()
+{
+	static FEdgegapPlayOnDeployment Instance;
+	return Instance;
+}
+
+void FEdgegapPlayOnDeployment::Shutdown()
+{
+	if (DeployHandle.IsValid())
+	{
+		DeployHandle->OnFinished().RemoveAll(this);
+		DeployHandle.Reset();
+	}
+
+	FEditorDelegates::PostPIEStarted.Remove(PostPIEStartedHandle);
+
+	if (PIEPlaySettings && UObjectInitialized())
+	{
+		PIEPlaySettings->RemoveFromRoot();
+	}
+	PIEPlaySettings = nullptr;
+
+	bInProgress = false;
+}
+
+void FEdgegapPlayOnDeployment::Start()
+{
+	if (bInProgress)
+	{
+		return;
+	}
+
+	if (GEditor->IsPlaySessionInProgress())
+	{
+		Fail(TEXT("A play session is already running"));
+		return;
+	}
+
+	const UEdgegapSettings* Settings = GetDefault<UEdgegapSettings>();
+	const FString AppName = Settings->ApplicationName.ToString();
+	const FString VersionName = Settings->VersionName;
+	const FString API_key = Settings->APIToken.APIToken;
+
+	if (VersionName.IsEmpty())
+	{
+		Fail(TEXT("No version was pushed yet, use Build and Push first"));
+		return;
+	}
+
+	bInProgress = true;
+
+	FNotificationInfo Info(FText::Format(LOCTEXT("Looking", "Looking for a ready deployment of {0}"), FText::FromString(VersionName)));
+	Info.ExpireDuration = 3.0f;
+	FSlateNotificationManager::Get().AddNotification(Info);
+
+	// The list may be minutes old when the panel is closed, look at a fresh one before deciding to deploy
+	FEdgegapDeploymentPoller::Get().PollNow(API_key, FSimpleDelegate::CreateLambda([this, AppName, VersionName, API_key]()
+	{
+		if (bInProgress)
+		{
+			FindOrDeploy(AppName, VersionName, API_key);
+		}
+	}));
+}
+
+void FEdgegapPlayOnDeployment::FindOrDeploy(const FString& AppName, const FString& VersionName, const FString& API_key)
+{
+	const FDeploymentStatusListItem* Best = nullptr;
+	float BestLatency = MAX_flt;
+
+	// A list restored from the last session (the refresh failed) may name deployments that are long gone
+	const FEdgegapDeploymentPoller& Poller = FEdgegapDeploymentPoller::Get();
+	const TArray<TSharedPtr<FDeploymentStatusListItem>> NoDeployments;
+
+	for (const TSharedPtr<FDeploymentStatusListItem>& Item : Poller.IsRestored() ? NoDeployments : Poller.GetDeployments())
+	{
+		// Deployments that don't report their version can't be told apart from older builds
+		if (!Item->DeploymentReady || Item->AppVersion != VersionName || (!Item->AppName.IsEmpty() && Item->AppName != AppName) || Item->DeploymentIP == TEXT("Empty"))
+		{
+			continue;
+		}
+
+		// Closest first when latencies were measured, otherwise the first listed
+		const FEdgegapLatencyHistory* History = FEdgegapLatencyProbe::Get().Find(Item->RequestID);
+		const float Latency = History && History->LastRTT >= 0.0f ? History->LastRTT : MAX_flt;
+
+		if (!Best || Latency < BestLatency)
+		{
+			Best = Item.Get();
+			BestLatency = Latency;
+		}
+	}
+
+	if (Best)
+	{
+		UE_LOG(EdgegapLog, Log, TEXT("PlayOnDeployment: Reusing ready deployment %s"), *Best->RequestID);
+		LaunchClients(Best->DeploymentIP);
+		return;
+	}
+
+	FEdgegapDeployParams Params;
+	Params.AppName = AppName;
+	Params.VersionName = VersionName;
+	Params.API_key = API_key;
+
+	DeployHandle = FEdgegapDeployUntilReady::Start(Params);
+	if (DeployHandle->IsFinished())
+	{
+		HandleDeployFinished(DeployHandle->GetResult());
+		return;
+	}
+
+	DeployHandle->OnFinished().AddRaw(this, &FEdgegapPlayOnDeployment::HandleDeployFinished);
+
+	FNotificationInfo Info(FText::Format(LOCTEXT("Deploying", "Deploying {0}, clients start once it is ready"), FText::FromString(VersionName)));
+	Info.ExpireDuration = 3.0f;
+	FSlateNotificationManager::Get().AddNotification(Info);
+}
+
+void FEdgegapPlayOnDeployment::HandleDeployFinished(const FEdgegapDeployResult& Result)
+{
+	DeployHandle.Reset();
+
+	if (!Result.bSucceeded)
+	{
+		Fail(Result.Error);
+		return;
+	}
+
+	LaunchClients(Result.Address);
+}
+
+void FEdgegapPlayOnDeployment::LaunchClients(const FString& Address)
+{
+	bInProgress = false;
+
+	// A session may have been started by hand while the deployment got ready
+	if (GEditor->IsPlaySessionInProgress())
+	{
+		Fail(FString::Printf(TEXT("A play session is already running, connect to %s by hand"), *Address));
+		return;
+	}
+
+	const UEdgegapSettings* Settings = GetDefault<UEdgegapSettings>();
+	const int32 NumClients = FMath::Max(Settings->PlayClientCount, 1);
+
+	UE_LOG(EdgegapLog, Log, TEXT("PlayOnDeployment: Connecting %d %s clients to %s"), NumClients, Settings->bPlayInStandalone ? TEXT("standalone") : TEXT("PIE"), *Address);
+
+	if (Settings->bPlayInStandalone)
+	{
+		LaunchStandaloneClients(Address, NumClients);
+	}
+	else
+	{
+		LaunchPIEClients(Address, NumClients);
+	}
+}
+
+void FEdgegapPlayOnDeployment::LaunchStandaloneClients(const FString& Address, int32 NumClients)
+{
+	// Same as Play Standalone, with the server address in place of the map
+	const FString ProjectPath = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+	const FString Params = FString::Printf(TEXT("\"%s\" %s -game -windowed -ResX=1280 -ResY=720 -log"), *ProjectPath, *Address);
+
+	for (int32 Index = 0; Index < NumClients; ++Index)
+	{
+		FProcHandle Proc = FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *Params, true, false, false, nullptr, 0, nullptr, nullptr);
+		if (!Proc.IsValid())
+		{
+			Fail(FString::Printf(TEXT("Could not start %s %s"), FPlatformProcess::ExecutablePath(), *Params));
+			return;
+		}
+
+		FPlatformProcess::CloseProc(Proc);
+	}
+}
+
+void FEdgegapPlayOnDeployment::LaunchPIEClients(const FString& Address, int32 NumClients)
+{
+	FEditorDelegates::PostPIEStarted.Remove(PostPIEStartedHandle);
+	if (PIEPlaySettings)
+	{
+		PIEPlaySettings->RemoveFromRoot();
+	}
+
+	// A copy, so the user's own play settings stay as they are
+	PIEPlaySettings = DuplicateObject(GetDefault<ULevelEditorPlaySettings>(), GetTransientPackage());
+	PIEPlaySettings->SetPlayNetMode(EPlayNetMode::PIE_Standalone);
+	PIEPlaySettings->SetPlayNumberOfClients(NumClients);
+	PIEPlaySettings->SetRunUnderOneProcess(true);
+	PIEPlaySettings->AddToRoot();
+
+	PIEAddress = Address;
+	PostPIEStartedHandle = FEditorDelegates::PostPIEStarted.AddRaw(this, &FEdgegapPlayOnDeployment::HandlePostPIEStarted);
+
+	FRequestPlaySessionParams Params;
+	Params.WorldType = EPlaySessionWorldType::PlayInEditor;
+	Params.SessionDestination = EPlaySessionDestinationType::InProcess;
+	Params.EditorPlaySettings = PIEPlaySettings;
+
+	GEditor->RequestPlaySession(Params);
+}
+
+void FEdgegapPlayOnDeployment::HandlePostPIEStarted(bool bIsSimulating)
+{
+	FEditorDelegates::PostPIEStarted.Remove(PostPIEStartedHandle);
+	PostPIEStartedHandle.Reset();
+
+	if (PIEPlaySettings)
+	{
+		PIEPlaySettings->RemoveFromRoot();
+		PIEPlaySettings = nullptr;
+	}
+
+	// Every client starts standalone on the current map, then travels to the server like "open host:port"
+	for (const FWorldContext& Context : GEngine->GetWorldContexts())
+	{
+		if (Context.WorldType == EWorldType::PIE && Context.World())
+		{
+			GEngine->SetClientTravel(Context.World(), *PIEAddress, TRAVEL_Absolute);
+		}
+	}
+}
+
+void FEdgegapPlayOnDeployment::Fail(const FString& Error)
+{
+	bInProgress = false;
+
+	UE_LOG(EdgegapLog, Error, TEXT("PlayOnDeployment: %s"), *Error);
+
+	FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
+	Info.ExpireDuration = 3.0f;
+	FSlateNotificationManager::Get().AddNotification(Info);
+}
+
+#undef LOCTEXT_NAMESPACE
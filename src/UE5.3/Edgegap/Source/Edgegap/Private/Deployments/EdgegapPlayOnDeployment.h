@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EdgegapDeployUntilReady.h"
+
+class ULevelEditorPlaySettings;
+
+/**
+ * "Deploy and Play": reuses a ready deployment of the last pushed version, or deploys one and waits for it,
+ * then starts Play Client Count PIE (or standalone) clients connected to it.
+ */
+class FEdgegapPlayOnDeployment
+{
+public:
+	static FEdgegapPlayOnDeployment& Get();
+
+	void Shutdown();
+
+	void Start();
+
+	/** From the click until the clients were launched */
+	bool IsInProgress() const { return bInProgress; }
+
+private:
+	void FindOrDeploy(const FString& AppName, const FString& VersionName, const FString& API_key);
+	void HandleDeployFinished(const FEdgegapDeployResult& Result);
+
+	void LaunchClients(const FString& Address);
+	void LaunchStandaloneClients(const FString& Address, int32 NumClients);
+	void LaunchPIEClients(const FString& Address, int32 NumClients);
+	void HandlePostPIEStarted(bool bIsSimulating);
+
+	void Fail(const FString& Error);
+
+	bool bInProgress = false;
+	TSharedPtr<FEdgegapDeployHandle> DeployHandle;
+
+	// Held until the PIE session we requested started and its clients were sent to Address
+	FString PIEAddress;
+	ULevelEditorPlaySettings* PIEPlaySettings = nullptr;
+	FDelegateHandle PostPIEStartedHandle;
+};
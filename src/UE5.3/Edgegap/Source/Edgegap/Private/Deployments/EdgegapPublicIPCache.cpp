@@ -0,0 +1,185 @@
+#include "EdgegapPublicIPCache.h"
+#include "EdgegapSettings.h"
+#include "EdgegapSettingsDetails.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+
+namespace
+{
+	const TCHAR* IpifyURL = TEXT("https://api.ipify.org/");
+
+	// Don't hammer ipify when it is down or blocked, retry failed lookups at most this often
+	const double FailedLookupRetryDelay = 60.0;
+
+	const float StalenessCheckRate = 30.0f;
+
+	bool IsPlausibleIP(const FString& InAddress)
+	{
+		if (InAddress.IsEmpty() || InAddress.Len() > 45)
+		{
+			return false;
+		}
+
+		for (const TCHAR Character : InAddress)
+		{
+			if (!FChar::IsHexDigit(Character) && Character != TEXT('.') && Character != TEXT(':'))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+FEdgegapPublicIPCache& FEdgegapPublicIPCache::Get()
+{
+	static FEdgegapPublicIPCache Instance;
+	return Instance;
+}
+
+void FEdgegapPublicIPCache::Startup()
+{
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FEdgegapPublicIPCache::Tick), StalenessCheckRate);
+	}
+
+	if (IsStale())
+	{
+		Refresh();
+	}
+}
+
+void FEdgegapPublicIPCache::Shutdown()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	PendingResolves.Empty();
+}
+
+FString FEdgegapPublicIPCache::GetPublicIP() const
+{
+	const FString Override = GetDefault<UEdgegapSettings>()->PublicIPOverride.TrimStartAndEnd();
+
+	return Override.IsEmpty() ? CachedPublicIP : Override;
+}
+
+void FEdgegapPublicIPCache::ResolvePublicIP(TFunction<void(const FString&)> OnResolved)
+{
+	const FString PublicIP = GetPublicIP();
+
+	if (!PublicIP.IsEmpty())
+	{
+		// A stale address is still far better than delaying the deploy, refresh it for next time
+		if (IsStale())
+		{
+			Refresh();
+		}
+
+		OnResolved(PublicIP);
+		return;
+	}
+
+	PendingResolves.Add(MoveTemp(OnResolved));
+
+	// Someone is waiting on this one, don't hold it back for the failed lookup delay
+	LastAttemptTime = -DBL_MAX;
+	Refresh();
+}
+
+bool FEdgegapPublicIPCache::IsStale() const
+{
+	// The override is never looked up
+	if (!GetDefault<UEdgegapSettings>()->PublicIPOverride.TrimStartAndEnd().IsEmpty())
+	{
+		return false;
+	}
+
+	const double TTLSeconds = GetDefault<UEdgegapSettings>()->PublicIPCacheTTL * 60.0;
+
+	return CachedPublicIP.IsEmpty() || FPlatformTime::Seconds() - ResolvedTime > TTLSeconds;
+}
+
+bool FEdgegapPublicIPCache::Tick(float DeltaTime)
+{
+	if (IsStale())
+	{
+		Refresh();
+	}
+
+	return true;
+}
+
+void FEdgegapPublicIPCache::Refresh()
+{
+	const double Now = FPlatformTime::Seconds();
+
+	if (bLookupInFlight || Now - LastAttemptTime < FailedLookupRetryDelay)
+	{
+		return;
+	}
+
+	LastAttemptTime = Now;
+
+	FHttpRequestRef Request = FHttpModule::Get().CreateRequest();
+
+	// ipify is a third party, it gets nothing but the request itself
+	const FString& LookupURLOverride = UEdgegapSettings::GetPublicIPLookupURLOverride();
+	Request->SetURL(LookupURLOverride.IsEmpty() ? FString(IpifyURL) : LookupURLOverride);
+	Request->SetVerb("GET");
+	Request->SetHeader(TEXT("User-Agent"), TEXT("X-UnrealEngine-Agent"));
+
+	Request->OnProcessRequestComplete().BindLambda([this](FHttpRequestPtr Request, FHttpResponsePtr ResponsePtr, bool bWasSuccessful)
+	{
+		bLookupInFlight = false;
+
+		if (!bWasSuccessful || !ResponsePtr.IsValid() || ResponsePtr->GetResponseCode() < 200 || ResponsePtr->GetResponseCode() > 299)
+		{
+			UE_LOG(EdgegapLog, Warning, TEXT("PublicIPCache: HTTP request failed with code %d"), ResponsePtr.IsValid() ? ResponsePtr->GetResponseCode() : 0);
+			FinishLookup(FString());
+			return;
+		}
+
+		const FString Response = ResponsePtr->GetContentAsString().TrimStartAndEnd();
+
+		if (!IsPlausibleIP(Response))
+		{
+			UE_LOG(EdgegapLog, Warning, TEXT("PublicIPCache: Unexpected response: %s"), *Response);
+			FinishLookup(FString());
+			return;
+		}
+
+		CachedPublicIP = Response;
+		ResolvedTime = FPlatformTime::Seconds();
+
+		FinishLookup(Response);
+	});
+
+	bLookupInFlight = true;
+
+	if (!Request->ProcessRequest())
+	{
+		UE_LOG(EdgegapLog, Error, TEXT("PublicIPCache: Could not process HTTP request"));
+
+		bLookupInFlight = false;
+		FinishLookup(FString());
+	}
+}
+
+void FEdgegapPublicIPCache::FinishLookup(const FString& InPublicIP)
+{
+	// Keep serving the previous address when a refresh fails
+	const FString PublicIP = InPublicIP.IsEmpty() ? GetPublicIP() : InPublicIP;
+
+	TArray<TFunction<void(const FString&)>> Resolves = MoveTemp(PendingResolves);
+	for (const TFunction<void(const FString&)>& Resolve : Resolves)
+	{
+		Resolve(PublicIP);
+	}
+}
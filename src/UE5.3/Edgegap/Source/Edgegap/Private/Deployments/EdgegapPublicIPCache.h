@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+/**
+ * Caches the workstation's public IP, used as the ip_list of v1/deploy so Edgegap picks a location close to us.
+ *
+ * Resolved once at startup through api.ipify.org and refreshed in the background when it gets older than the
+ * configured TTL, so deploys never wait on a third party round-trip. The Public IP Override setting bypasses it.
+ */
+class FEdgegapPublicIPCache
+{
+public:
+	static FEdgegapPublicIPCache& Get();
+
+	void Startup();
+	void Shutdown();
+
+	/** The override or the cached address, empty while nothing has been resolved yet. */
+	FString GetPublicIP() const;
+
+	/** Calls back right away when an address is known, otherwise once the lookup in flight finishes (empty on failure). */
+	void ResolvePublicIP(TFunction<void(const FString&)> OnResolved);
+
+	/** Starts a background lookup unless one is already in flight. */
+	void Refresh();
+
+private:
+	bool Tick(float DeltaTime);
+	bool IsStale() const;
+	void FinishLookup(const FString& InPublicIP);
+
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	FString CachedPublicIP;
+	double ResolvedTime = 0.0;
+	double LastAttemptTime = -DBL_MAX;
+	bool bLookupInFlight = false;
+
+	TArray<TFunction<void(const FString&)>> PendingResolves;
+};
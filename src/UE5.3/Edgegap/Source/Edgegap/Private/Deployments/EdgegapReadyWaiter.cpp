@@ -0,0 +1,216 @@
+#include "EdgegapReadyWaiter.h"
+#include "EdgegapDeploymentPoller.h"
+#include "EdgegapDeploymentRequests.h"
+#include "EdgegapPublicIPCache.h"
+#include "EdgegapSettingsDetails.h"
+
+namespace
+{
+	// Deadlines and rate limit retries don't need to be any more precise than this
+	const float WaiterTickRate = 0.5f;
+}
+
+FEdgegapReadyWaiter& FEdgegapReadyWaiter::Get()
+{
+	static FEdgegapReadyWaiter Instance;
+	return Instance;
+}
+
+void FEdgegapReadyWaiter::Startup()
+{
+	FEdgegapDeploymentPoller& Poller = FEdgegapDeploymentPoller::Get();
+	DeploymentsUpdatedHandle = Poller.OnDeploymentsUpdated().AddRaw(this, &FEdgegapReadyWaiter::HandleDeploymentsUpdated);
+
+	// Keeps the poller at the transitioning interval while a handle waits, panel open or not
+	Poller.AddWatcher(this, [this]() { return Pending.Num() > 0; });
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FEdgegapReadyWaiter::Tick), WaiterTickRate);
+}
+
+void FEdgegapReadyWaiter::Shutdown()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	FEdgegapDeploymentPoller& Poller = FEdgegapDeploymentPoller::Get();
+	Poller.OnDeploymentsUpdated().Remove(DeploymentsUpdatedHandle);
+	Poller.RemoveWatcher(this);
+
+	const TArray<TSharedRef<FEdgegapDeployHandle>> Waiting = MoveTemp(Pending);
+	for (const TSharedRef<FEdgegapDeployHandle>& Handle : Waiting)
+	{
+		Fail(*Handle, TEXT("Editor is shutting down"));
+	}
+}
+
+void FEdgegapReadyWaiter::Add(const TSharedRef<FEdgegapDeployHandle>& Handle)
+{
+	Pending.Add(Handle);
+
+	UE_LOG(EdgegapLog, Log, TEXT("DeployUntilReady: Deploying %s, waiting up to %.0fs"), *Handle->Params.VersionName, Handle->Params.Timeout);
+
+	if (Handle->Params.PlayerIPs.Num() > 0)
+	{
+		Deploy(Handle);
+		return;
+	}
+
+	// Usually answered straight from the cache
+	TWeakPtr<FEdgegapDeployHandle> WeakHandle = Handle;
+	FEdgegapPublicIPCache::Get().ResolvePublicIP([this, WeakHandle](const FString& PublicIP)
+	{
+		TSharedPtr<FEdgegapDeployHandle> Handle = WeakHandle.Pin();
+		if (!Handle.IsValid() || Handle->IsFinished())
+		{
+			return;
+		}
+
+		if (PublicIP.IsEmpty())
+		{
+			Fail(*Handle, TEXT("Could not determine the public IP, set a Public IP Override in the Deployments settings"));
+			return;
+		}
+
+		Handle->Params.PlayerIPs.Add(PublicIP);
+		Deploy(Handle.ToSharedRef());
+	});
+}
+
+void FEdgegapReadyWaiter::Deploy(const TSharedRef<FEdgegapDeployHandle>& Handle)
+{
+	const FEdgegapDeployParams& Params = Handle->Params;
+
+	TWeakPtr<FEdgegapDeployHandle> WeakHandle = Handle;
+	FEdgegapDeploymentRequests::Deploy(Params.AppName, Params.VersionName, Params.API_key, Params.PlayerIPs, [WeakHandle](const FEdgegapRequestResult& Result)
+	{
+		TSharedPtr<FEdgegapDeployHandle> Handle = WeakHandle.Pin();
+		if (!Handle.IsValid())
+		{
+			return;
+		}
+
+		if (Handle->IsFinished())
+		{
+			if (Result.bSucceeded)
+			{
+				UE_LOG(EdgegapLog, Warning, TEXT("DeployUntilReady: %s was deployed after the wait ended, it keeps running"), *Result.RequestID);
+			}
+			return;
+		}
+
+		if (!Result.bSucceeded && Result.RetryAfter > 0.0)
+		{
+			// Sent again by the ticker, as long as the deadline allows
+			Handle->RetryTime = FPlatformTime::Seconds() + Result.RetryAfter;
+			return;
+		}
+
+		if (!Result.bSucceeded)
+		{
+			Fail(*Handle, Result.Error);
+			return;
+		}
+
+		Handle->Result.RequestID = Result.RequestID;
+
+		// The new deployment may take a moment to even show up in v1/deployments
+		FEdgegapDeploymentPoller& Poller = FEdgegapDeploymentPoller::Get();
+		Poller.ExpectTransition();
+		Poller.PollNow(Handle->Params.API_key);
+	});
+}
+
+void FEdgegapReadyWaiter::HandleDeploymentsUpdated(const TArray<TSharedPtr<FDeploymentStatusListItem>>& Deployments)
+{
+	if (Pending.Num() == 0)
+	{
+		return;
+	}
+
+	TMap<FString, const FDeploymentStatusListItem*> ByRequestID;
+	ByRequestID.Reserve(Deployments.Num());
+	for (const TSharedPtr<FDeploymentStatusListItem>& Item : Deployments)
+	{
+		ByRequestID.Add(Item->RequestID, Item.Get());
+	}
+
+	// Finishing runs listeners, which may start new deploys
+	const TArray<TSharedRef<FEdgegapDeployHandle>> Waiting = Pending;
+	for (const TSharedRef<FEdgegapDeployHandle>& Handle : Waiting)
+	{
+		if (Handle->IsFinished() || Handle->Result.RequestID.IsEmpty())
+		{
+			continue;
+		}
+
+		const FDeploymentStatusListItem* const* Item = ByRequestID.Find(Handle->Result.RequestID);
+		if (!Item)
+		{
+			continue;
+		}
+
+		if ((*Item)->DeploymentReady && (*Item)->DeploymentIP == TEXT("Empty"))
+		{
+			// The poller lists deployments without a gameport link with this placeholder, there is nothing to connect to
+			Fail(*Handle, TEXT("Deployment is ready but has no gameport, check the port name of the application version"));
+		}
+		else if ((*Item)->DeploymentReady)
+		{
+			Handle->Result.bSucceeded = true;
+			Handle->Result.Address = (*Item)->DeploymentIP;
+
+			UE_LOG(EdgegapLog, Log, TEXT("DeployUntilReady: %s ready at %s after %.1fs"), *Handle->Result.RequestID, *Handle->Result.Address, FPlatformTime::Seconds() - Handle->StartTime);
+
+			Handle->Finish();
+		}
+		else if (!(*Item)->IsTransitioning())
+		{
+			Fail(*Handle, (*Item)->DeploymentStatus);
+		}
+	}
+
+	Pending.RemoveAll([](const TSharedRef<FEdgegapDeployHandle>& Handle) { return Handle->IsFinished(); });
+}
+
+void FEdgegapReadyWaiter::Fail(FEdgegapDeployHandle& Handle, const FString& Error)
+{
+	Handle.Result.bSucceeded = false;
+	Handle.Result.Error = Error;
+
+	UE_LOG(EdgegapLog, Warning, TEXT("DeployUntilReady: %s %s failed, %s"), *Handle.Params.VersionName, *Handle.Result.RequestID, *Error);
+
+	Handle.Finish();
+}
+
+bool FEdgegapReadyWaiter::Tick(float DeltaTime)
+{
+	if (Pending.Num() == 0)
+	{
+		return true;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	const TArray<TSharedRef<FEdgegapDeployHandle>> Waiting = Pending;
+	for (const TSharedRef<FEdgegapDeployHandle>& Handle : Waiting)
+	{
+		if (Handle->IsFinished())
+		{
+			continue;
+		}
+
+		if (Now > Handle->Deadline)
+		{
+			Handle->Result.bTimedOut = true;
+			Fail(*Handle, FString::Printf(TEXT("Not ready after %.0fs"), Handle->Params.Timeout));
+		}
+		else if (Handle->RetryTime > 0.0 && Now >= Handle->RetryTime)
+		{
+			Handle->RetryTime = 0.0;
+			Deploy(Handle);
+		}
+	}
+
+	// Also picks up cancelled handles
+	Pending.RemoveAll([](const TSharedRef<FEdgegapDeployHandle>& Handle) { return Handle->IsFinished(); });
+	return true;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "EdgegapDeployUntilReady.h"
+#include "EdgegapDeploymentTypes.h"
+
+/**
+ * Drives every FEdgegapDeployHandle: sends the deploy, then resolves it from the shared poller's updates.
+ *
+ * One subscription to the poller serves all pending handles and only keeps it awake while any is pending,
+ * a slow ticker retries rate limited deploys and fails handles past their deadline.
+ */
+class FEdgegapReadyWaiter
+{
+public:
+	static FEdgegapReadyWaiter& Get();
+
+	void Startup();
+
+	/** Fails whatever is still pending. */
+	void Shutdown();
+
+	void Add(const TSharedRef<FEdgegapDeployHandle>& Handle);
+
+private:
+	void Deploy(const TSharedRef<FEdgegapDeployHandle>& Handle);
+
+	void HandleDeploymentsUpdated(const TArray<TSharedPtr<FDeploymentStatusListItem>>& Deployments);
+	bool Tick(float DeltaTime);
+
+	static void Fail(FEdgegapDeployHandle& Handle, const FString& Error);
+
+	TArray<TSharedRef<FEdgegapDeployHandle>> Pending;
+
+	FDelegateHandle DeploymentsUpdatedHandle;
+	FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -0,0 +1,142 @@
+#include "EdgegapRequestFanOut.h"
+#include "EdgegapSettingsDetails.h"
+
+namespace
+{
+	// A job rate limited more often than this is given up on
+	const int32 MaxRateLimitRetries = 5;
+
+	// Fallback when a 429 doesn't say how long to wait
+	const double DefaultRetryAfter = 5.0;
+}
+
+TSharedRef<FEdgegapRequestFanOut> FEdgegapRequestFanOut::Start(int32 NumJobs, int32 MaxConcurrency, FLaunchJob InLaunchJob, FOnAllDone InOnAllDone)
+{
+	TSharedRef<FEdgegapRequestFanOut> FanOut = MakeShareable(new FEdgegapRequestFanOut());
+
+	FanOut->LaunchJob = MoveTemp(InLaunchJob);
+	FanOut->OnAllDone = MoveTemp(InOnAllDone);
+	FanOut->MaxConcurrency = FMath::Max(MaxConcurrency, 1);
+
+	FanOut->Queue.Reserve(NumJobs);
+	for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
+	{
+		FanOut->Queue.Add(JobIndex);
+	}
+
+	// The ticker keeps the fan-out alive until the last job reported back
+	FanOut->TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([FanOut](float DeltaTime)
+	{
+		return FanOut->Tick(DeltaTime);
+	}), 0.1f);
+
+	FanOut->Dispatch();
+
+	return FanOut;
+}
+
+void FEdgegapRequestFanOut::Cancel()
+{
+	NumFailed += Queue.Num();
+	Queue.Empty();
+
+	CheckFinished();
+}
+
+double FEdgegapRequestFanOut::GetRetryAfter(FHttpResponsePtr ResponsePtr)
+{
+	if (!ResponsePtr.IsValid() || ResponsePtr->GetResponseCode() != 429)
+	{
+		return 0.0;
+	}
+
+	const FString RetryAfter = ResponsePtr->GetHeader(TEXT("Retry-After"));
+
+	return RetryAfter.IsNumeric() ? FMath::Max(FCString::Atod(*RetryAfter), 0.1) : DefaultRetryAfter;
+}
+
+bool FEdgegapRequestFanOut::Tick(float DeltaTime)
+{
+	Dispatch();
+	CheckFinished();
+
+	if (bFinished)
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void FEdgegapRequestFanOut::Dispatch()
+{
+	if (FPlatformTime::Seconds() < PausedUntil)
+	{
+		return;
+	}
+
+	while (Queue.Num() > 0 && NumInFlight < MaxConcurrency)
+	{
+		const int32 JobIndex = Queue[0];
+		Queue.RemoveAt(0, 1, false);
+
+		++NumInFlight;
+
+		TWeakPtr<FEdgegapRequestFanOut> WeakThis = AsShared();
+		LaunchJob(JobIndex, [WeakThis, JobIndex](bool bSucceeded, double RetryAfter)
+		{
+			if (TSharedPtr<FEdgegapRequestFanOut> This = WeakThis.Pin())
+			{
+				This->HandleJobDone(JobIndex, bSucceeded, RetryAfter);
+			}
+		});
+	}
+}
+
+void FEdgegapRequestFanOut::HandleJobDone(int32 JobIndex, bool bSucceeded, double RetryAfter)
+{
+	--NumInFlight;
+
+	if (RetryAfter > 0.0)
+	{
+		int32& RetryCount = RetryCounts.FindOrAdd(JobIndex);
+
+		if (++RetryCount <= MaxRateLimitRetries)
+		{
+			UE_LOG(EdgegapLog, Log, TEXT("RequestFanOut: Rate limited, pausing for %.1fs"), RetryAfter);
+
+			PausedUntil = FMath::Max(PausedUntil, FPlatformTime::Seconds() + RetryAfter);
+			Queue.Insert(JobIndex, 0);
+			return;
+		}
+
+		bSucceeded = false;
+	}
+
+	if (bSucceeded)
+	{
+		++NumSucceeded;
+	}
+	else
+	{
+		++NumFailed;
+	}
+
+	CheckFinished();
+}
+
+void FEdgegapRequestFanOut::CheckFinished()
+{
+	if (bFinished || Queue.Num() > 0 || NumInFlight > 0)
+	{
+		return;
+	}
+
+	bFinished = true;
+
+	if (OnAllDone)
+	{
+		OnAllDone(NumSucceeded, NumFailed);
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Interfaces/IHttpResponse.h"
+
+/**
+ * Runs a fixed number of API jobs with at most MaxConcurrency of them in flight.
+ *
+ * A job reporting a rate limit is put back at the front of the queue and nothing new is sent until
+ * its Retry-After has passed, so a large batch slows down instead of failing half way through.
+ */
+class FEdgegapRequestFanOut : public TSharedFromThis<FEdgegapRequestFanOut>
+{
+public:
+	/** Called once by a job when its request finished. A positive RetryAfter means rate limited, the job is retried later. */
+	typedef TFunction<void(bool bSucceeded, double RetryAfter)> FJobDone;
+	typedef TFunction<void(int32 JobIndex, FJobDone Done)> FLaunchJob;
+	typedef TFunction<void(int32 NumSucceeded, int32 NumFailed)> FOnAllDone;
+
+	static TSharedRef<FEdgegapRequestFanOut> Start(int32 NumJobs, int32 MaxConcurrency, FLaunchJob InLaunchJob, FOnAllDone InOnAllDone);
+
+	/** Drops the jobs that haven't been sent yet, they count as failed. Jobs in flight still report back. */
+	void Cancel();
+
+	bool IsFinished() const { return bFinished; }
+
+	/** Seconds to wait before retrying when ResponsePtr is a 429, zero otherwise. */
+	static double GetRetryAfter(FHttpResponsePtr ResponsePtr);
+
+private:
+	FEdgegapRequestFanOut() {}
+
+	bool Tick(float DeltaTime);
+	void Dispatch();
+	void HandleJobDone(int32 JobIndex, bool bSucceeded, double RetryAfter);
+	void CheckFinished();
+
+	FLaunchJob LaunchJob;
+	FOnAllDone OnAllDone;
+
+	TArray<int32> Queue;
+	TMap<int32, int32> RetryCounts;
+
+	int32 MaxConcurrency = 1;
+	int32 NumInFlight = 0;
+	int32 NumSucceeded = 0;
+	int32 NumFailed = 0;
+
+	double PausedUntil = 0.0;
+	bool bFinished = false;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+};
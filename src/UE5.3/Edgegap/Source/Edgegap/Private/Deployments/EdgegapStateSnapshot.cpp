@@ -0,0 +1,290 @@
+#include "EdgegapStateSnapshot.h"
+#include "EdgegapDeploymentPoller.h"
+#include "EdgegapSettings.h"
+#include "EdgegapSettingsDetails.h"
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	const float SnapshotTickRate = 1.0f;
+
+	// Deployments change every poll while something transitions, the file doesn't need to follow that closely
+	const double MinSaveInterval = 10.0;
+}
+
+FEdgegapStateSnapshot& FEdgegapStateSnapshot::Get()
+{
+	static FEdgegapStateSnapshot Instance;
+	return Instance;
+}
+
+void FEdgegapStateSnapshot::Startup()
+{
+	AccountKey = GetAccountKey();
+
+	DeploymentsUpdatedHandle = FEdgegapDeploymentPoller::Get().OnDeploymentsUpdated().AddRaw(this, &FEdgegapStateSnapshot::HandleDeploymentsUpdated);
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FEdgegapStateSnapshot::Tick), SnapshotTickRate);
+
+	if (AccountKey.IsEmpty())
+	{
+		return;
+	}
+
+	const FString ExpectedKey = AccountKey;
+	Async(EAsyncExecution::ThreadPool, [this, ExpectedKey]()
+	{
+		TSharedRef<FSnapshot> Snapshot = MakeShared<FSnapshot>();
+		if (!Load(*Snapshot) || Snapshot->AccountKey != ExpectedKey)
+		{
+			return;
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [this, Snapshot]()
+		{
+			// Token changed or shut down meanwhile
+			if (!TickerHandle.IsValid() || AccountKey != Snapshot->AccountKey)
+			{
+				return;
+			}
+
+			// Anything confirmed since startup is newer than the file
+			if (TokenCheckedTime.GetTicks() == 0)
+			{
+				bTokenVerified = Snapshot->bTokenVerified;
+				TokenCheckedTime = Snapshot->TokenCheckedTime;
+			}
+
+			const FString API_key = GetDefault<UEdgegapSettings>()->APIToken.APIToken;
+			for (const TSharedPtr<FDeploymentStatusListItem>& Deployment : Snapshot->Deployments)
+			{
+				Deployment->API_Key = API_key;
+			}
+
+			UE_LOG(EdgegapLog, Log, TEXT("StateSnapshot: Restored %d deployments from %s"), Snapshot->Deployments.Num(), *Snapshot->DeploymentsTime.ToString());
+
+			if (DeploymentsTime.GetTicks() == 0)
+			{
+				DeploymentsTime = Snapshot->DeploymentsTime;
+			}
+
+			FEdgegapDeploymentPoller::Get().RestoreDeployments(MoveTemp(Snapshot->Deployments), Snapshot->DeploymentsTime);
+		});
+	});
+}
+
+void FEdgegapStateSnapshot::Shutdown()
+{
+	FEdgegapDeploymentPoller::Get().OnDeploymentsUpdated().Remove(DeploymentsUpdatedHandle);
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	if (bDirty)
+	{
+		Save(false);
+	}
+}
+
+bool FEdgegapStateSnapshot::IsTokenVerified() const
+{
+	return bTokenVerified && AccountKey == GetAccountKey();
+}
+
+void FEdgegapStateSnapshot::SetTokenVerified(bool bVerified)
+{
+	AccountKey = GetAccountKey();
+	bTokenVerified = bVerified;
+	TokenCheckedTime = FDateTime::UtcNow();
+	bDirty = true;
+}
+
+void FEdgegapStateSnapshot::HandleDeploymentsUpdated(const TArray<TSharedPtr<FDeploymentStatusListItem>>& Deployments)
+{
+	const FString CurrentKey = GetAccountKey();
+	if (CurrentKey != AccountKey)
+	{
+		// Verified for another token, that says nothing about this one
+		AccountKey = CurrentKey;
+		bTokenVerified = false;
+	}
+
+	DeploymentsTime = FDateTime::UtcNow();
+	bDirty = true;
+}
+
+bool FEdgegapStateSnapshot::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	if (bDirty && Now >= NextSaveTime)
+	{
+		Save(true);
+		NextSaveTime = Now + MinSaveInterval;
+	}
+
+	return true;
+}
+
+void FEdgegapStateSnapshot::Save(bool bAsync)
+{
+	bDirty = false;
+
+	if (AccountKey.IsEmpty())
+	{
+		return;
+	}
+
+	FSnapshot Snapshot;
+	Snapshot.AccountKey = AccountKey;
+	Snapshot.bTokenVerified = bTokenVerified;
+	Snapshot.TokenCheckedTime = TokenCheckedTime;
+	Snapshot.DeploymentsTime = DeploymentsTime;
+	Snapshot.Deployments = FEdgegapDeploymentPoller::Get().GetDeployments();
+
+	// Items are updated in place by the poller, so they are only read here on the game thread
+	FString JsonString = ToJson(Snapshot);
+
+	auto Write = [JsonString = MoveTemp(JsonString)]()
+	{
+		if (!FFileHelper::SaveStringToFile(JsonString, *GetSnapshotPath()))
+		{
+			UE_LOG(EdgegapLog, Warning, TEXT("StateSnapshot: Could not write %s"), *GetSnapshotPath());
+		}
+	};
+
+	if (bAsync)
+	{
+		Async(EAsyncExecution::ThreadPool, MoveTemp(Write));
+	}
+	else
+	{
+		Write();
+	}
+}
+
+FString FEdgegapStateSnapshot::GetSnapshotPath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("Edgegap") / TEXT("Snapshot.json");
+}
+
+FString FEdgegapStateSnapshot::GetAccountKey()
+{
+	const FString& APIToken = GetDefault<UEdgegapSettings>()->APIToken.APIToken;
+	if (APIToken.IsEmpty())
+	{
+		return FString();
+	}
+
+	return FMD5::HashAnsiString(*(UEdgegapSettings::GetApiBaseURL() + APIToken));
+}
+
+bool FEdgegapStateSnapshot::Load(FSnapshot& OutSnapshot)
+{
+	FString JsonString;
+	if (!FFileHelper::LoadFileToString(JsonString, *GetSnapshotPath()))
+	{
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid() || !JsonObject->TryGetStringField(TEXT("account"), OutSnapshot.AccountKey))
+	{
+		UE_LOG(EdgegapLog, Warning, TEXT("StateSnapshot: Ignoring unreadable %s"), *GetSnapshotPath());
+		return false;
+	}
+
+	FString Time;
+	JsonObject->TryGetBoolField(TEXT("token_verified"), OutSnapshot.bTokenVerified);
+	if (JsonObject->TryGetStringField(TEXT("token_checked_at"), Time))
+	{
+		FDateTime::ParseIso8601(*Time, OutSnapshot.TokenCheckedTime);
+	}
+	if (JsonObject->TryGetStringField(TEXT("deployments_at"), Time))
+	{
+		FDateTime::ParseIso8601(*Time, OutSnapshot.DeploymentsTime);
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* Deployments = nullptr;
+	if (!JsonObject->TryGetArrayField(TEXT("deployments"), Deployments))
+	{
+		return true;
+	}
+
+	for (const TSharedPtr<FJsonValue>& DeploymentValue : *Deployments)
+	{
+		const TSharedPtr<FJsonObject>* DeploymentObject = nullptr;
+		if (!DeploymentValue->TryGetObject(DeploymentObject))
+		{
+			continue;
+		}
+
+		TSharedPtr<FDeploymentStatusListItem> Item = MakeShared<FDeploymentStatusListItem>();
+		Item->DeploymentReady = false;
+
+		if (!(*DeploymentObject)->TryGetStringField(TEXT("request_id"), Item->RequestID))
+		{
+			continue;
+		}
+
+		(*DeploymentObject)->TryGetStringField(TEXT("link"), Item->DeploymentIP);
+		(*DeploymentObject)->TryGetStringField(TEXT("status"), Item->DeploymentStatus);
+		(*DeploymentObject)->TryGetBoolField(TEXT("ready"), Item->DeploymentReady);
+		(*DeploymentObject)->TryGetStringField(TEXT("app_name"), Item->AppName);
+		(*DeploymentObject)->TryGetStringField(TEXT("app_version"), Item->AppVersion);
+		(*DeploymentObject)->TryGetStringField(TEXT("public_ip"), Item->PublicIP);
+		(*DeploymentObject)->TryGetNumberField(TEXT("echo_port"), Item->EchoPort);
+		(*DeploymentObject)->TryGetStringField(TEXT("location"), Item->Location);
+
+		if ((*DeploymentObject)->TryGetStringField(TEXT("start_time"), Time))
+		{
+			FDateTime::ParseIso8601(*Time, Item->StartTime);
+		}
+
+		OutSnapshot.Deployments.Add(Item);
+	}
+
+	return true;
+}
+
+FString FEdgegapStateSnapshot::ToJson(const FSnapshot& Snapshot)
+{
+	FString JsonString;
+	TSharedRef<TJsonWriter<TCHAR>> JsonWriter = TJsonWriterFactory<TCHAR>::Create(&JsonString);
+
+	JsonWriter->WriteObjectStart();
+	JsonWriter->WriteValue(TEXT("account"), Snapshot.AccountKey);
+	JsonWriter->WriteValue(TEXT("token_verified"), Snapshot.bTokenVerified);
+	JsonWriter->WriteValue(TEXT("token_checked_at"), Snapshot.TokenCheckedTime.ToIso8601());
+	JsonWriter->WriteValue(TEXT("deployments_at"), Snapshot.DeploymentsTime.ToIso8601());
+
+	JsonWriter->WriteArrayStart(TEXT("deployments"));
+	for (const TSharedPtr<FDeploymentStatusListItem>& Item : Snapshot.Deployments)
+	{
+		JsonWriter->WriteObjectStart();
+		JsonWriter->WriteValue(TEXT("request_id"), Item->RequestID);
+		JsonWriter->WriteValue(TEXT("link"), Item->DeploymentIP);
+		JsonWriter->WriteValue(TEXT("status"), Item->DeploymentStatus);
+		JsonWriter->WriteValue(TEXT("ready"), Item->DeploymentReady);
+		JsonWriter->WriteValue(TEXT("app_name"), Item->AppName);
+		JsonWriter->WriteValue(TEXT("app_version"), Item->AppVersion);
+		JsonWriter->WriteValue(TEXT("public_ip"), Item->PublicIP);
+		JsonWriter->WriteValue(TEXT("echo_port"), Item->EchoPort);
+		JsonWriter->WriteValue(TEXT("location"), Item->Location);
+		JsonWriter->WriteValue(TEXT("start_time"), Item->StartTime.ToIso8601());
+		JsonWriter->WriteObjectEnd();
+	}
+	JsonWriter->WriteArrayEnd();
+
+	JsonWriter->WriteObjectEnd();
+	JsonWriter->Close();
+
+	return JsonString;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "EdgegapDeploymentTypes.h"
+
+/**
+ * Last known account state in Saved/Edgegap/Snapshot.json, so the panel opens with content instead of waiting on the API.
+ *
+ * Holds the deployments list and whether the token was verified, each with when it was last confirmed. Both only
+ * apply to the token and API they were fetched with. Restored deployments are shown as stale until a poll replaces them.
+ */
+class FEdgegapStateSnapshot
+{
+public:
+	static FEdgegapStateSnapshot& Get();
+
+	/** Loads on the thread pool and hands the deployments to the poller. */
+	void Startup();
+
+	/** Writes what is still pending. */
+	void Shutdown();
+
+	/** Whether the current token (and API) was verified the last time it was checked */
+	bool IsTokenVerified() const;
+	void SetTokenVerified(bool bVerified);
+
+private:
+	struct FSnapshot
+	{
+		FString AccountKey;
+
+		bool bTokenVerified = false;
+		FDateTime TokenCheckedTime;
+
+		FDateTime DeploymentsTime;
+		TArray<TSharedPtr<FDeploymentStatusListItem>> Deployments;
+	};
+
+	void HandleDeploymentsUpdated(const TArray<TSharedPtr<FDeploymentStatusListItem>>& Deployments);
+	bool Tick(float DeltaTime);
+
+	/** Serializes on the game thread, bAsync writes the file on the thread pool. */
+	void Save(bool bAsync);
+
+	static FString GetSnapshotPath();
+
+	/** Identifies token and API without storing the token */
+	static FString GetAccountKey();
+
+	static bool Load(FSnapshot& OutSnapshot);
+	static FString ToJson(const FSnapshot& Snapshot);
+
+	FString AccountKey;
+	bool bTokenVerified = false;
+	FDateTime TokenCheckedTime;
+	FDateTime DeploymentsTime;
+
+	bool bDirty = false;
+	double NextSaveTime = 0.0;
+
+	FDelegateHandle DeploymentsUpdatedHandle;
+	FTSTicker::FDelegateHandle TickerHandle;
+};
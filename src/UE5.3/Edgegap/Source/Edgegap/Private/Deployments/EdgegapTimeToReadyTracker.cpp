@@ -0,0 +1,377 @@
+#include "EdgegapTimeToReadyTracker.h"
+#include "EdgegapDeploymentPoller.h"
+#include "EdgegapSettingsDetails.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#define LOCTEXT_NAMESPACE "EdgegapTimeToReady"
+
+namespace
+{
+	const int32 MaxSamplesPerVersion = 100;
+	const int32 MaxVersions = 20;
+	const int32 MaxVersionsInSummary = 5;
+
+	// A deployment that isn't ready after this long is not going to give a meaningful sample
+	const double MaxTrackedTime = 3600.0;
+
+	// New deployments can take a few polls to be listed, one missing for longer was stopped or deleted elsewhere
+	const int32 MaxMissedPolls = 10;
+
+	double GetPercentile(TArray<double> Values, float Percentile)
+	{
+		if (Values.Num() == 0)
+		{
+			return 0.0;
+		}
+
+		Values.Sort();
+		return Values[FMath::Clamp(FMath::CeilToInt(Percentile * Values.Num()) - 1, 0, Values.Num() - 1)];
+	}
+}
+
+FEdgegapTimeToReadyTracker& FEdgegapTimeToReadyTracker::Get()
+{
+	static FEdgegapTimeToReadyTracker Instance;
+	return Instance;
+}
+
+void FEdgegapTimeToReadyTracker::Startup()
+{
+	LoadHistory();
+	UpdateSummary();
+
+	FEdgegapDeploymentPoller& Poller = FEdgegapDeploymentPoller::Get();
+	DeploymentsUpdatedHandle = Poller.OnDeploymentsUpdated().AddRaw(this, &FEdgegapTimeToReadyTracker::HandleDeploymentsUpdated);
+
+	// Keeps polling at the transitioning interval while a deployment we timestamp is on its way, panel open or not
+	Poller.AddWatcher(this, [this]() { return Tracked.Num() > 0; });
+}
+
+void FEdgegapTimeToReadyTracker::Shutdown()
+{
+	FEdgegapDeploymentPoller& Poller = FEdgegapDeploymentPoller::Get();
+	Poller.OnDeploymentsUpdated().Remove(DeploymentsUpdatedHandle);
+	Poller.RemoveWatcher(this);
+
+	Tracked.Empty();
+}
+
+void FEdgegapTimeToReadyTracker::NotifyRequested(const FString& RequestID, const FString& AppVersion, double RequestedTime)
+{
+	if (RequestID.IsEmpty())
+	{
+		return;
+	}
+
+	FTrackedDeployment& Deployment = Tracked.Add(RequestID);
+	Deployment.AppVersion = AppVersion;
+	Deployment.PhaseTimes[(int32)EEdgegapDeploymentPhase::Requested] = RequestedTime;
+}
+
+void FEdgegapTimeToReadyTracker::ClearHistory()
+{
+	History.Empty();
+	SaveHistory();
+	UpdateSummary();
+}
+
+EEdgegapDeploymentPhase FEdgegapTimeToReadyTracker::GetPhase(const FDeploymentStatusListItem& Deployment)
+{
+	if (Deployment.DeploymentReady)
+	{
+		return EEdgegapDeploymentPhase::Ready;
+	}
+
+	const FString& Status = Deployment.DeploymentStatus;
+
+	if (Status.Contains(TEXT("READY")))
+	{
+		return EEdgegapDeploymentPhase::Running;
+	}
+
+	if (Status.Contains(TEXT("DEPLOYING")))
+	{
+		return EEdgegapDeploymentPhase::PullingImage;
+	}
+
+	if (Status.Contains(TEXT("SEEKED")) || Status.Contains(TEXT("SCANNING")))
+	{
+		return EEdgegapDeploymentPhase::Scheduled;
+	}
+
+	return EEdgegapDeploymentPhase::Requested;
+}
+
+void FEdgegapTimeToReadyTracker::HandleDeploymentsUpdated(const TArray<TSharedPtr<FDeploymentStatusListItem>>& Deployments)
+{
+	if (Tracked.Num() == 0)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	bool bAddedSample = false;
+
+	for (TPair<FString, FTrackedDeployment>& Pair : Tracked)
+	{
+		++Pair.Value.NumMissedPolls;
+	}
+
+	for (const TSharedPtr<FDeploymentStatusListItem>& Item : Deployments)
+	{
+		FTrackedDeployment* Deployment = Tracked.Find(Item->RequestID);
+		if (!Deployment)
+		{
+			continue;
+		}
+
+		Deployment->NumMissedPolls = 0;
+
+		if (!Item->DeploymentReady && (!Item->IsTransitioning() || Item->DeploymentStatus.Contains(TEXT("TERMINAT"))))
+		{
+			// Failed or stopped before it was ready, nothing to learn about readiness
+			Tracked.Remove(Item->RequestID);
+			continue;
+		}
+
+		const EEdgegapDeploymentPhase Phase = GetPhase(*Item);
+		if (Phase <= Deployment->Phase)
+		{
+			continue;
+		}
+
+		// Phases skipped between two polls stay unobserved
+		Deployment->Phase = Phase;
+		Deployment->PhaseTimes[(int32)Phase] = Now;
+
+		if (Phase != EEdgegapDeploymentPhase::Ready)
+		{
+			continue;
+		}
+
+		const double RequestedTime = Deployment->PhaseTimes[(int32)EEdgegapDeploymentPhase::Requested];
+
+		FEdgegapTimeToReadySample Sample;
+		Sample.Timestamp = FDateTime::UtcNow();
+		Sample.TimeToReady = Now - RequestedTime;
+
+		for (int32 PhaseIndex = 0; PhaseIndex < (int32)EEdgegapDeploymentPhase::Num; ++PhaseIndex)
+		{
+			Sample.PhaseTimes[PhaseIndex] = Deployment->PhaseTimes[PhaseIndex] < 0.0 ? -1.0 : Deployment->PhaseTimes[PhaseIndex] - RequestedTime;
+		}
+
+		UE_LOG(EdgegapLog, Log, TEXT("TimeToReady: %s (%s) ready after %.1fs"), *Item->RequestID, *Deployment->AppVersion, Sample.TimeToReady);
+
+		AddSample(Deployment->AppVersion, Sample);
+		Tracked.Remove(Item->RequestID);
+		bAddedSample = true;
+	}
+
+	for (auto It = Tracked.CreateIterator(); It; ++It)
+	{
+		if (It->Value.NumMissedPolls > MaxMissedPolls)
+		{
+			UE_LOG(EdgegapLog, Log, TEXT("TimeToReady: %s no longer listed, not tracked anymore"), *It->Key);
+			It.RemoveCurrent();
+		}
+		else if (Now - It->Value.PhaseTimes[(int32)EEdgegapDeploymentPhase::Requested] > MaxTrackedTime)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	if (bAddedSample)
+	{
+		SaveHistory();
+		UpdateSummary();
+	}
+}
+
+void FEdgegapTimeToReadyTracker::AddSample(const FString& AppVersion, const FEdgegapTimeToReadySample& Sample)
+{
+	const int32 Index = History.IndexOfByPredicate([&AppVersion](const FVersionHistory& VersionHistory)
+	{
+		return VersionHistory.AppVersion == AppVersion;
+	});
+
+	FVersionHistory VersionHistory;
+	if (Index != INDEX_NONE)
+	{
+		VersionHistory = MoveTemp(History[Index]);
+		History.RemoveAt(Index);
+	}
+	else
+	{
+		VersionHistory.AppVersion = AppVersion;
+	}
+
+	VersionHistory.Samples.Add(Sample);
+	if (VersionHistory.Samples.Num() > MaxSamplesPerVersion)
+	{
+		VersionHistory.Samples.RemoveAt(0, VersionHistory.Samples.Num() - MaxSamplesPerVersion);
+	}
+
+	History.Add(MoveTemp(VersionHistory));
+	if (History.Num() > MaxVersions)
+	{
+		History.RemoveAt(0, History.Num() - MaxVersions);
+	}
+}
+
+void FEdgegapTimeToReadyTracker::UpdateSummary()
+{
+	TArray<FString> Lines;
+
+	for (int32 Index = History.Num() - 1; Index >= 0 && Lines.Num() < MaxVersionsInSummary; --Index)
+	{
+		const FVersionHistory& VersionHistory = History[Index];
+
+		TArray<double> TimesToReady;
+		TArray<double> ScheduledTimes;
+		TArray<double> RunningTimes;
+
+		for (const FEdgegapTimeToReadySample& Sample : VersionHistory.Samples)
+		{
+			TimesToReady.Add(Sample.TimeToReady);
+
+			if (Sample.PhaseTimes[(int32)EEdgegapDeploymentPhase::Scheduled] >= 0.0)
+			{
+				ScheduledTimes.Add(Sample.PhaseTimes[(int32)EEdgegapDeploymentPhase::Scheduled]);
+			}
+
+			if (Sample.PhaseTimes[(int32)EEdgegapDeploymentPhase::Running] >= 0.0)
+			{
+				RunningTimes.Add(Sample.PhaseTimes[(int32)EEdgegapDeploymentPhase::Running]);
+			}
+		}
+
+		FString Line = FString::Printf(TEXT("%s (%d): p50 %.0fs, p95 %.0fs, max %.0fs"),
+			VersionHistory.AppVersion.IsEmpty() ? TEXT("Unknown version") : *VersionHistory.AppVersion, TimesToReady.Num(),
+			GetPercentile(TimesToReady, 0.5f), GetPercentile(TimesToReady, 0.95f), GetPercentile(TimesToReady, 1.0f));
+
+		if (ScheduledTimes.Num() > 0 || RunningTimes.Num() > 0)
+		{
+			Line += FString::Printf(TEXT(" | scheduled p50 %.0fs, running p50 %.0fs"), GetPercentile(ScheduledTimes, 0.5f), GetPercentile(RunningTimes, 0.5f));
+		}
+
+		Lines.Add(Line);
+	}
+
+	Summary = Lines.Num() > 0 ? FText::FromString(FString::Join(Lines, LINE_TERMINATOR)) : LOCTEXT("NoSamples", "No deployment from this editor has become ready yet");
+}
+
+FString FEdgegapTimeToReadyTracker::GetHistoryPath() const
+{
+	return FPaths::ProjectSavedDir() / TEXT("Edgegap") / TEXT("TimeToReady.json");
+}
+
+void FEdgegapTimeToReadyTracker::LoadHistory()
+{
+	History.Empty();
+
+	FString JsonString;
+	if (!FFileHelper::LoadFileToString(JsonString, *GetHistoryPath()))
+	{
+		return;
+	}
+
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+
+	const TArray<TSharedPtr<FJsonValue>>* Versions = nullptr;
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid() || !JsonObject->TryGetArrayField(TEXT("versions"), Versions))
+	{
+		UE_LOG(EdgegapLog, Warning, TEXT("TimeToReady: Ignoring unreadable %s"), *GetHistoryPath());
+		return;
+	}
+
+	for (const TSharedPtr<FJsonValue>& VersionValue : *Versions)
+	{
+		const TSharedPtr<FJsonObject>* VersionObject = nullptr;
+		const TArray<TSharedPtr<FJsonValue>>* Samples = nullptr;
+		if (!VersionValue->TryGetObject(VersionObject) || !(*VersionObject)->TryGetArrayField(TEXT("samples"), Samples))
+		{
+			continue;
+		}
+
+		FVersionHistory& VersionHistory = History.AddDefaulted_GetRef();
+		(*VersionObject)->TryGetStringField(TEXT("version"), VersionHistory.AppVersion);
+
+		for (const TSharedPtr<FJsonValue>& SampleValue : *Samples)
+		{
+			const TSharedPtr<FJsonObject>* SampleObject = nullptr;
+			if (!SampleValue->TryGetObject(SampleObject))
+			{
+				continue;
+			}
+
+			FEdgegapTimeToReadySample& Sample = VersionHistory.Samples.AddDefaulted_GetRef();
+			(*SampleObject)->TryGetNumberField(TEXT("time_to_ready"), Sample.TimeToReady);
+
+			FString Timestamp;
+			if ((*SampleObject)->TryGetStringField(TEXT("timestamp"), Timestamp))
+			{
+				FDateTime::ParseIso8601(*Timestamp, Sample.Timestamp);
+			}
+
+			const TArray<TSharedPtr<FJsonValue>>* Phases = nullptr;
+			if ((*SampleObject)->TryGetArrayField(TEXT("phases"), Phases))
+			{
+				for (int32 PhaseIndex = 0; PhaseIndex < FMath::Min(Phases->Num(), (int32)EEdgegapDeploymentPhase::Num); ++PhaseIndex)
+				{
+					Sample.PhaseTimes[PhaseIndex] = (*Phases)[PhaseIndex]->AsNumber();
+				}
+			}
+		}
+	}
+}
+
+void FEdgegapTimeToReadyTracker::SaveHistory() const
+{
+	FString JsonString;
+	TSharedRef<TJsonWriter<TCHAR>> JsonWriter = TJsonWriterFactory<TCHAR>::Create(&JsonString);
+
+	JsonWriter->WriteObjectStart();
+	JsonWriter->WriteArrayStart(TEXT("versions"));
+
+	for (const FVersionHistory& VersionHistory : History)
+	{
+		JsonWriter->WriteObjectStart();
+		JsonWriter->WriteValue(TEXT("version"), VersionHistory.AppVersion);
+		JsonWriter->WriteArrayStart(TEXT("samples"));
+
+		for (const FEdgegapTimeToReadySample& Sample : VersionHistory.Samples)
+		{
+			JsonWriter->WriteObjectStart();
+			JsonWriter->WriteValue(TEXT("time_to_ready"), Sample.TimeToReady);
+			JsonWriter->WriteValue(TEXT("timestamp"), Sample.Timestamp.ToIso8601());
+
+			JsonWriter->WriteArrayStart(TEXT("phases"));
+			for (int32 PhaseIndex = 0; PhaseIndex < (int32)EEdgegapDeploymentPhase::Num; ++PhaseIndex)
+			{
+				JsonWriter->WriteValue(Sample.PhaseTimes[PhaseIndex]);
+			}
+			JsonWriter->WriteArrayEnd();
+
+			JsonWriter->WriteObjectEnd();
+		}
+
+		JsonWriter->WriteArrayEnd();
+		JsonWriter->WriteObjectEnd();
+	}
+
+	JsonWriter->WriteArrayEnd();
+	JsonWriter->WriteObjectEnd();
+	JsonWriter->Close();
+
+	if (!FFileHelper::SaveStringToFile(JsonString, *GetHistoryPath()))
+	{
+		UE_LOG(EdgegapLog, Warning, TEXT("TimeToReady: Could not write %s"), *GetHistoryPath());
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
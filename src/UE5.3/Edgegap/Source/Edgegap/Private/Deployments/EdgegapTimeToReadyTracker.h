@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EdgegapDeploymentTypes.h"
+
+/** Lifecycle phases of a deployment, in order, as far as v1/deployments statuses tell them apart */
+enum class EEdgegapDeploymentPhase : uint8
+{
+	Requested,
+	Scheduled,
+	PullingImage,
+	Running,
+	Ready,
+
+	Num
+};
+
+/** One deployment that made it to ready, seconds since it was requested */
+struct FEdgegapTimeToReadySample
+{
+	double TimeToReady = 0.0;
+
+	// Phase start times, negative when a phase was never observed between two polls
+	double PhaseTimes[(int32)EEdgegapDeploymentPhase::Num] = { 0.0, -1.0, -1.0, -1.0, -1.0 };
+
+	FDateTime Timestamp;
+};
+
+/**
+ * Timestamps the lifecycle of every deployment this editor requested, from the shared poller's updates, and keeps the
+ * time from v1/deploy to ready per application version in Saved/Edgegap so image and caching changes can be compared.
+ *
+ * Resolution is the poll interval, i.e. the transitioning interval while a tracked deployment is on its way.
+ */
+class FEdgegapTimeToReadyTracker
+{
+public:
+	static FEdgegapTimeToReadyTracker& Get();
+
+	void Startup();
+	void Shutdown();
+
+	/** Starts tracking a deployment v1/deploy accepted, RequestedTime being FPlatformTime::Seconds() when the request was sent. */
+	void NotifyRequested(const FString& RequestID, const FString& AppVersion, double RequestedTime);
+
+	/** p50/p95/max per version, most recently deployed version first */
+	FText GetSummary() const { return Summary; }
+
+	void ClearHistory();
+
+private:
+	struct FTrackedDeployment
+	{
+		FString AppVersion;
+		double PhaseTimes[(int32)EEdgegapDeploymentPhase::Num] = { 0.0, -1.0, -1.0, -1.0, -1.0 };
+		EEdgegapDeploymentPhase Phase = EEdgegapDeploymentPhase::Requested;
+
+		// Consecutive polls that didn't list it
+		int32 NumMissedPolls = 0;
+	};
+
+	struct FVersionHistory
+	{
+		FString AppVersion;
+		TArray<FEdgegapTimeToReadySample> Samples;
+	};
+
+	static EEdgegapDeploymentPhase GetPhase(const FDeploymentStatusListItem& Deployment);
+
+	void HandleDeploymentsUpdated(const TArray<TSharedPtr<FDeploymentStatusListItem>>& Deployments);
+	void AddSample(const FString& AppVersion, const FEdgegapTimeToReadySample& Sample);
+	void UpdateSummary();
+
+	FString GetHistoryPath() const;
+	void LoadHistory();
+	void SaveHistory() const;
+
+	TMap<FString, FTrackedDeployment> Tracked;
+
+	// Most recently sampled version last
+	TArray<FVersionHistory> History;
+
+	FText Summary;
+	FDelegateHandle DeploymentsUpdatedHandle;
+};
@@ -0,0 +1,227 @@
+#include "SEdgegapContainerLogView.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Docking/TabManager.h"
+#include "Styling/CoreStyle.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "Widgets/Input/SCheckBox.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Text/STextBlock.h"
+
+#define LOCTEXT_NAMESPACE "EdgegapContainerLogs"
+
+namespace
+{
+	const FName ContainerLogsTabName("EdgegapContainerLogs");
+}
+
+void SEdgegapContainerLogView::RegisterTabSpawner()
+{
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(ContainerLogsTabName, FOnSpawnTab::CreateLambda([](const FSpawnTabArgs& Args)
+	{
+		return SNew(SDockTab)
+			.TabRole(ETabRole::NomadTab)
+			.Label(LOCTEXT("TabLabel", "Container Logs"))
+			[
+				SNew(STextBlock)
+				.Text(LOCTEXT("NoDeployment", "Open the logs of a deployment from the Current Deployments list."))
+			];
+	}))
+		.SetDisplayName(LOCTEXT("TabLabel", "Container Logs"))
+		.SetMenuType(ETabSpawnerMenuType::Hidden);
+}
+
+void SEdgegapContainerLogView::UnregisterTabSpawner()
+{
+	if (FSlateApplication::IsInitialized())
+	{
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(ContainerLogsTabName);
+	}
+}
+
+void SEdgegapContainerLogView::OpenTab(const FString& RequestID, const FString& API_key)
+{
+	TSharedPtr<SDockTab> Tab = FGlobalTabmanager::Get()->TryInvokeTab(FTabId(ContainerLogsTabName));
+	if (!Tab.IsValid())
+	{
+		return;
+	}
+
+	// Replacing the content drops the previous stream, one deployment is tailed at a time
+	Tab->SetLabel(FText::Format(LOCTEXT("TabLabelFor", "Logs: {0}"), FText::FromString(RequestID)));
+	Tab->SetContent(SNew(SEdgegapContainerLogView)
+		.RequestID(RequestID)
+		.API_key(API_key));
+}
+
+void SEdgegapContainerLogView::Construct(const FArguments& InArgs)
+{
+	Stream = MakeShared<FEdgegapContainerLogStream>(InArgs._RequestID, InArgs._API_key);
+	Stream->OnLinesAdded().AddSP(this, &SEdgegapContainerLogView::HandleLinesAdded);
+	Stream->Start();
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(4)
+		[
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.FillWidth(1)
+			[
+				SNew(SSearchBox)
+				.HintText(LOCTEXT("FilterHint", "Filter (regular expression)"))
+				.OnTextChanged(this, &SEdgegapContainerLogView::HandleFilterChanged)
+			]
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(8, 0, 0, 0)
+			.VAlign(VAlign_Center)
+			[
+				SNew(SCheckBox)
+				.IsChecked_Lambda([this]() { return bFollow ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+				.OnCheckStateChanged_Lambda([this](ECheckBoxState State)
+				{
+					bFollow = State == ECheckBoxState::Checked;
+					if (bFollow)
+					{
+						ListView->ScrollToBottom();
+					}
+				})
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("Follow", "Follow"))
+				]
+			]
+		]
+		+ SVerticalBox::Slot()
+		.FillHeight(1)
+		[
+			SAssignNew(ListView, SListView<FEdgegapLogLinePtr>)
+			.ListItemsSource(&FilteredLines)
+			.OnGenerateRow(this, &SEdgegapContainerLogView::GenerateRow)
+			.SelectionMode(ESelectionMode::Multi)
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(4)
+		[
+			SNew(STextBlock)
+			.Text(this, &SEdgegapContainerLogView::GetStatusText)
+		]
+	];
+}
+
+SEdgegapContainerLogView::~SEdgegapContainerLogView()
+{
+	if (Stream.IsValid())
+	{
+		Stream->Stop();
+	}
+}
+
+void SEdgegapContainerLogView::HandleLinesAdded(const TArray<FEdgegapLogLinePtr>& Added)
+{
+	// Let go of lines the ring buffer evicted, so the view never holds more than the buffer does
+	const TEdgegapRingBuffer<FEdgegapLogLinePtr>& Lines = Stream->GetLines();
+	const uint64 OldestNumber = Lines.Num() > 0 ? Lines[0]->Number : 0;
+
+	int32 NumEvicted = 0;
+	while (NumEvicted < FilteredLines.Num() && FilteredLines[NumEvicted]->Number < OldestNumber)
+	{
+		NumEvicted++;
+	}
+	FilteredLines.RemoveAt(0, NumEvicted, false);
+
+	for (const FEdgegapLogLinePtr& Line : Added)
+	{
+		if (PassesFilter(*Line))
+		{
+			FilteredLines.Add(Line);
+		}
+	}
+
+	ListView->RequestListRefresh();
+
+	if (bFollow)
+	{
+		ListView->ScrollToBottom();
+	}
+}
+
+void SEdgegapContainerLogView::HandleFilterChanged(const FText& Text)
+{
+	const FString Filter = Text.ToString();
+
+	if (Filter.IsEmpty())
+	{
+		FilterPattern.Reset();
+	}
+	else
+	{
+		FilterPattern.Emplace(Filter, ERegexPatternFlags::CaseInsensitive);
+	}
+
+	RebuildFilteredLines();
+}
+
+void SEdgegapContainerLogView::RebuildFilteredLines()
+{
+	const TEdgegapRingBuffer<FEdgegapLogLinePtr>& Lines = Stream->GetLines();
+
+	FilteredLines.Reset();
+	for (int32 Index = 0; Index < Lines.Num(); ++Index)
+	{
+		if (PassesFilter(*Lines[Index]))
+		{
+			FilteredLines.Add(Lines[Index]);
+		}
+	}
+
+	ListView->RequestListRefresh();
+
+	if (bFollow)
+	{
+		ListView->ScrollToBottom();
+	}
+}
+
+bool SEdgegapContainerLogView::PassesFilter(const FEdgegapLogLine& Line) const
+{
+	if (!FilterPattern.IsSet())
+	{
+		return true;
+	}
+
+	FRegexMatcher Matcher(FilterPattern.GetValue(), Line.Text);
+	return Matcher.FindNext();
+}
+
+TSharedRef<ITableRow> SEdgegapContainerLogView::GenerateRow(FEdgegapLogLinePtr Line, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(STableRow<FEdgegapLogLinePtr>, OwnerTable)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(Line->Text))
+			.Font(FCoreStyle::GetDefaultFontStyle("Mono", 9))
+		];
+}
+
+FText SEdgegapContainerLogView::GetStatusText() const
+{
+	const TEdgegapRingBuffer<FEdgegapLogLinePtr>& Lines = Stream->GetLines();
+
+	FText Status = FText::Format(LOCTEXT("Status", "{0}: showing {1} of {2} buffered lines, {3} received"),
+		FText::FromString(Stream->GetRequestID()), FilteredLines.Num(), Lines.Num(), FText::AsNumber(Stream->GetNumReceived()));
+
+	if (!Stream->GetLastError().IsEmpty())
+	{
+		Status = FText::Format(LOCTEXT("StatusWithError", "{0}. Last fetch failed: {1}"), Status, FText::FromString(Stream->GetLastError()));
+	}
+
+	return Status;
+}
+
+#undef LOCTEXT_NAMESPACE
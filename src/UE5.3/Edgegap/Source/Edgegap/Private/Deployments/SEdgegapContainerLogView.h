@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Internationalization/Regex.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+#include "EdgegapContainerLogs.h"
+
+class SDockTab;
+
+/** Tails one deployment's container logs, only the visible lines are turned into widgets */
+class SEdgegapContainerLogView : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SEdgegapContainerLogView) { }
+		SLATE_ARGUMENT(FString, RequestID)
+		SLATE_ARGUMENT(FString, API_key)
+	SLATE_END_ARGS()
+
+	static void RegisterTabSpawner();
+	static void UnregisterTabSpawner();
+
+	/** Opens (or brings to front) the container logs tab and points it at a deployment. */
+	static void OpenTab(const FString& RequestID, const FString& API_key);
+
+	void Construct(const FArguments& InArgs);
+	virtual ~SEdgegapContainerLogView();
+
+private:
+	void HandleLinesAdded(const TArray<FEdgegapLogLinePtr>& Added);
+	void HandleFilterChanged(const FText& Text);
+	void RebuildFilteredLines();
+	bool PassesFilter(const FEdgegapLogLine& Line) const;
+
+	TSharedRef<ITableRow> GenerateRow(FEdgegapLogLinePtr Line, const TSharedRef<STableViewBase>& OwnerTable);
+	FText GetStatusText() const;
+
+	TSharedPtr<FEdgegapContainerLogStream> Stream;
+	TSharedPtr<SListView<FEdgegapLogLinePtr>> ListView;
+
+	// Lines of the ring buffer that pass the filter, oldest first
+	TArray<FEdgegapLogLinePtr> FilteredLines;
+
+	TOptional<FRegexPattern> FilterPattern;
+	bool bFollow = true;
+};
@@ -0,0 +1,68 @@
+#include "SEdgegapSparkline.h"
+#include "Rendering/DrawElements.h"
+
+void SEdgegapSparkline::Construct(const FArguments& InArgs)
+{
+	Values = InArgs._Values;
+	MaxValues = FMath::Max(InArgs._MaxValues, 2);
+	DesiredSize = InArgs._DesiredSize;
+	Color = InArgs._Color;
+	GapColor = InArgs._GapColor;
+}
+
+int32 SEdgegapSparkline::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	const TArray<float> Points = Values.Get();
+	if (Points.Num() == 0)
+	{
+		return LayerId;
+	}
+
+	float MaxValue = 0.0f;
+	for (float Value : Points)
+	{
+		MaxValue = FMath::Max(MaxValue, Value);
+	}
+
+	const FVector2D Size = AllottedGeometry.GetLocalSize();
+	const float Step = Size.X / (MaxValues - 1);
+	const int32 First = FMath::Max(Points.Num() - MaxValues, 0);
+
+	// Right aligned, so a short history grows in from the right
+	const float StartX = Size.X - Step * (Points.Num() - First - 1);
+
+	const FLinearColor LineColor = InWidgetStyle.GetColorAndOpacityTint() * Color;
+	const FLinearColor MarkColor = InWidgetStyle.GetColorAndOpacityTint() * GapColor;
+
+	TArray<FVector2D> Line;
+
+	auto FlushLine = [&]()
+	{
+		if (Line.Num() > 1)
+		{
+			FSlateDrawElement::MakeLines(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(), Line, ESlateDrawEffect::None, LineColor, true, 1.0f);
+		}
+
+		Line.Reset();
+	};
+
+	for (int32 Index = First; Index < Points.Num(); ++Index)
+	{
+		const float X = StartX + Step * (Index - First);
+
+		if (Points[Index] < 0.0f)
+		{
+			FlushLine();
+			FSlateDrawElement::MakeLines(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(), { FVector2D(X, 0.0f), FVector2D(X, Size.Y) }, ESlateDrawEffect::None, MarkColor, true, 1.0f);
+			continue;
+		}
+
+		// A little headroom so the highest point isn't drawn on the edge
+		const float Y = MaxValue > 0.0f ? Size.Y - (Points[Index] / (MaxValue * 1.1f)) * Size.Y : Size.Y;
+		Line.Add(FVector2D(X, Y));
+	}
+
+	FlushLine();
+
+	return LayerId;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+
+/** Small line chart of recent values, newest on the right, scaled to the largest value shown */
+class SEdgegapSparkline : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SEdgegapSparkline)
+		: _MaxValues(60)
+		, _DesiredSize(FVector2D(80.0f, 14.0f))
+		, _Color(FLinearColor(0.2f, 0.6f, 1.0f))
+		, _GapColor(FLinearColor(0.9f, 0.2f, 0.1f))
+		{ }
+		// Oldest first, negative values break the line and are marked with GapColor
+		SLATE_ATTRIBUTE(TArray<float>, Values)
+		SLATE_ARGUMENT(int32, MaxValues)
+		SLATE_ARGUMENT(FVector2D, DesiredSize)
+		SLATE_ARGUMENT(FLinearColor, Color)
+		SLATE_ARGUMENT(FLinearColor, GapColor)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+protected:
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override { return DesiredSize; }
+
+private:
+	TAttribute<TArray<float>> Values;
+	int32 MaxValues = 60;
+	FVector2D DesiredSize;
+	FLinearColor Color;
+	FLinearColor GapColor;
+};
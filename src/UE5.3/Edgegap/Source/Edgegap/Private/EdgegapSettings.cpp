@@ -2,8 +2,33 @@
 #include "Settings/ProjectPackagingSettings.h"
 #include "Misc/ConfigCacheIni.h"
 
+FString UEdgegapSettings::SessionApiBaseURL;
+FString UEdgegapSettings::SessionPublicIPLookupURL;
+
 UEdgegapSettings::UEdgegapSettings() {}
 
+FString UEdgegapSettings::GetApiBaseURL()
+{
+	FString BaseURL = SessionApiBaseURL.IsEmpty() ? GetDefault<UEdgegapSettings>()->ApiBaseURL.TrimStartAndEnd() : SessionApiBaseURL;
+	if (BaseURL.IsEmpty())
+	{
+		return TEXT(EDGEGAP_API_URL);
+	}
+
+	if (!BaseURL.EndsWith(TEXT("/")))
+	{
+		BaseURL += TEXT("/");
+	}
+
+	return BaseURL;
+}
+
+void UEdgegapSettings::SetSessionOverride(const FString& InApiBaseURL, const FString& InPublicIPLookupURL)
+{
+	SessionApiBaseURL = InApiBaseURL;
+	SessionPublicIPLookupURL = InPublicIPLookupURL;
+}
+
 #if WITH_EDITOR
 
 UEdgegapSettings::FOnUpdateSettings UEdgegapSettings::OnSettingsChange;
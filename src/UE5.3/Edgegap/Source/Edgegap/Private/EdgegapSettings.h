@@ -6,6 +6,8 @@
 #include "Engine/DeveloperSettings.h"
 #include "EdgegapSettings.generated.h"
 
+#define EDGEGAP_API_URL "https://api.edgegap.com/"
+
 UCLASS(config=EditorPerProjectUserSettings, defaultconfig, meta = (DisplayName = "Edgegap Plugin"))
 class UEdgegapSettings : public UDeveloperSettings
 {
@@ -26,6 +28,22 @@ public:
 	UPROPERTY(Config, EditAnywhere, Category = "API", DisplayName = "API Token")
 	FAPITokenSettings APIToken;
 
+	// Overrides the Edgegap API endpoint, e.g. for a staging environment. Empty uses EDGEGAP_API_URL
+	UPROPERTY(Config, EditAnywhere, Category = "API", AdvancedDisplay, DisplayName = "API Base URL")
+	FString ApiBaseURL;
+
+	/** Where API requests go: the session override, then the API Base URL setting, then EDGEGAP_API_URL. Always ends with a slash. */
+	static FString GetApiBaseURL();
+
+	/**
+	 * Sends API requests and the public IP lookup elsewhere for the rest of the session, without touching the saved
+	 * settings. Set by a local stand-in for the API, such as the mock, and cleared with empty strings.
+	 */
+	static void SetSessionOverride(const FString& InApiBaseURL, const FString& InPublicIPLookupURL);
+
+	/** Empty unless overridden for the session, the public IP cache then uses ipify */
+	static const FString& GetPublicIPLookupURLOverride() { return SessionPublicIPLookupURL; }
+
 	UPROPERTY(Config, EditAnywhere, Category = "Application Info", Meta = (EditCondition = "bIsTokenVerified"), DisplayName = "Application Name")
 	FText ApplicationName;
 
@@ -47,6 +65,65 @@ public:
 	UPROPERTY(Config, EditAnywhere, Category = "Container Registry", Meta = (EditCondition = "bUseCustomContainerRegistry"), DisplayName = "Token")
 	FString PrivateRegistryToken;
 
+	UPROPERTY(Config, EditAnywhere, Category = "Deployments", AdvancedDisplay, DisplayName = "Background Status Polling")
+	bool bEnableStatusPolling = true;
+
+	// Poll interval while any deployment is still on its way to ready
+	UPROPERTY(Config, EditAnywhere, Category = "Deployments", AdvancedDisplay, Meta = (EditCondition = "bEnableStatusPolling", ClampMin = "0.5", Units = "s"))
+	float TransitioningPollInterval = 1.0f;
+
+	// Poll interval while every deployment is ready, stopped or failed
+	UPROPERTY(Config, EditAnywhere, Category = "Deployments", AdvancedDisplay, Meta = (EditCondition = "bEnableStatusPolling", ClampMin = "1.0", Units = "s"))
+	float SteadyPollInterval = 15.0f;
+
+	// Upper bound for the interval while polls keep failing
+	UPROPERTY(Config, EditAnywhere, Category = "Deployments", AdvancedDisplay, Meta = (EditCondition = "bEnableStatusPolling", ClampMin = "1.0", Units = "s"))
+	float MaxPollBackoff = 60.0f;
+
+	// Sent as the deployment's player IP instead of looking up this machine's public IP
+	UPROPERTY(Config, EditAnywhere, Category = "Deployments", AdvancedDisplay, DisplayName = "Public IP Override")
+	FString PublicIPOverride;
+
+	// How long a looked up public IP is reused before it is refreshed in the background
+	UPROPERTY(Config, EditAnywhere, Category = "Deployments", AdvancedDisplay, DisplayName = "Public IP Cache TTL", Meta = (ClampMin = "1", Units = "min"))
+	float PublicIPCacheTTL = 30.0f;
+
+	// Maximum number of deploy requests a batch deploy keeps in flight
+	UPROPERTY(Config, EditAnywhere, Category = "Deployments", AdvancedDisplay, Meta = (ClampMin = "1", ClampMax = "32"))
+	int32 BatchDeployConcurrency = 8;
+
+	// Deployments of a batch that aren't ready after this long are reported as failed
+	UPROPERTY(Config, EditAnywhere, Category = "Deployments", AdvancedDisplay, Meta = (ClampMin = "30", Units = "s"))
+	float BatchReadyTimeout = 600.0f;
+
+	// How long the details of a selected deployment are reused before selecting it again fetches them anew
+	UPROPERTY(Config, EditAnywhere, Category = "Deployments", AdvancedDisplay, Meta = (ClampMin = "0", Units = "s"))
+	float DeploymentDetailsCacheTTL = 10.0f;
+
+	// Internal UDP port the EdgegapServer module answers latency probes on, exposed as "echo" on versions created from here. 0 to not expose it
+	UPROPERTY(Config, EditAnywhere, Category = "Deployments", AdvancedDisplay, Meta = (ClampMin = "0", ClampMax = "65535"))
+	int32 LatencyEchoPort = 7778;
+
+	// How often ready deployments listed in the panel are probed, 0 to turn probing off
+	UPROPERTY(Config, EditAnywhere, Category = "Deployments", AdvancedDisplay, Meta = (ClampMin = "0", Units = "s"))
+	float LatencyProbeInterval = 1.0f;
+
+	// Lines the container log viewer keeps per deployment, older ones are dropped
+	UPROPERTY(Config, EditAnywhere, Category = "Deployments", AdvancedDisplay, Meta = (ClampMin = "100", ClampMax = "1000000"))
+	int32 ContainerLogMaxLines = 20000;
+
+	// How often an open container log viewer fetches new lines
+	UPROPERTY(Config, EditAnywhere, Category = "Deployments", AdvancedDisplay, Meta = (ClampMin = "0.5", Units = "s"))
+	float ContainerLogPollInterval = 2.0f;
+
+	// Clients Deploy and Play starts and connects to the deployment
+	UPROPERTY(Config, EditAnywhere, Category = "Deployments", AdvancedDisplay, Meta = (ClampMin = "1", ClampMax = "8"))
+	int32 PlayClientCount = 1;
+
+	// Deploy and Play starts its clients as separate standalone processes instead of in the editor
+	UPROPERTY(Config, EditAnywhere, Category = "Deployments", AdvancedDisplay)
+	bool bPlayInStandalone = false;
+
 	UPROPERTY(Config)
 	FString Tag;
 
@@ -56,6 +133,10 @@ public:
 	//@TODO: Check the best way to handle verification and toggle edit conditions accordingly
 	UPROPERTY(Config, EditAnywhere)
 	bool bIsTokenVerified = false;
+
+private:
+	static FString SessionApiBaseURL;
+	static FString SessionPublicIPLookupURL;
 };
 
 #if UE_ENABLE_INCLUDE_ORDER_DEPRECATED_IN_5_2
@@ -73,6 +73,9 @@
 #include "Widgets/Text/SInlineEditableTextBlock.h"
 #include "Widgets/Images/SImage.h"
 #include "Widgets/Input/SFilePathPicker.h"
+#include "Widgets/Input/SSpinBox.h"
+#include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Input/SMultiLineEditableTextBox.h"
 #include "GenericPlatform/GenericPlatformFile.h"
 
 #include "IDetailChildrenBuilder.h"
@@ -81,13 +84,25 @@
 #include "DetailCategoryBuilder.h"
 #include "GeneralProjectSettings.h"
 #include "SExternalImageReference.h"
+#include "Deployments/EdgegapDeploymentPoller.h"
+#include "Pipeline/EdgegapPipelineCheckpoint.h"
+#include "Pipeline/EdgegapPipelineReport.h"
+#include "Internationalization/Regex.h"
+#include "Deployments/EdgegapPublicIPCache.h"
+#include "Deployments/EdgegapDeploymentRequests.h"
+#include "Deployments/EdgegapBatchDeploy.h"
+#include "Deployments/EdgegapDeploymentDetails.h"
+#include "Deployments/EdgegapTimeToReadyTracker.h"
+#include "Deployments/EdgegapLatencyProbe.h"
+#include "Deployments/SEdgegapSparkline.h"
+#include "Deployments/SEdgegapContainerLogView.h"
+#include "Deployments/EdgegapStateSnapshot.h"
+#include "Widgets/Input/SSearchBox.h"
 
 DEFINE_LOG_CATEGORY(EdgegapLog);
 
 #define LOCTEXT_NAMESPACE "EdgegapLog"
 
-#define EDGEGAP_API_URL "https://api.edgegap.com/"
-
 class SDeployStatusListItem
 	: public SMultiColumnTableRow< TSharedPtr<struct FDeploymentStatusListItem> >
 {
@@ -117,7 +132,7 @@ public:
 				.VAlign(VAlign_Center)
 				[
 					SNew(SInlineEditableTextBlock)
-					.Text(FText::FromString(Item->DeploymentIP))
+					.Text_Lambda([this]() { return FText::FromString(Item->DeploymentIP); })
 					.Style(FCoreStyle::Get(), "InlineEditableTextBlockSmallStyle")
 					.Cursor(EMouseCursor::TextEditBeam)
 					.Font(IDetailLayoutBuilder::GetDetailFont())
@@ -131,29 +146,115 @@ public:
 				.VAlign(VAlign_Center)
 				[
 					SNew(STextBlock)
-					.Text(FText::FromString(Item->DeploymentStatus))
+					.Text_Lambda([this]() { return FText::FromString(Item->DeploymentStatus); })
 					.Font(IDetailLayoutBuilder::GetDetailFont())
 				];
 		}
-		else if (ColumnName == TEXT("Control"))
+		else if (ColumnName == FEdgegapDeploymentTable::VersionColumn || ColumnName == FEdgegapDeploymentTable::AgeColumn || ColumnName == FEdgegapDeploymentTable::LocationColumn)
 		{
-			bool DeploymentReady = Item->DeploymentReady;
-			return SNew(SBox)
+			return	SNew(SBox)
 				.HeightOverride(20)
 				.Padding(FMargin(3, 0))
 				.VAlign(VAlign_Center)
 				[
-					SNew(SButton)
-					.Text(LOCTEXT("Stop", "Stop"))
-					.IsEnabled(DeploymentReady)
-					.OnClicked_Lambda([this]()
+					SNew(STextBlock)
+					.Text_Lambda([this, ColumnName]()
 					{
-						SetEnabled(false);
+						if (ColumnName == FEdgegapDeploymentTable::VersionColumn)
+						{
+							return FText::FromString(Item->AppVersion);
+						}
 
-						FEdgegapSettingsDetails::GetInstance()->Request_StopDeploy(this->Item->RequestID, this->Item->API_Key);
+						if (ColumnName == FEdgegapDeploymentTable::LocationColumn)
+						{
+							return FText::FromString(Item->Location);
+						}
 
-						return(FReply::Handled());
+						return Item->StartTime.GetTicks() > 0 ? FText::FromString((FDateTime::UtcNow() - Item->StartTime).ToString(TEXT("%h:%m:%s"))) : FText::GetEmpty();
 					})
+					.Font(IDetailLayoutBuilder::GetDetailFont())
+				];
+		}
+		else if (ColumnName == TEXT("Latency"))
+		{
+			return SNew(SBox)
+				.HeightOverride(20)
+				.Padding(FMargin(3, 0))
+				.VAlign(VAlign_Center)
+				[
+					SNew(SHorizontalBox)
+					+ SHorizontalBox::Slot()
+					.AutoWidth()
+					.VAlign(VAlign_Center)
+					[
+						SNew(SEdgegapSparkline)
+						.Values_Lambda([this]()
+						{
+							const FEdgegapLatencyHistory* History = FEdgegapLatencyProbe::Get().Find(Item->RequestID);
+							return History ? History->Samples : TArray<float>();
+						})
+					]
+					+ SHorizontalBox::Slot()
+					.FillWidth(1)
+					.Padding(4, 0, 0, 0)
+					.VAlign(VAlign_Center)
+					[
+						SNew(STextBlock)
+						.Text_Lambda([this]()
+						{
+							const FEdgegapLatencyHistory* History = FEdgegapLatencyProbe::Get().Find(Item->RequestID);
+							return History ? History->ToText() : FText::GetEmpty();
+						})
+						.ToolTipText_Lambda([this]()
+						{
+							return Item->EchoPort > 0
+								? LOCTEXT("Latency_Tooltip", "Round trip time and jitter to the server's echo port, measured from this workstation")
+								: LOCTEXT("Latency_NoEchoTooltip", "This version doesn't expose an echo port, create a new version to measure latency");
+						})
+						.Font(IDetailLayoutBuilder::GetDetailFont())
+					]
+				];
+		}
+		else if (ColumnName == TEXT("Control"))
+		{
+			return SNew(SBox)
+				.HeightOverride(20)
+				.Padding(FMargin(3, 0))
+				.VAlign(VAlign_Center)
+				[
+					SNew(SHorizontalBox)
+					+ SHorizontalBox::Slot()
+					.AutoWidth()
+					[
+						SNew(SButton)
+						.Text(LOCTEXT("Stop", "Stop"))
+						.IsEnabled_Lambda([this]()
+						{
+							// Rows outlive polls now, give a stop that went nowhere a chance to be retried
+							return Item->DeploymentReady && FPlatformTime::Seconds() - StopRequestedTime > 10.0;
+						})
+						.OnClicked_Lambda([this]()
+						{
+							StopRequestedTime = FPlatformTime::Seconds();
+
+							FEdgegapSettingsDetails::GetInstance()->Request_StopDeploy(this->Item->RequestID, this->Item->API_Key);
+
+							return(FReply::Handled());
+						})
+					]
+					+ SHorizontalBox::Slot()
+					.AutoWidth()
+					.Padding(4, 0, 0, 0)
+					[
+						SNew(SButton)
+						.Text(LOCTEXT("Logs", "Logs"))
+						.ToolTipText(LOCTEXT("Logs_Tooltip", "Tail this deployment's container logs in a tab"))
+						.OnClicked_Lambda([this]()
+						{
+							SEdgegapContainerLogView::OpenTab(Item->RequestID, Item->API_Key);
+							return FReply::Handled();
+						})
+					]
 				];
 		}
 
@@ -162,19 +263,14 @@ public:
 
 	TSharedPtr< FDeploymentStatusListItem > Item;
 
-};
+	double StopRequestedTime = -DBL_MAX;
 
-FString FEdgegapSettingsDetails::_ImageName;
-FString FEdgegapSettingsDetails::_RegistryURL;
-FString FEdgegapSettingsDetails::_PrivateUsername;
-FString FEdgegapSettingsDetails::_PrivateToken;
-FString FEdgegapSettingsDetails::_API_key;
-FString FEdgegapSettingsDetails::_AppName;
-FString FEdgegapSettingsDetails::_VersionName;
-FString FEdgegapSettingsDetails::_RecentTag;
+};
 
 TArray< TSharedPtr<FDeploymentStatusListItem > > FEdgegapSettingsDetails::DeployStatusOverrideListSource;
 FEdgegapSettingsDetails* FEdgegapSettingsDetails::Singelton;
+bool FEdgegapSettingsDetails::bStopInFlight = false;
+bool FEdgegapSettingsDetails::bBuildAndPushInFlight = false;
 
 namespace{
 	const TCHAR* GetUATCompilationFlags()
@@ -202,119 +298,140 @@ namespace{
 		return OptionalParams;
 	}
 
-	void OnPackageCallaback(FString res, double num)
+	/** The first match's first group, or the whole match, in the last lines a task printed */
+	FString FindInOutput(const FUcmdResult& Result, const FString& Pattern)
 	{
-		if (res != "Completed")
+		const FRegexPattern RegexPattern(Pattern);
+		for (const FString& Line : Result.OutputTail)
 		{
-			UE_LOG(EdgegapLog, Warning, TEXT("OnPackageCallaback: Could not package, message:%s"), *res);
-			return;
+			FRegexMatcher Matcher(RegexPattern, Line);
+			if (Matcher.FindNext())
+			{
+				return Matcher.GetCaptureGroup(1).IsEmpty() ? Matcher.GetCaptureGroup(0) : Matcher.GetCaptureGroup(1);
+			}
 		}
+		return FString();
+	}
 
-		UProjectPackagingSettings* PackagingSettings = Cast<UProjectPackagingSettings>(UProjectPackagingSettings::StaticClass()->GetDefaultObject());
-		UPlatformsMenuSettings* PlatformsSettings = GetMutableDefault<UPlatformsMenuSettings>();
+	/** The settings a run starts with, so editing them halfway through doesn't mix two configurations in one push */
+	FEdgegapBuildAndPushRun MakeBuildAndPushRun(const FString& Tag)
+	{
+		const UEdgegapSettings* EdgegapSettings = GetDefault<UEdgegapSettings>();
+
+		FEdgegapBuildAndPushRun Run;
+		Run.Tag = Tag;
+		Run.AppName = EdgegapSettings->ApplicationName.ToString();
+		Run.Registry = EdgegapSettings->Registry;
+		Run.ImageRepository = EdgegapSettings->ImageRepository;
+		Run.ImageName = FEdgegapSettingsDetails::MakeImageName(Run.Registry, Run.ImageRepository, Run.AppName, Tag);
+		Run.PrivateRegistryUsername = EdgegapSettings->PrivateRegistryUsername;
+		Run.PrivateRegistryToken = EdgegapSettings->PrivateRegistryToken;
+		Run.APIToken = EdgegapSettings->APIToken.APIToken;
+		Run.LatencyEchoPort = EdgegapSettings->LatencyEchoPort;
+		return Run;
+	}
 
+	/** Builds the image from the staged server, the step after packaging */
+	void ContainerizeStagedBuild(const FEdgegapBuildAndPushRun& Run)
+	{
 		FString PluginDir = IPluginManager::Get().FindPlugin(FString("Edgegap"))->GetBaseDir();
 		FString DockerFilePath = FPaths::Combine(PluginDir, FString("Dockerfile"));
 		FString StartScriptPath = FPaths::Combine(PluginDir, FString("StartServer.sh"));
-		FString ServerBuildPath = PlatformsSettings->StagingDirectory.Path; // PackagingSettings->StagingDirectory.Path;
-		ServerBuildPath = FPaths::Combine(ServerBuildPath, FString("LinuxServer"));
-
-
-		AsyncTask(ENamedThreads::GameThread, [DockerFilePath, StartScriptPath, ServerBuildPath] {
-
-			const UEdgegapSettings* EdgegapSettings = GetDefault<UEdgegapSettings>();
-
-			const FString _Registry = EdgegapSettings->Registry;
-			const FString _ImageRepository = EdgegapSettings->ImageRepository;
-
-			const FString _Tag = FEdgegapSettingsDetails::_RecentTag;
-
-			const FString _PrivateRegistryUsername = EdgegapSettings->PrivateRegistryUsername;
-			const FString _PrivateRegistryToken = EdgegapSettings->PrivateRegistryToken;
-
-			FEdgegapSettingsDetails::Containerize(DockerFilePath, StartScriptPath, ServerBuildPath, _Registry, _ImageRepository, _Tag, _PrivateRegistryUsername, _PrivateRegistryToken);
-		});
 
+		FEdgegapSettingsDetails::Containerize(Run, DockerFilePath, StartScriptPath);
 	}
 
-	void OnDockerLoginCallback(FString res, double num)
+	void OnPackageCallaback(const FEdgegapBuildAndPushRun& Run, const FUcmdResult& Result)
 	{
-		if (res != "Completed")
+		FEdgegapPipelineReport::Get().AddStage(TEXT("Package"), Result);
+		if (!Result.Succeeded())
 		{
-			UE_LOG(EdgegapLog, Warning, TEXT("OnDockerLoginCallback: Could not login, message:%s"), *res);
+			UE_LOG(EdgegapLog, Warning, TEXT("OnPackageCallaback: Could not package, message:%s, exit code %d, output saved to %s"), LexToString(Result.Result), Result.ExitCode, *Result.LogPath);
+			FEdgegapSettingsDetails::bBuildAndPushInFlight = false;
+			FEdgegapPipelineReport::Get().Finish(LexToString(Result.Result));
 			return;
 		}
-		const UEdgegapSettings* EdgegapSettings = GetDefault<UEdgegapSettings>();
-
 
-		const FString _Registry = EdgegapSettings->Registry;
-		const FString _ImageRepository = EdgegapSettings->ImageRepository;
+		FEdgegapPipelineCheckpoint::Get().CompletePackage(Run.StagedPath);
 
-		const FString _Tag = FEdgegapSettingsDetails::_RecentTag;
-
-		const FString _PrivateRegistryUsername = EdgegapSettings->PrivateRegistryUsername;
-		const FString _PrivateRegistryToken = EdgegapSettings->PrivateRegistryToken;
+		ContainerizeStagedBuild(Run);
+	}
 
-		const FString _AppName = EdgegapSettings->ApplicationName.ToString();
-		FString ImageName = FEdgegapSettingsDetails::MakeImageName(_Registry, _ImageRepository, _AppName, _Tag);
+	void OnDockerLoginCallback(const FEdgegapBuildAndPushRun& Run, const FUcmdResult& Result)
+	{
+		FEdgegapPipelineReport::Get().AddStage(TEXT("Docker Login"), Result);
+		if (!Result.Succeeded())
+		{
+			UE_LOG(EdgegapLog, Warning, TEXT("OnDockerLoginCallback: Could not login, message:%s, exit code %d, output saved to %s"), LexToString(Result.Result), Result.ExitCode, *Result.LogPath);
+			FEdgegapSettingsDetails::bBuildAndPushInFlight = false;
+			FEdgegapPipelineReport::Get().Finish(LexToString(Result.Result));
+			return;
+		}
 
-		AsyncTask(ENamedThreads::GameThread, [_Registry, _PrivateRegistryUsername, _PrivateRegistryToken, ImageName] {FEdgegapSettingsDetails::PushContainer(ImageName, _Registry, _PrivateRegistryUsername, _PrivateRegistryToken, true); });
+		FEdgegapSettingsDetails::PushContainer(Run, true);
 	}
 
-	void OnContainerizeCallback(FString res, double num)
+	void OnContainerizeCallback(const FEdgegapBuildAndPushRun& Run, const FUcmdResult& Result)
 	{
-		if (res != "Completed")
+		FEdgegapPipelineReport::Get().AddStage(TEXT("Containerize"), Result);
+		if (!Result.Succeeded())
 		{
-			UE_LOG(EdgegapLog, Warning, TEXT("OnContainerizeCallback: Could not generate container, message:%s"), *res);
+			UE_LOG(EdgegapLog, Warning, TEXT("OnContainerizeCallback: Could not generate container, message:%s, exit code %d, output saved to %s"), LexToString(Result.Result), Result.ExitCode, *Result.LogPath);
+			FEdgegapSettingsDetails::bBuildAndPushInFlight = false;
+			FEdgegapPipelineReport::Get().Finish(LexToString(Result.Result));
 			return;
 		}
 
-		const UEdgegapSettings* EdgegapSettings = GetDefault<UEdgegapSettings>();
+		// Written by docker build --iidfile, so a resumed push can tell whether the image is still the one built
+		FString ImageID;
+		FFileHelper::LoadFileToString(ImageID, *FEdgegapPipelineCheckpoint::GetImageIDFilePath());
+		FEdgegapPipelineCheckpoint::Get().CompleteContainerize(Run.ImageName, ImageID.TrimStartAndEnd());
 
-		const FString _Registry = EdgegapSettings->Registry;
-		const FString _ImageRepository = EdgegapSettings->ImageRepository;
+		FEdgegapSettingsDetails::PushContainer(Run);
+	}	
 
-		const FString _Tag = FEdgegapSettingsDetails::_RecentTag;
+	/** Pushes the image a resumed run built before, if docker still has it under the same name */
+	void OnVerifyImageCallback(const FEdgegapBuildAndPushRun& Run, const FUcmdResult& Result)
+	{
+		const FEdgegapPipelineCheckpoint& Checkpoint = FEdgegapPipelineCheckpoint::Get();
 
-		const FString _PrivateRegistryUsername = EdgegapSettings->PrivateRegistryUsername;
-		const FString _PrivateRegistryToken = EdgegapSettings->PrivateRegistryToken;
+		const FString ImageID = Result.Succeeded() ? FindInOutput(Result, TEXT("sha256:[0-9a-f]{64}")) : FString();
+		if (ImageID != Checkpoint.GetImageID())
+		{
+			UE_LOG(EdgegapLog, Warning, TEXT("OnVerifyImageCallback: %s is no longer the image built as %s, found '%s', output saved to %s"), *Checkpoint.GetImageName(), *Checkpoint.GetImageID(), *ImageID, *Result.LogPath);
+			FEdgegapPipelineReport::Get().Finish(TEXT("Failed"));
+			FEdgegapSettingsDetails::bBuildAndPushInFlight = false;
 
-		const FString _AppName = EdgegapSettings->ApplicationName.ToString();
-		FString ImageName = FEdgegapSettingsDetails::MakeImageName(_Registry, _ImageRepository, _AppName, _Tag);
+			FNotificationInfo* Info = new FNotificationInfo(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
+			Info->ExpireDuration = 3.0f;
+			FSlateNotificationManager::Get().QueueNotification(Info);
+			return;
+		}
 
-		AsyncTask(ENamedThreads::GameThread, [_Registry, _PrivateRegistryUsername, _PrivateRegistryToken, ImageName] {FEdgegapSettingsDetails::PushContainer(ImageName, _Registry, _PrivateRegistryUsername, _PrivateRegistryToken); });
-	}	
+		FEdgegapSettingsDetails::PushContainer(Run);
+	}
 	
-	void OnPushContainerCallback(FString res, double num)
+	void OnPushContainerCallback(const FEdgegapBuildAndPushRun& Run, const FUcmdResult& Result)
 	{
-		if (res != "Completed")
+		FEdgegapPipelineReport::Get().AddStage(TEXT("Push"), Result);
+		if (!Result.Succeeded())
 		{
-			UE_LOG(EdgegapLog, Warning, TEXT("OnPushContainerCallback: Could not push container, message:%s"), *res);
+			UE_LOG(EdgegapLog, Warning, TEXT("OnPushContainerCallback: Could not push container, message:%s, exit code %d, output saved to %s"), LexToString(Result.Result), Result.ExitCode, *Result.LogPath);
+			FEdgegapSettingsDetails::bBuildAndPushInFlight = false;
+			FEdgegapPipelineReport::Get().Finish(LexToString(Result.Result));
 			return;
 		}
 
-		const FString _TargetTag = FEdgegapSettingsDetails::_RecentTag;
-
-		const UEdgegapSettings* EdgegapSettings = GetDefault<UEdgegapSettings>();
-
-		const FText _AppName = EdgegapSettings->ApplicationName;
-		// Making the container tag name and version name match
-		const FString _VersionName = _TargetTag;
-		const FString _APIToken = EdgegapSettings->APIToken.APIToken;
-
-		const FString _Registry = EdgegapSettings->Registry;
-		const FString _ImageRepository = EdgegapSettings->ImageRepository;
+		// "<tag>: digest: sha256:... size: 1234", the last thing docker push prints
+		FEdgegapPipelineCheckpoint::Get().CompletePush(FindInOutput(Result, TEXT("digest: (sha256:[0-9a-f]{64})")));
 
-		const FString _Tag = _TargetTag;
-
-		const FString _PrivateRegistryUsername = EdgegapSettings->PrivateRegistryUsername;
-		const FString _PrivateRegistryToken = EdgegapSettings->PrivateRegistryToken;
+		FEdgegapPipelineReport::Get().Finish(LexToString(Result.Result));
 
 		FNotificationInfo* Info = new FNotificationInfo(LOCTEXT("OperationSuccess", "Build and Push completed successfully"));
 		Info->ExpireDuration = 3.0f;
 		FSlateNotificationManager::Get().QueueNotification(Info);
 
-		FEdgegapSettingsDetails::CreateVersion(_AppName.ToString(), _VersionName, _APIToken, _Registry, _ImageRepository, _Tag, _PrivateRegistryUsername, _PrivateRegistryToken);
+		FEdgegapSettingsDetails::CreateVersion(Run);
 	}
 
 	FString GetProjectPathForTurnkey()
@@ -504,6 +621,19 @@ TSharedRef<IDetailCustomization> FEdgegapSettingsDetails::MakeInstance()
 	return obj;
 }
 
+FEdgegapSettingsDetails::~FEdgegapSettingsDetails()
+{
+	FEdgegapDeploymentPoller::Get().RemoveWatcher(this);
+	FEdgegapDeploymentPoller::Get().OnDeploymentsUpdated().RemoveAll(this);
+	FEdgegapDeploymentPoller::Get().OnDeploymentsRestored().RemoveAll(this);
+	FEdgegapLatencyProbe::Get().RemoveWatcher(this);
+
+	if (Singelton == this)
+	{
+		Singelton = nullptr;
+	}
+}
+
 FSlateBrush* FEdgegapSettingsDetails::LoadImage(const FString& InImagePath)
 {
 	if (SavedImageBrush.IsValid())
@@ -556,8 +686,8 @@ void FEdgegapSettingsDetails::CustomizeDetails(IDetailLayoutBuilder& DetailBuild
 	TSharedPtr<IPropertyHandle> IsTokenVerifiedProperty = DetailBuilder.GetProperty(GET_MEMBER_NAME_CHECKED(UEdgegapSettings, bIsTokenVerified));
 	DetailBuilder.HideProperty(IsTokenVerifiedProperty);
 
-	bool _bIsTokenVerified = false;
-	IsTokenVerifiedProperty->SetValue(false);
+	// Last known state until Request_VerifyToken below answers
+	IsTokenVerifiedProperty->SetValue(FEdgegapStateSnapshot::Get().IsTokenVerified());
 
 	// Image Banner
 
@@ -711,7 +841,7 @@ void FEdgegapSettingsDetails::CustomizeDetails(IDetailLayoutBuilder& DetailBuild
 				PrivateRegistryUsernameProperty->GetValue(PrivateRegistryUsernameStr);
 				PrivateRegistryTokenProperty->GetValue(PrivateRegistryTokenStr);
 
-				const bool bIsClickable = !RegistryStr.IsEmpty() && !ImageRepositoryStr.IsEmpty() && !PrivateRegistryUsernameStr.IsEmpty() && !PrivateRegistryTokenStr.IsEmpty();
+				const bool bIsClickable = !bBuildAndPushInFlight && !RegistryStr.IsEmpty() && !ImageRepositoryStr.IsEmpty() && !PrivateRegistryUsernameStr.IsEmpty() && !PrivateRegistryTokenStr.IsEmpty();
 
 				return bIsClickable;
  			})
@@ -721,6 +851,22 @@ void FEdgegapSettingsDetails::CustomizeDetails(IDetailLayoutBuilder& DetailBuild
 			}))
 		];
 
+	CreateBuildAndPushBtn_HB->AddSlot()
+		.AutoWidth()
+		.VAlign(VAlign_Center)
+		.HAlign(HAlign_Right)
+		.Padding(2.f)
+		[
+			SNew(SButton)
+			.Text(LOCTEXT("ResumeBuildAndPush", "Resume"))
+			.ToolTipText_Lambda([]() { return FEdgegapPipelineCheckpoint::Get().DescribeResume(); })
+			.IsEnabled_Lambda([]() { return !bBuildAndPushInFlight && FEdgegapPipelineCheckpoint::Get().CanResume(); })
+			.OnClicked(FOnClicked::CreateLambda([]() {
+				ResumeBuildAndPush();
+				return FReply::Handled();
+			}))
+		];
+
 	// The button should be always visible, and this category persists its collapse state, so moving it to the Application Info category
 	// Update: We still want it in ContainerRegistryCategory but open up the category on click
 	// ApplicationInfoCategory
@@ -775,15 +921,239 @@ void FEdgegapSettingsDetails::CustomizeDetails(IDetailLayoutBuilder& DetailBuild
 				return(FReply::Handled());
 			})
 		]
+	+ SHorizontalBox::Slot()
+		.Padding(2)
+		.AutoWidth()
+		[
+			SAssignNew(StopSelected_SBtn, SButton)
+			.Text(LOCTEXT("StopSelected", "Stop Selected"))
+		.IsEnabled_Lambda([this]()
+			{
+				return !bStopInFlight && DeploymentStatusListItemListView.IsValid() && DeploymentStatusListItemListView->GetNumItemsSelected() > 0;
+			})
+		.OnClicked_Lambda([this, APITokenStrProperty]()
+			{
+				FString APITokenStr;
+				APITokenStrProperty->GetValue(APITokenStr);
+
+				TArray<FString> RequestIDs;
+				for (const TSharedPtr<FDeploymentStatusListItem>& Item : DeploymentStatusListItemListView->GetSelectedItems())
+				{
+					RequestIDs.Add(Item->RequestID);
+				}
+
+				DeploymentStatusListItemListView->ClearSelection();
+				Request_StopDeployments(RequestIDs, APITokenStr);
+				return(FReply::Handled());
+			})
+		]
+	+ SHorizontalBox::Slot()
+		.Padding(2)
+		.AutoWidth()
+		[
+			SAssignNew(StopAll_SBtn, SButton)
+			.Text(LOCTEXT("StopAll", "Stop All"))
+		.ToolTipText(LOCTEXT("StopAll_Tooltip", "Stops every listed deployment of this application version, or of any version when no version was pushed yet"))
+		.IsEnabled_Lambda([]()
+			{
+				return !bStopInFlight;
+			})
+		.OnClicked_Lambda([this, ApplicationNameProperty, VersionNameProperty, APITokenStrProperty]()
+			{
+				FText AppNameTxt;
+				FString APITokenStr;
+				FString VersionNameStr;
+				ApplicationNameProperty->GetValue(AppNameTxt);
+				APITokenStrProperty->GetValue(APITokenStr);
+				VersionNameProperty->GetValue(VersionNameStr);
+
+				const FString AppNameStr = AppNameTxt.ToString();
+
+				// Deployments that don't report their app or version are assumed to be ours, the list is per token
+				TArray<FString> RequestIDs;
+				for (const TSharedPtr<FDeploymentStatusListItem>& Item : DeployStatusOverrideListSource)
+				{
+					const bool bAppMatches = Item->AppName.IsEmpty() || Item->AppName == AppNameStr;
+					const bool bVersionMatches = Item->AppVersion.IsEmpty() || VersionNameStr.IsEmpty() || Item->AppVersion == VersionNameStr;
+
+					if (bAppMatches && bVersionMatches && Item->DeploymentStatus != TEXT("Status.TERMINATED"))
+					{
+						RequestIDs.Add(Item->RequestID);
+					}
+				}
+
+				Request_StopDeployments(RequestIDs, APITokenStr);
+				return(FReply::Handled());
+			})
+		]
+		];
+
+	DepStatusCategory.AddCustomRow(LOCTEXT("BatchDeploy", "Batch Deploy"))
+		.NameContent()
+		[
+			SNew(STextBlock)
+			.Text(LOCTEXT("BatchDeploy", "Batch Deploy"))
+		.Font(IDetailLayoutBuilder::GetDetailFont())
+		]
+	.ValueContent()
+		.MinDesiredWidth(300.0f)
+		[
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(2)
+		[
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+		.Padding(2)
+		.AutoWidth()
+		[
+			SNew(SBox)
+			.WidthOverride(80.0f)
+		[
+			SNew(SSpinBox<int32>)
+			.MinValue(1)
+		.MaxValue(500)
+		.Value_Lambda([this]() { return BatchDeployCount; })
+		.OnValueChanged_Lambda([this](int32 NewValue) { BatchDeployCount = NewValue; })
+		.ToolTipText(LOCTEXT("BatchDeployCount_Tooltip", "Number of deployments to create"))
+		]
+		]
+	+ SHorizontalBox::Slot()
+		.Padding(2)
+		.AutoWidth()
+		[
+			SNew(SBox)
+			.WidthOverride(120.0f)
+		[
+			SAssignNew(BatchDeployVersion_STextBox, SEditableTextBox)
+			.Font(IDetailLayoutBuilder::GetDetailFont())
+		.HintText(LOCTEXT("BatchDeployVersion_Hint", "Latest version"))
+		.ToolTipText(LOCTEXT("BatchDeployVersion_Tooltip", "Version to deploy, empty for the last one built and pushed"))
+		]
+		]
+	+ SHorizontalBox::Slot()
+		.Padding(2)
+		.AutoWidth()
+		[
+			SAssignNew(BatchDeploy_SBtn, SButton)
+			.Text(LOCTEXT("DeployBatch", "Deploy Batch"))
+		.IsEnabled_Lambda([]()
+			{
+				TSharedPtr<FEdgegapBatchDeploy> Batch = FEdgegapBatchDeploy::GetLatest();
+				return !Batch.IsValid() || Batch->IsFinished();
+			})
+		.OnClicked_Lambda([this, ApplicationNameProperty, VersionNameProperty, APITokenStrProperty]()
+			{
+				FText AppNameTxt;
+				FString APITokenStr;
+				FString VersionNameStr;
+				ApplicationNameProperty->GetValue(AppNameTxt);
+				APITokenStrProperty->GetValue(APITokenStr);
+				VersionNameProperty->GetValue(VersionNameStr);
+
+				if (!BatchDeployVersion_STextBox->GetText().IsEmptyOrWhitespace())
+				{
+					VersionNameStr = BatchDeployVersion_STextBox->GetText().ToString().TrimStartAndEnd();
+				}
+
+				// One player IP per line, or none to use our own
+				TArray<FString> PlayerIPs;
+				BatchDeployIPs_STextBox->GetText().ToString().ParseIntoArrayLines(PlayerIPs);
+				for (FString& IP : PlayerIPs)
+				{
+					IP.TrimStartAndEndInline();
+				}
+				PlayerIPs.RemoveAll([](const FString& IP) { return IP.IsEmpty(); });
+
+				FEdgegapBatchDeploy::Start(AppNameTxt.ToString(), VersionNameStr, APITokenStr, BatchDeployCount, PlayerIPs);
+				return(FReply::Handled());
+			})
+		]
+	+ SHorizontalBox::Slot()
+		.Padding(2)
+		.AutoWidth()
+		[
+			SNew(SButton)
+			.Text(LOCTEXT("CancelBatch", "Cancel Batch"))
+		.ToolTipText(LOCTEXT("CancelBatch_Tooltip", "Stops sending deploys and stops the batch's deployments that aren't ready yet"))
+		.IsEnabled_Lambda([]()
+			{
+				TSharedPtr<FEdgegapBatchDeploy> Batch = FEdgegapBatchDeploy::GetLatest();
+				return Batch.IsValid() && !Batch->IsFinished();
+			})
+		.OnClicked_Lambda([]()
+			{
+				if (TSharedPtr<FEdgegapBatchDeploy> Batch = FEdgegapBatchDeploy::GetLatest())
+				{
+					Batch->Cancel();
+				}
+				return(FReply::Handled());
+			})
+		]
+	+ SHorizontalBox::Slot()
+		.Padding(6, 2)
+		.VAlign(VAlign_Center)
+		[
+			SNew(STextBlock)
+			.Font(IDetailLayoutBuilder::GetDetailFont())
+		.Text_Lambda([]()
+			{
+				TSharedPtr<FEdgegapBatchDeploy> Batch = FEdgegapBatchDeploy::GetLatest();
+				return Batch.IsValid() ? Batch->GetSummary() : FText::GetEmpty();
+			})
+		]
+		]
+	+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(2)
+		[
+			SNew(SBox)
+			.MaxDesiredHeight(80.0f)
+		[
+			SAssignNew(BatchDeployIPs_STextBox, SMultiLineEditableTextBox)
+			.Font(IDetailLayoutBuilder::GetDetailFont())
+		.HintText(LOCTEXT("BatchDeployIPs_Hint", "Player IPs, one per line (optional, spread round-robin)"))
+		]
+		]
+		];
+
+	DepStatusCategory.AddCustomRow(LOCTEXT("FilterDeployments", "Filter Deployments"))
+		[
+			SNew(SSearchBox)
+			.HintText(LOCTEXT("FilterDeployments_Hint", "Filter by request ID, status, version, location or address"))
+		.OnTextChanged_Lambda([this](const FText& Text)
+		{
+			DeploymentTable.SetFilter(Text.ToString());
+			RefreshDeploymentView();
+		})
+		];
+
+	DepStatusCategory.AddCustomRow(LOCTEXT("RestoredDeployments", "Restored Deployments"))
+		.Visibility(TAttribute<EVisibility>::CreateLambda([]()
+		{
+			return FEdgegapDeploymentPoller::Get().IsRestored() ? EVisibility::Visible : EVisibility::Collapsed;
+		}))
+		[
+			SNew(STextBlock)
+			.Font(IDetailLayoutBuilder::GetDetailFont())
+		.ColorAndOpacity(FSlateColor::UseSubduedForeground())
+		.Text_Lambda([]()
+		{
+			const FTimespan Age = FDateTime::UtcNow() - FEdgegapDeploymentPoller::Get().GetRestoredTime();
+			return FText::Format(LOCTEXT("RestoredDeployments_Text", "Last known list from {0} ago, refreshing..."),
+				FText::FromString(Age.ToString(Age.GetDays() > 0 ? TEXT("%dd %h:%m:%s") : TEXT("%h:%m:%s"))));
+		})
 		];
 
 	DepStatusCategory.AddCustomRow(LOCTEXT("CurrentDeployments", "Current Deployments"))
 		[
 			SAssignNew(DeploymentStatusListItemListView, SDeploymentStatusListItemListView)
 			.ItemHeight(20.0f)
-		.ListItemsSource(&DeployStatusOverrideListSource)
+		.ListItemsSource(&DeploymentTable.GetView())
 		.OnGenerateRow(this, &FEdgegapSettingsDetails::HandleGenerateDeployStatusWidget)
-		.SelectionMode(ESelectionMode::None)
+		.OnSelectionChanged(this, &FEdgegapSettingsDetails::HandleDeploymentSelectionChanged)
+		.SelectionMode(ESelectionMode::Multi)
 		.HeaderRow(
 			SNew(SHeaderRow)
 			+ SHeaderRow::Column("URL")
@@ -802,44 +1172,143 @@ void FEdgegapSettingsDetails::CustomizeDetails(IDetailLayoutBuilder& DetailBuild
 			.Font(IDetailLayoutBuilder::GetDetailFont())
 			]
 			]
-	+ SHeaderRow::Column("Status")
+	+ SHeaderRow::Column(FEdgegapDeploymentTable::StatusColumn)
 		.HAlignCell(HAlign_Left)
 		.FillWidth(1)
 		.HeaderContentPadding(FMargin(4))
+		.SortMode_Lambda([this]() { return DeploymentTable.GetSortMode(FEdgegapDeploymentTable::StatusColumn); })
+		.OnSort(this, &FEdgegapSettingsDetails::HandleDeploymentSortChanged)
 		[
 			SNew(STextBlock)
 			.Text(LOCTEXT("CurrentDeployments_Status", "Status"))
 		.Font(IDetailLayoutBuilder::GetDetailFont())
 		]
-	+ SHeaderRow::Column("Control")
+	+ SHeaderRow::Column(FEdgegapDeploymentTable::VersionColumn)
 		.HAlignCell(HAlign_Left)
-		.FillWidth(1)
+		.FillWidth(0.6)
 		.HeaderContentPadding(FMargin(4))
+		.SortMode_Lambda([this]() { return DeploymentTable.GetSortMode(FEdgegapDeploymentTable::VersionColumn); })
+		.OnSort(this, &FEdgegapSettingsDetails::HandleDeploymentSortChanged)
 		[
 			SNew(STextBlock)
-			.Text(LOCTEXT("CurrentDeployments_Control", "Control"))
+			.Text(LOCTEXT("CurrentDeployments_Version", "Version"))
 		.Font(IDetailLayoutBuilder::GetDetailFont())
 		]
-	)
-		];
-
-	// --- Ad
-
-	IDetailCategoryBuilder& AdCategoryBuilder = DetailBuilder.EditCategory("Edgegap");
-
-	AdCategoryBuilder.AddCustomRow(LOCTEXT("Edgegap", "Edgegap"))
-	[
-		SNew(SHorizontalBox)
-		+ SHorizontalBox::Slot()
+	+ SHeaderRow::Column(FEdgegapDeploymentTable::AgeColumn)
+		.HAlignCell(HAlign_Left)
+		.FillWidth(0.5)
+		.HeaderContentPadding(FMargin(4))
+		.SortMode_Lambda([this]() { return DeploymentTable.GetSortMode(FEdgegapDeploymentTable::AgeColumn); })
+		.OnSort(this, &FEdgegapSettingsDetails::HandleDeploymentSortChanged)
 		[
-			SNew(SVerticalBox)
-			+ SVerticalBox::Slot()
-				.AutoHeight()
-				.HAlign(HAlign_Center)
-				.Padding(10.f)
-				[
-					SNew(SHorizontalBox)
-					+ SHorizontalBox::Slot()
+			SNew(STextBlock)
+			.Text(LOCTEXT("CurrentDeployments_Age", "Age"))
+		.Font(IDetailLayoutBuilder::GetDetailFont())
+		]
+	+ SHeaderRow::Column(FEdgegapDeploymentTable::LocationColumn)
+		.HAlignCell(HAlign_Left)
+		.FillWidth(0.8)
+		.HeaderContentPadding(FMargin(4))
+		.SortMode_Lambda([this]() { return DeploymentTable.GetSortMode(FEdgegapDeploymentTable::LocationColumn); })
+		.OnSort(this, &FEdgegapSettingsDetails::HandleDeploymentSortChanged)
+		[
+			SNew(STextBlock)
+			.Text(LOCTEXT("CurrentDeployments_Location", "Location"))
+		.Font(IDetailLayoutBuilder::GetDetailFont())
+		]
+	+ SHeaderRow::Column(FEdgegapDeploymentTable::LatencyColumn)
+		.HAlignCell(HAlign_Left)
+		.FillWidth(1)
+		.HeaderContentPadding(FMargin(4))
+		.SortMode_Lambda([this]() { return DeploymentTable.GetSortMode(FEdgegapDeploymentTable::LatencyColumn); })
+		.OnSort(this, &FEdgegapSettingsDetails::HandleDeploymentSortChanged)
+		[
+			SNew(STextBlock)
+			.Text(LOCTEXT("CurrentDeployments_Latency", "Latency"))
+		.Font(IDetailLayoutBuilder::GetDetailFont())
+		]
+	+ SHeaderRow::Column("Control")
+		.HAlignCell(HAlign_Left)
+		.FillWidth(1)
+		.HeaderContentPadding(FMargin(4))
+		[
+			SNew(STextBlock)
+			.Text(LOCTEXT("CurrentDeployments_Control", "Control"))
+		.Font(IDetailLayoutBuilder::GetDetailFont())
+		]
+	)
+		];
+
+	// Filled in on selection only, the list itself never fetches more than v1/deployments
+	DepStatusCategory.AddCustomRow(LOCTEXT("DeploymentDetails", "Deployment Details"))
+		.Visibility(TAttribute<EVisibility>::CreateLambda([this]()
+		{
+			return SelectedDeploymentRequestID.IsEmpty() ? EVisibility::Collapsed : EVisibility::Visible;
+		}))
+		[
+			SNew(SBox)
+			.Padding(FMargin(4))
+		[
+			SNew(STextBlock)
+			.Text_Lambda([this]() { return SelectedDeploymentDetailsText; })
+		.Font(IDetailLayoutBuilder::GetDetailFont())
+		.AutoWrapText(true)
+		]
+		];
+
+	DepStatusCategory.AddCustomRow(LOCTEXT("TimeToReady", "Time to Ready"))
+		.NameContent()
+		[
+			SNew(STextBlock)
+			.Text(LOCTEXT("TimeToReady", "Time to Ready"))
+		.ToolTipText(LOCTEXT("TimeToReady_Tooltip", "Time from deploy request to ready for deployments started from this editor, per version. Kept in Saved/Edgegap/TimeToReady.json."))
+		.Font(IDetailLayoutBuilder::GetDetailFont())
+		]
+	.ValueContent()
+		.MinDesiredWidth(400)
+		[
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+		.FillWidth(1)
+		.VAlign(VAlign_Center)
+		[
+			SNew(STextBlock)
+			.Text_Lambda([]() { return FEdgegapTimeToReadyTracker::Get().GetSummary(); })
+		.Font(IDetailLayoutBuilder::GetDetailFont())
+		.AutoWrapText(true)
+		]
+	+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.Padding(4, 0, 0, 0)
+		.VAlign(VAlign_Center)
+		[
+			SNew(SButton)
+			.Text(LOCTEXT("TimeToReady_Clear", "Clear"))
+		.OnClicked_Lambda([]()
+		{
+			FEdgegapTimeToReadyTracker::Get().ClearHistory();
+			return FReply::Handled();
+		})
+		]
+		];
+
+	// --- Ad
+
+	IDetailCategoryBuilder& AdCategoryBuilder = DetailBuilder.EditCategory("Edgegap");
+
+	AdCategoryBuilder.AddCustomRow(LOCTEXT("Edgegap", "Edgegap"))
+	[
+		SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot()
+		[
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot()
+				.AutoHeight()
+				.HAlign(HAlign_Center)
+				.Padding(10.f)
+				[
+					SNew(SHorizontalBox)
+					+ SHorizontalBox::Slot()
 						.AutoWidth()
 						.VAlign(VAlign_Bottom)
 						[
@@ -887,6 +1356,21 @@ void FEdgegapSettingsDetails::CustomizeDetails(IDetailLayoutBuilder& DetailBuild
 
 	// Get Defaults
 
+	FEdgegapDeploymentPoller& DeploymentPoller = FEdgegapDeploymentPoller::Get();
+	DeploymentPoller.OnDeploymentsUpdated().AddSP(this, &FEdgegapSettingsDetails::HandleDeploymentsUpdated);
+	DeploymentPoller.OnDeploymentsRestored().AddSP(this, &FEdgegapSettingsDetails::HandleDeploymentsRestored);
+	DeploymentPoller.AddWatcher(this, [this]() -> bool
+	{
+		return DeploymentStatusListItemListView.IsValid() && DeploymentStatusListItemListView->IsShowing();
+	});
+	FEdgegapLatencyProbe::Get().AddWatcher(this, [this]() -> bool
+	{
+		return DeploymentStatusListItemListView.IsValid() && DeploymentStatusListItemListView->IsShowing();
+	});
+
+	// Shows what the poller already has (from this session or the snapshot of the last one) while the refresh is out
+	HandleDeploymentsUpdated(DeploymentPoller.GetDeployments());
+
 	FString APITokenStr;
 	APITokenStrProperty->GetValue(APITokenStr);
 	Request_GetDeploymentsInfo(APITokenStr, nullptr);
@@ -937,6 +1421,17 @@ void FEdgegapSettingsDetails::SaveAll()
 
 void FEdgegapSettingsDetails::PackageProject(const FName IniPlatformName)
 {
+	// A second run would take over the tag and the checkpoint of the first, and the first would end the second's in flight state
+	if (bBuildAndPushInFlight)
+	{
+		UE_LOG(EdgegapLog, Warning, TEXT("PackageProject: A Build and Push run is still in progress"));
+
+		FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
+		Info.ExpireDuration = 3.0f;
+		FSlateNotificationManager::Get().AddNotification(Info);
+		return;
+	}
+
 	// Handle Build and Push button
 	const UGeneralProjectSettings& ProjectSettings = *GetDefault<UGeneralProjectSettings>();
 	UProjectPackagingSettings* PackagingSettings = GetMutableDefault<UProjectPackagingSettings>();
@@ -946,8 +1441,6 @@ void FEdgegapSettingsDetails::PackageProject(const FName IniPlatformName)
 	FDateTime Now = FDateTime::Now();
 	FString FormattedTime = FDateTime::Now().ToString(TEXT("%Y-%m-%d_%H-%M"));
 
-	_RecentTag = FormattedTime;
-
 	// get a in-memory defaults which will have the user-settings, like the per-platform config/target platform stuff
 	UProjectPackagingSettings* AllPlatformPackagingSettings = GetMutableDefault<UProjectPackagingSettings>();
 	UPlatformsMenuSettings* PlatformsSettings = GetMutableDefault<UPlatformsMenuSettings>();
@@ -997,7 +1490,7 @@ void FEdgegapSettingsDetails::PackageProject(const FName IniPlatformName)
 	// set locations to engine and project
 	if (!ProjectPath.IsEmpty())
 	{
-		BuildCookRunParams += FString::Printf(TEXT(" -project=\"%s\""), *ProjectPath);
+		BuildCookRunParams += FString::Printf(TEXT(" -project=%s"), *FUcmdCommand::QuoteArgument(ProjectPath));
 	}
 
 	bool bIsProjectBuildTarget = false;
@@ -1102,14 +1595,14 @@ void FEdgegapSettingsDetails::PackageProject(const FName IniPlatformName)
 
 		if (!PackagingSettings->ApplocalPrerequisitesDirectory.Path.IsEmpty())
 		{
-			BuildCookRunParams += FString::Printf(TEXT(" -applocaldirectory=\"%s\""), *(PackagingSettings->ApplocalPrerequisitesDirectory.Path));
+			BuildCookRunParams += FString::Printf(TEXT(" -applocaldirectory=%s"), *FUcmdCommand::QuoteArgument(PackagingSettings->ApplocalPrerequisitesDirectory.Path));
 		}
 		else if (PackagingSettings->IncludeAppLocalPrerequisites)
 		{
 			BuildCookRunParams += TEXT(" -applocaldirectory=\"$(EngineDir)/Binaries/ThirdParty/AppLocalDependencies\"");
 		}
 
-		BuildCookRunParams += FString::Printf(TEXT(" -archivedirectory=\"%s\""), *PlatformsSettings->StagingDirectory.Path);
+		BuildCookRunParams += FString::Printf(TEXT(" -archivedirectory=%s"), *FUcmdCommand::QuoteArgument(PlatformsSettings->StagingDirectory.Path));
 
 		if (PackagingSettings->ForDistribution)
 		{
@@ -1129,7 +1622,7 @@ void FEdgegapSettingsDetails::PackageProject(const FName IniPlatformName)
 
 		if (PackagingSettings->bBuildHttpChunkInstallData)
 		{
-			BuildCookRunParams += FString::Printf(TEXT(" -manifests -createchunkinstall -chunkinstalldirectory=\"%s\" -chunkinstallversion=%s"), *(PackagingSettings->HttpChunkInstallDataDirectory.Path), *(PackagingSettings->HttpChunkInstallDataVersion));
+			BuildCookRunParams += FString::Printf(TEXT(" -manifests -createchunkinstall -chunkinstalldirectory=%s -chunkinstallversion=%s"), *FUcmdCommand::QuoteArgument(PackagingSettings->HttpChunkInstallDataDirectory.Path), *(PackagingSettings->HttpChunkInstallDataVersion));
 		}
 
 		EProjectPackagingBuildConfigurations BuildConfig = PlatformsSettings->GetBuildConfigurationForPlatform(IniPlatformName);
@@ -1147,17 +1640,88 @@ void FEdgegapSettingsDetails::PackageProject(const FName IniPlatformName)
 	FString TurnkeyParams = FString::Printf(TEXT("-command=VerifySdk -platform=%s -UpdateIfNeeded"), *UBTPlatformString);
 	if (!ProjectPath.IsEmpty())
 	{
-		TurnkeyParams.Appendf(TEXT(" -project=\"%s\""), *ProjectPath);
+		TurnkeyParams.Appendf(TEXT(" -project=%s"), *FUcmdCommand::QuoteArgument(ProjectPath));
 	}
 
 	FString CommandLine;
 	if (!ProjectPath.IsEmpty())
 	{
-		CommandLine.Appendf(TEXT("-ScriptsForProject=\"%s\" "), *ProjectPath);
+		CommandLine.Appendf(TEXT("-ScriptsForProject=%s "), *FUcmdCommand::QuoteArgument(ProjectPath));
 	}
 	CommandLine.Appendf(TEXT("Turnkey %s BuildCookRun %s"), *TurnkeyParams, *BuildCookRunParams);
 
-	IUATHelperModule::Get().CreateUatTask(CommandLine, PlatformInfo->DisplayName, ContentPrepDescription, ContentPrepTaskName, ContentPrepIcon, nullptr, &OnPackageCallaback);
+	// Through the UCMD queue rather than the engine's UAT helper, so the cook waits for other UAT tasks instead of competing with them
+#if PLATFORM_WINDOWS
+	const FString RunUATPath = FPaths::ConvertRelativePathToFull(FPaths::EngineDir() / TEXT("Build/BatchFiles/RunUAT.bat"));
+#else
+	const FString RunUATPath = FPaths::ConvertRelativePathToFull(FPaths::EngineDir() / TEXT("Build/BatchFiles/RunUAT.sh"));
+#endif
+	const FUcmdCommand Command(RunUATPath, FUcmdCommand::ParseArguments(CommandLine));
+
+	// Only once the run really starts, so a canceled dialog or a missing SDK leaves the last run's checkpoint resumable
+	FEdgegapPipelineReport::Get().Begin(FormattedTime);
+	FEdgegapPipelineCheckpoint::Get().Begin(FormattedTime);
+
+	FEdgegapBuildAndPushRun Run = MakeBuildAndPushRun(FormattedTime);
+	Run.StagedPath = FPaths::Combine(PlatformsSettings->StagingDirectory.Path, FString("LinuxServer"));
+
+	bBuildAndPushInFlight = true;
+	IUCMDHelperModule::Get().CreateUcmdTask(Command, PlatformInfo->DisplayName, ContentPrepDescription, ContentPrepTaskName, ContentPrepIcon).Next([Run](const FUcmdResult& Result) { OnPackageCallaback(Run, Result); });
+}
+
+void FEdgegapSettingsDetails::ResumeBuildAndPush()
+{
+	// Partway through a run the checkpoint is resumable too, resuming it would race the run's own next step
+	if (bBuildAndPushInFlight)
+	{
+		UE_LOG(EdgegapLog, Warning, TEXT("ResumeBuildAndPush: A Build and Push run is still in progress"));
+
+		FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
+		Info.ExpireDuration = 3.0f;
+		FSlateNotificationManager::Get().AddNotification(Info);
+		return;
+	}
+
+	FEdgegapPipelineCheckpoint& Checkpoint = FEdgegapPipelineCheckpoint::Get();
+
+	FEdgegapBuildAndPushRun Run = MakeBuildAndPushRun(Checkpoint.GetTag());
+	Run.StagedPath = Checkpoint.GetStagedPath();
+
+	const FText Problem = Checkpoint.ValidateInputs(Run.ImageName);
+	if (!Problem.IsEmpty())
+	{
+		UE_LOG(EdgegapLog, Warning, TEXT("ResumeBuildAndPush: Cannot resume, %s Use Build and Push to start over."), *Problem.ToString());
+
+		FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
+		Info.ExpireDuration = 3.0f;
+		FSlateNotificationManager::Get().AddNotification(Info);
+		return;
+	}
+
+	UE_LOG(EdgegapLog, Log, TEXT("%s"), *Checkpoint.DescribeResume().ToString());
+
+	FEdgegapPipelineReport::Get().Begin(Run.Tag + TEXT("_resumed"));
+	bBuildAndPushInFlight = true;
+
+	switch (Checkpoint.GetNextStage())
+	{
+	case EEdgegapPipelineStage::Containerize:
+		ContainerizeStagedBuild(Run);
+		break;
+
+	case EEdgegapPipelineStage::Push:
+	{
+		// Docker may have removed the image, or rebuilt another one under its name, since
+		const FUcmdCommand Command(TEXT("docker"), { TEXT("image"), TEXT("inspect"), TEXT("--format"), TEXT("{{.Id}}"), Run.ImageName });
+		UE_LOG(EdgegapLog, Log, TEXT("%s"), *Command.ToString());
+		IUCMDHelperModule::Get().CreateUcmdTask(Command, LOCTEXT("DisplayName", "Docker"), LOCTEXT("VerifyImageProjectTaskName", "Checking the built image"), LOCTEXT("VerifyImageTaskName", "Checking Image"), FEditorStyle::GetBrush(TEXT("MainFrame.PackageProject"))).Next([Run](const FUcmdResult& Result) { OnVerifyImageCallback(Run, Result); });
+		break;
+	}
+
+	default:
+		CreateVersion(Run);
+		break;
+	}
 }
 
 void FEdgegapSettingsDetails::AddMessageLog(const FText& Text, const FText& Detail, const FString& TutorialLink, const FString& DocumentationLink)
@@ -1178,22 +1742,9 @@ void FEdgegapSettingsDetails::AddMessageLog(const FText& Text, const FText& Deta
 	MessageLog.Open();
 }
 
-void FEdgegapSettingsDetails::Containerize(FString DockerFilePath, FString StartScriptPath, FString ServerBuildPath, FString RegistryURL, FString ImageRepository,  FString Tag, FString PrivateUsername, FString PrivateToken)
+void FEdgegapSettingsDetails::Containerize(const FEdgegapBuildAndPushRun& Run, FString DockerFilePath, FString StartScriptPath)
 {
-	const UEdgegapSettings* EdgegapSettings = GetDefault<UEdgegapSettings>();
-	const UGeneralProjectSettings& ProjectSettings = *GetDefault<UGeneralProjectSettings>();
-
-	_PrivateUsername = PrivateUsername;
-	_PrivateToken= PrivateToken;
-	_RegistryURL = RegistryURL;
-
-	const FString _AppName = EdgegapSettings->ApplicationName.ToString();
-	_ImageName = FEdgegapSettingsDetails::MakeImageName(RegistryURL, ImageRepository, _AppName, Tag);
-
-	UProjectPackagingSettings* PackagingSettings = Cast<UProjectPackagingSettings>(UProjectPackagingSettings::StaticClass()->GetDefaultObject());
-	UPlatformsMenuSettings* PlatformsSettings = GetMutableDefault<UPlatformsMenuSettings>();
-
-	FString PathToServerBuild = FPaths::Combine(PlatformsSettings->StagingDirectory.Path, FString("LinuxServer"));
+	const FString& ServerBuildPath = Run.StagedPath;
 
 	FString DockerFileContent;
 	FString NewDockerFilePath = FPaths::Combine(ServerBuildPath, FPaths::GetCleanFilename(DockerFilePath));
@@ -1209,34 +1760,35 @@ void FEdgegapSettingsDetails::Containerize(FString DockerFilePath, FString Start
 	StartScriptContent = StartScriptContent.Replace(*FString("<PROJECT_NAME>"), FApp::GetProjectName());
 	FFileHelper::SaveStringToFile(StartScriptContent, *NewStartScriptPath);
 
-	FString CommandLine = FString::Printf(TEXT("docker build -t \"%s\" \"%s\""), *_ImageName, *ServerBuildPath);
-	UE_LOG(EdgegapLog, Log, TEXT("%s"), *CommandLine);
-	IUCMDHelperModule::Get().CreateUcmdTask(CommandLine, LOCTEXT("DisplayName", "Docker"), LOCTEXT("ContainerizingProjectTaskName", "Containerizing server"), LOCTEXT("ContainerizingTaskName", "Containerizing"), FEditorStyle::GetBrush(TEXT("MainFrame.PackageProject")), false, &OnContainerizeCallback);
+	// A build that fails leaves no ID behind, rather than the previous image's
+	const FString ImageIDFilePath = FEdgegapPipelineCheckpoint::GetImageIDFilePath();
+	IFileManager::Get().Delete(*ImageIDFilePath, false, false, true);
+
+	const FUcmdCommand Command(TEXT("docker"), { TEXT("build"), TEXT("--progress=plain"), TEXT("--iidfile"), ImageIDFilePath, TEXT("-t"), Run.ImageName, ServerBuildPath });
+	UE_LOG(EdgegapLog, Log, TEXT("%s"), *Command.ToString());
+	IUCMDHelperModule::Get().CreateUcmdTask(Command, LOCTEXT("DisplayName", "Docker"), LOCTEXT("ContainerizingProjectTaskName", "Containerizing server"), LOCTEXT("ContainerizingTaskName", "Containerizing"), FEditorStyle::GetBrush(TEXT("MainFrame.PackageProject"))).Next([Run](const FUcmdResult& Result) { OnContainerizeCallback(Run, Result); });
 }
 
-void FEdgegapSettingsDetails::PushContainer(FString ImageName, FString RegistryURL, FString PrivateUsername, FString PrivateToken, bool LoggedIn)
+void FEdgegapSettingsDetails::PushContainer(const FEdgegapBuildAndPushRun& Run, bool LoggedIn)
 {
-	_ImageName = ImageName;
-	_RegistryURL = RegistryURL;
-	_PrivateUsername = PrivateUsername;
-	_PrivateToken = PrivateToken;
-
 	if (!LoggedIn)
 	{
-		DockerLogin(RegistryURL, PrivateUsername, PrivateToken);
+		DockerLogin(Run);
 		return;
 	}
 
-	FString CommandLine = FString::Printf(TEXT("docker image push %s"), *ImageName);
-	UE_LOG(EdgegapLog, Log, TEXT("%s"), *CommandLine);
-	IUCMDHelperModule::Get().CreateUcmdTask(CommandLine, LOCTEXT("DisplayName", "Docker"), LOCTEXT("PushContainerProjectTaskName", "Pushing Container"), LOCTEXT("ContainerizingTaskName", "Docker Login"), FEditorStyle::GetBrush(TEXT("MainFrame.PackageProject")), false, &OnPushContainerCallback);
+	const FUcmdCommand Command(TEXT("docker"), { TEXT("image"), TEXT("push"), Run.ImageName });
+	UE_LOG(EdgegapLog, Log, TEXT("%s"), *Command.ToString());
+	IUCMDHelperModule::Get().CreateUcmdTask(Command, LOCTEXT("DisplayName", "Docker"), LOCTEXT("PushContainerProjectTaskName", "Pushing Container"), LOCTEXT("ContainerizingTaskName", "Docker Login"), FEditorStyle::GetBrush(TEXT("MainFrame.PackageProject"))).Next([Run](const FUcmdResult& Result) { OnPushContainerCallback(Run, Result); });
 }
 
-void FEdgegapSettingsDetails::DockerLogin(FString RegistryURL, FString PrivateUsername, FString PrivateToken)
+void FEdgegapSettingsDetails::DockerLogin(const FEdgegapBuildAndPushRun& Run)
 {
-	FString CommandLine = FString::Printf(TEXT("echo \'%s\' | docker login -u \'%s\' --password-stdin %s"), *PrivateToken, *PrivateUsername, *RegistryURL);
-	UE_LOG(EdgegapLog, Log, TEXT("%s"), *CommandLine);
-	IUCMDHelperModule::Get().CreateUcmdTask(CommandLine, LOCTEXT("DisplayName", "Docker"), LOCTEXT("DockerLoginProjectTaskName", "Logging into Registry"), LOCTEXT("ContainerizingTaskName", "Docker Login"), FEditorStyle::GetBrush(TEXT("MainFrame.PackageProject")), true, &OnDockerLoginCallback);
+	// The token goes through docker's standard input, it never shows up in a command line or log
+	FUcmdCommand Command(TEXT("docker"), { TEXT("login"), TEXT("-u"), Run.PrivateRegistryUsername, TEXT("--password-stdin"), Run.Registry });
+	Command.StdIn = Run.PrivateRegistryToken;
+	UE_LOG(EdgegapLog, Log, TEXT("%s"), *Command.ToString());
+	IUCMDHelperModule::Get().CreateUcmdTask(Command, LOCTEXT("DisplayName", "Docker"), LOCTEXT("DockerLoginProjectTaskName", "Logging into Registry"), LOCTEXT("ContainerizingTaskName", "Docker Login"), FEditorStyle::GetBrush(TEXT("MainFrame.PackageProject"))).Next([Run](const FUcmdResult& Result) { OnDockerLoginCallback(Run, Result); });
 }
 
 void FEdgegapSettingsDetails::Request_VerifyToken()
@@ -1247,7 +1799,7 @@ void FEdgegapSettingsDetails::Request_VerifyToken()
 
 	const FString endpoint = FString::Printf(TEXT("v1/wizard/init-quick-start"));
 
-	FString URL = FString::Printf(TEXT("%s%s"), TEXT(EDGEGAP_API_URL), *endpoint);
+	FString URL = FString::Printf(TEXT("%s%s"), *UEdgegapSettings::GetApiBaseURL(), *endpoint);
 
 	FHttpModule* Http = &FHttpModule::Get();
 	if (!Http)
@@ -1286,13 +1838,20 @@ void FEdgegapSettingsDetails::Request_VerifyToken()
 		{
 			const UEdgegapSettings* EdgegapSettings = GetDefault<UEdgegapSettings>();
 
-			int32 ResponseCode = ResponsePtr->GetResponseCode();
+			int32 ResponseCode = ResponsePtr.IsValid() ? ResponsePtr->GetResponseCode() : 0;
 
 			if (!bWasSuccessful || ResponseCode < 200 || ResponseCode > 299)
 			{
-				FString Response = ResponsePtr->GetContentAsString();
+				FString Response = ResponsePtr.IsValid() ? ResponsePtr->GetContentAsString() : FString();
 				UE_LOG(EdgegapLog, Warning, TEXT("VerifyTokenComplete callback: HTTP request failed with code %d and response: %s"), ResponseCode, *Response);
 
+				// The API turned the token down, no answer at all leaves the last known state
+				if (ResponseCode != 0)
+				{
+					OnIsTokenVerifiedChanged.ExecuteIfBound(false);
+					FEdgegapStateSnapshot::Get().SetTokenVerified(false);
+				}
+
 				FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
 				Info.ExpireDuration = 3.0f;
 				FSlateNotificationManager::Get().AddNotification(Info);
@@ -1314,6 +1873,9 @@ void FEdgegapSettingsDetails::Request_VerifyToken()
 						FString message = JsonValue->AsObject()->GetStringField("message");
 						UE_LOG(EdgegapLog, Error, TEXT("VerifyTokenComplete callback: Failed, message:%s"), *message);
 
+						OnIsTokenVerifiedChanged.ExecuteIfBound(false);
+						FEdgegapStateSnapshot::Get().SetTokenVerified(false);
+
 						FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
 						Info.ExpireDuration = 3.0f;
 						FSlateNotificationManager::Get().AddNotification(Info);
@@ -1330,6 +1892,8 @@ void FEdgegapSettingsDetails::Request_VerifyToken()
 				MutableEdgegapSettings->bIsTokenVerified = true;
 				MutableEdgegapSettings->SaveConfig();
 
+				FEdgegapStateSnapshot::Get().SetTokenVerified(true);
+
 				FNotificationInfo Info(LOCTEXT("OperationSuccess", "Token verified successfully"));
 				Info.ExpireDuration = 3.0f;
 				FSlateNotificationManager::Get().AddNotification(Info);
@@ -1387,7 +1951,7 @@ void FEdgegapSettingsDetails::Request_CreateApplication(TSharedPtr<SButton> InCr
 	FString ImagePath = EdgegapSettings->ImagePath.FilePath;
 
 	const FString endpoint = "v1/app";
-	FString URL = FString::Printf(TEXT("%s%s"), TEXT(EDGEGAP_API_URL), *endpoint);
+	FString URL = FString::Printf(TEXT("%s%s"), *UEdgegapSettings::GetApiBaseURL(), *endpoint);
 
 	FHttpRequestRef Request = Http->CreateRequest();
 
@@ -1515,7 +2079,7 @@ void FEdgegapSettingsDetails::Request_RegistryCredentials()
 	FString APIToken = EdgegapSettings->APIToken.APIToken;
 
 	const FString endpoint = "v1/wizard/registry-credentials";
-	FString URL = FString::Printf(TEXT("%s%s"), TEXT(EDGEGAP_API_URL), *endpoint);
+	FString URL = FString::Printf(TEXT("%s%s"), *UEdgegapSettings::GetApiBaseURL(), *endpoint);
 	URL += "?source=unreal";
 
 	FHttpRequestRef Request = Http->CreateRequest();
@@ -1594,22 +2158,22 @@ void FEdgegapSettingsDetails::Request_RegistryCredentials()
 	}
 }
 
-void FEdgegapSettingsDetails::CreateVersion(FString AppName, FString VersionName, FString API_key, FString RegistryURL, FString ImageRepository, FString Tag, FString PrivateUsername, FString PrivateToken)
+void FEdgegapSettingsDetails::CreateVersion(const FEdgegapBuildAndPushRun& Run)
 {
-	_API_key = API_key;
-	_AppName = AppName;
-	_VersionName = VersionName;
+	// Making the container tag name and version name match
+	const FString VersionName = Run.Tag;
 
-	const FString ComposedRepository = FString::Printf(TEXT("%s/%s"), *ImageRepository, *AppName.ToLower());
+	const FString ComposedRepository = FString::Printf(TEXT("%s/%s"), *Run.ImageRepository, *Run.AppName.ToLower());
 
-	const FString endpoint = FString::Printf(TEXT("v1/app/%s/version"), *AppName);
+	const FString endpoint = FString::Printf(TEXT("v1/app/%s/version"), *Run.AppName);
 
-	FString URL = FString::Printf(TEXT("%s%s"), TEXT(EDGEGAP_API_URL), *endpoint);
+	FString URL = FString::Printf(TEXT("%s%s"), *UEdgegapSettings::GetApiBaseURL(), *endpoint);
 
 	FHttpModule* Http = &FHttpModule::Get();
 	if (!Http)
 	{
 		UE_LOG(EdgegapLog, Error, TEXT("Could not get a pointer to http module!"));
+		bBuildAndPushInFlight = false;
 
 		FNotificationInfo* Info = new FNotificationInfo(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
 		Info->ExpireDuration = 3.0f;
@@ -1620,7 +2184,7 @@ void FEdgegapSettingsDetails::CreateVersion(FString AppName, FString VersionName
 
 	FHttpRequestRef Request = Http->CreateRequest();
 	
-	Request->OnProcessRequestComplete().BindStatic(&FEdgegapSettingsDetails::onCreateVersionComplete);
+	Request->OnProcessRequestComplete().BindStatic(&FEdgegapSettingsDetails::onCreateVersionComplete, VersionName);
 
 	// Set request fields
 	Request->SetURL(URL);
@@ -1628,18 +2192,18 @@ void FEdgegapSettingsDetails::CreateVersion(FString AppName, FString VersionName
 	Request->SetHeader(TEXT("User-Agent"), TEXT("X-UnrealEngine-Agent"));
 
 	Request->SetHeader("Content-Type", "application/json");
-	Request->SetHeader(TEXT("Authorization"), *API_key);
+	Request->SetHeader(TEXT("Authorization"), *Run.APIToken);
 
 	// prepare json data
 	FString JsonString;
 	TSharedRef<TJsonWriter<TCHAR>> JsonWriter = TJsonWriterFactory<TCHAR>::Create(&JsonString);
 	JsonWriter->WriteObjectStart();
 	JsonWriter->WriteValue("name", VersionName);
-	JsonWriter->WriteValue("docker_repository", RegistryURL);
+	JsonWriter->WriteValue("docker_repository", Run.Registry);
 	JsonWriter->WriteValue("docker_image", ComposedRepository);
-	JsonWriter->WriteValue("docker_tag", Tag);
-	JsonWriter->WriteValue("private_username", PrivateUsername);
-	JsonWriter->WriteValue("private_token", PrivateToken);
+	JsonWriter->WriteValue("docker_tag", Run.Tag);
+	JsonWriter->WriteValue("private_username", Run.PrivateRegistryUsername);
+	JsonWriter->WriteValue("private_token", Run.PrivateRegistryToken);
 	JsonWriter->WriteValue("req_cpu", 128);
 	JsonWriter->WriteValue("req_memory", 256);
 	JsonWriter->WriteValue("req_video", 0);
@@ -1660,6 +2224,20 @@ void FEdgegapSettingsDetails::CreateVersion(FString AppName, FString VersionName
 	JsonWriter->WriteValue("name", TEXT("gameport"));
 
 	JsonWriter->WriteObjectEnd();
+
+	if (Run.LatencyEchoPort > 0)
+	{
+		JsonWriter->WriteObjectStart();
+
+		JsonWriter->WriteValue("port", Run.LatencyEchoPort);
+		JsonWriter->WriteValue("protocol", TEXT("UDP"));
+		JsonWriter->WriteValue("to_check", false);
+		JsonWriter->WriteValue("tls_upgrade", false);
+		JsonWriter->WriteValue("name", TEXT("echo"));
+
+		JsonWriter->WriteObjectEnd();
+	}
+
 	JsonWriter->WriteArrayEnd();
 
 	JsonWriter->WriteObjectEnd();
@@ -1670,6 +2248,7 @@ void FEdgegapSettingsDetails::CreateVersion(FString AppName, FString VersionName
 	if (!Request->ProcessRequest())
 	{
 		UE_LOG(EdgegapLog, Error, TEXT("CreateVersion: Could not process HTTP request"));
+		bBuildAndPushInFlight = false;
 
 		FNotificationInfo* Info = new FNotificationInfo(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
 		Info->ExpireDuration = 3.0f;
@@ -1678,8 +2257,11 @@ void FEdgegapSettingsDetails::CreateVersion(FString AppName, FString VersionName
 	}
 }
 
-void FEdgegapSettingsDetails::onCreateVersionComplete(FHttpRequestPtr RequestPtr, FHttpResponsePtr ResponsePtr, bool bWasSuccessful)
+void FEdgegapSettingsDetails::onCreateVersionComplete(FHttpRequestPtr RequestPtr, FHttpResponsePtr ResponsePtr, bool bWasSuccessful, FString VersionName)
 {
+	// The last step of Build and Push, whatever the answer
+	bBuildAndPushInFlight = false;
+
 	if (!bWasSuccessful || ResponsePtr->GetResponseCode() < 200 || ResponsePtr->GetResponseCode() > 299)
 	{
 		FString Response = ResponsePtr->GetContentAsString();
@@ -1707,6 +2289,13 @@ void FEdgegapSettingsDetails::onCreateVersionComplete(FHttpRequestPtr RequestPtr
 			return;
 		}
 
+		// Deploy and Play and the deploy buttons default to the version pushed last
+		UEdgegapSettings* MutableEdgegapSettings = GetMutableDefault<UEdgegapSettings>();
+		MutableEdgegapSettings->VersionName = VersionName;
+		MutableEdgegapSettings->SaveConfig();
+
+		FEdgegapPipelineCheckpoint::Get().CompleteVersion(VersionName);
+
 		FNotificationInfo Info(LOCTEXT("OperationSuccess", "Version created successfully"));
 		Info.ExpireDuration = 3.0f;
 		FSlateNotificationManager::Get().AddNotification(Info);
@@ -1725,288 +2314,143 @@ void FEdgegapSettingsDetails::onCreateVersionComplete(FHttpRequestPtr RequestPtr
 
 void FEdgegapSettingsDetails::Request_DeployApp(FString AppName, FString VersionName, FString API_key, TSharedPtr<SButton> InCreateNewDeployment_SBtn)
 {
-	const FString IpifyIPsURL = "http://api.ipify.org/";
-
-	FHttpModule* Http = &FHttpModule::Get();
-	if (!Http)
+	// Usually answered straight from the cache, only the very first deploy may wait for the lookup
+	FEdgegapPublicIPCache::Get().ResolvePublicIP([this, AppName, VersionName, API_key, InCreateNewDeployment_SBtn](const FString& PublicIP)
 	{
-		if (InCreateNewDeployment_SBtn)
-		{
-			InCreateNewDeployment_SBtn->SetEnabled(true);
-		}
-
-		UE_LOG(EdgegapLog, Error, TEXT("Could not get a pointer to http module!"));
-
-		FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
-		Info.ExpireDuration = 3.0f;
-		FSlateNotificationManager::Get().AddNotification(Info);
-
-		return;
-	}
-
-	FHttpRequestRef IpifyRequest = Http->CreateRequest();
-
-	// Set request fields
-	IpifyRequest->SetURL(IpifyIPsURL);
-	IpifyRequest->SetVerb("GET");
-	IpifyRequest->SetHeader(TEXT("User-Agent"), TEXT("X-UnrealEngine-Agent"));
-
-	IpifyRequest->SetHeader("Content-Type", "application/json");
-	IpifyRequest->SetHeader(TEXT("Authorization"), *API_key);
-
-	IpifyRequest->OnProcessRequestComplete().BindLambda([this, AppName, VersionName, InCreateNewDeployment_SBtn, API_key](FHttpRequestPtr Request, FHttpResponsePtr ResponsePtr, bool bWasSuccessful)
+		if (PublicIP.IsEmpty())
 		{
 			if (InCreateNewDeployment_SBtn)
 			{
 				InCreateNewDeployment_SBtn->SetEnabled(true);
 			}
 
-			if (!bWasSuccessful || ResponsePtr->GetResponseCode() < 200 || ResponsePtr->GetResponseCode() > 299)
-			{
-				FString Response = ResponsePtr->GetContentAsString();
-				UE_LOG(EdgegapLog, Warning, TEXT("onIpifyRequest: HTTP request failed with code %d and response: %s"), ResponsePtr->GetResponseCode(), *Response);
-
-				FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
-				Info.ExpireDuration = 3.0f;
-				FSlateNotificationManager::Get().AddNotification(Info);
-
-				return;
-			}
-
-			FString Response = ResponsePtr->GetContentAsString();
-
-			TSharedPtr<FJsonValue> JsonValue;
-			// Create a reader pointer to read the json data
-			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response);
-
-			if (FJsonSerializer::Deserialize(Reader, JsonValue))
-			{
-				if (JsonValue->AsObject()->HasField("message"))
-				{
-					FString message = JsonValue->AsObject()->GetStringField("message");
-					UE_LOG(EdgegapLog, Error, TEXT("onIpifyRequest: Failed, message:%s"), *message);
-
-					FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
-					Info.ExpireDuration = 3.0f;
-					FSlateNotificationManager::Get().AddNotification(Info);
-
-					return;
-				}
-			}
-			if (!Response.IsEmpty())
-			{
-				// Deployment Request
-				
-				const UEdgegapSettings* EdgegapSettings = GetDefault<UEdgegapSettings>();
-
-				const FString endpoint = FString::Printf(TEXT("v1/deploy"));
-
-				FString URL = FString::Printf(TEXT("%s%s"), TEXT(EDGEGAP_API_URL), *endpoint);
-
-				FHttpModule* Http = &FHttpModule::Get();
-				if (!Http)
-				{
-					if (InCreateNewDeployment_SBtn)
-					{
-						InCreateNewDeployment_SBtn->SetEnabled(true);
-					}
-
-					UE_LOG(EdgegapLog, Error, TEXT("Could not get a pointer to http module!"));
+			UE_LOG(EdgegapLog, Error, TEXT("onDeployApp: Could not determine the public IP, set a Public IP Override in the Deployments settings"));
 
-					FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
-					Info.ExpireDuration = 3.0f;
-					FSlateNotificationManager::Get().AddNotification(Info);
-
-					return;
-				}
-
-				FHttpRequestRef Request = Http->CreateRequest();
-
-				// Set request fields
-				Request->SetURL(URL);
-				Request->SetVerb("POST");
-				Request->SetHeader(TEXT("User-Agent"), TEXT("X-UnrealEngine-Agent"));
-
-				Request->SetHeader("Content-Type", "application/json");
-				Request->SetHeader(TEXT("Authorization"), *API_key);
-
-				// prepare json data
-				FString JsonString;
-				TSharedRef<TJsonWriter<TCHAR>> JsonWriter = TJsonWriterFactory<TCHAR>::Create(&JsonString);
-				JsonWriter->WriteObjectStart();
-				JsonWriter->WriteValue(TEXT("app_name"), AppName);
-				JsonWriter->WriteValue(TEXT("version_name"), VersionName);
-
-				JsonWriter->WriteRawJSONValue(TEXT("ip_list"), "[\
-					\""+ Response + "\"\
-				]");
-
-				JsonWriter->WriteObjectEnd();
-				JsonWriter->Close();
-
-				// Insert the content into the request
-				Request->SetContentAsString(JsonString);
-
-				Request->OnProcessRequestComplete().BindLambda([this, InCreateNewDeployment_SBtn, API_key](FHttpRequestPtr Request, FHttpResponsePtr ResponsePtr, bool bWasSuccessful)
-					{
-						if (InCreateNewDeployment_SBtn)
-						{
-							InCreateNewDeployment_SBtn->SetEnabled(true);
-						}
-
-						if (!bWasSuccessful || ResponsePtr->GetResponseCode() < 200 || ResponsePtr->GetResponseCode() > 299)
-						{
-							FString Response = ResponsePtr->GetContentAsString();
-							UE_LOG(EdgegapLog, Warning, TEXT("onDeployApp: HTTP request failed with code %d and response: %s"), ResponsePtr->GetResponseCode(), *Response);
-
-							FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
-							Info.ExpireDuration = 3.0f;
-							FSlateNotificationManager::Get().AddNotification(Info);
-
-							return;
-						}
-
-						FString Response = ResponsePtr->GetContentAsString();
+			FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
+			Info.ExpireDuration = 3.0f;
+			FSlateNotificationManager::Get().AddNotification(Info);
 
-						TSharedPtr<FJsonValue> JsonValue;
-						// Create a reader pointer to read the json data
-						TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response);
+			return;
+		}
 
-						if (FJsonSerializer::Deserialize(Reader, JsonValue))
-						{
-							if (JsonValue->AsObject()->HasField("message"))
-							{
-								FString message = JsonValue->AsObject()->GetStringField("message");
-								UE_LOG(EdgegapLog, Error, TEXT("onDeployApp: Failed, message:%s"), *message);
+		Request_DeployApp(AppName, VersionName, API_key, PublicIP, InCreateNewDeployment_SBtn);
+	});
+}
 
-								FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
-								Info.ExpireDuration = 3.0f;
-								FSlateNotificationManager::Get().AddNotification(Info);
+void FEdgegapSettingsDetails::Request_DeployApp(FString AppName, FString VersionName, FString API_key, FString PublicIP, TSharedPtr<SButton> InCreateNewDeployment_SBtn)
+{
+	FEdgegapDeploymentRequests::Deploy(AppName, VersionName, API_key, { PublicIP }, [this, InCreateNewDeployment_SBtn, API_key](const FEdgegapRequestResult& Result)
+	{
+		if (InCreateNewDeployment_SBtn)
+		{
+			InCreateNewDeployment_SBtn->SetEnabled(true);
+		}
 
-								return;
-							}
-						}
-						else
-						{
-							UE_LOG(EdgegapLog, Error, TEXT("onDeployApp: Could not deserialize response into Json, Response:%s"), *Response);
+		if (!Result.bSucceeded)
+		{
+			UE_LOG(EdgegapLog, Error, TEXT("onDeployApp: %s"), *Result.Error);
 
-							FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
-							Info.ExpireDuration = 3.0f;
-							FSlateNotificationManager::Get().AddNotification(Info);
+			FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
+			Info.ExpireDuration = 3.0f;
+			FSlateNotificationManager::Get().AddNotification(Info);
 
-							return;
-						}
+			return;
+		}
 
-						Request_GetDeploymentsInfo(API_key, nullptr);
-					});
+		// The new deployment may take a moment to even show up in v1/deployments
+		FEdgegapDeploymentPoller::Get().ExpectTransition();
+		Request_GetDeploymentsInfo(API_key, nullptr);
+	});
+}
 
-				if (!Request->ProcessRequest())
-				{
-					UE_LOG(EdgegapLog, Error, TEXT("onDeployApp: Could not process HTTP request"));
+void FEdgegapSettingsDetails::Request_GetDeploymentsInfo(FString API_key, TSharedPtr<SButton> InRefreshBtn)
+{
+	// The poller owns the v1/deployments request, this just asks for one now and re-enables the button once it lands
+	FEdgegapDeploymentPoller::Get().PollNow(API_key, FSimpleDelegate::CreateLambda([InRefreshBtn]()
+	{
+		if (InRefreshBtn)
+		{
+			InRefreshBtn->SetEnabled(true);
+		}
+	}));
+}
 
-					FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
-					Info.ExpireDuration = 3.0f;
-					FSlateNotificationManager::Get().AddNotification(Info);
+void FEdgegapSettingsDetails::HandleDeploymentsUpdated(const TArray<TSharedPtr<FDeploymentStatusListItem>>& Deployments)
+{
+	// Items are stable per RequestID and rows read them on paint, the table only re-sorts or re-filters
+	// when the set of rows or a key it orders by changed
+	DeployStatusOverrideListSource = Deployments;
+	DeploymentTable.SetDeployments(Deployments);
 
-					return;
-				}
-			}
-			else
-			{
-				UE_LOG(EdgegapLog, Error, TEXT("onIpifyRequest: Could not deserialize response into Json, Response:%s"), *Response);
+	// Re-ordering by latency once per poll rather than per probe keeps rows from jumping around every second
+	if (DeploymentTable.GetSortColumn() == FEdgegapDeploymentTable::LatencyColumn)
+	{
+		DeploymentTable.RefreshLatency();
+	}
 
-				FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
-				Info.ExpireDuration = 3.0f;
-				FSlateNotificationManager::Get().AddNotification(Info);
+	RefreshDeploymentView();
+}
 
-				return;
-			}
+void FEdgegapSettingsDetails::HandleDeploymentsRestored()
+{
+	// The snapshot loads off the game thread and can land after the panel opened
+	HandleDeploymentsUpdated(FEdgegapDeploymentPoller::Get().GetDeployments());
+}
 
-			Request_GetDeploymentsInfo(API_key, nullptr);
-		});
+void FEdgegapSettingsDetails::HandleDeploymentSortChanged(EColumnSortPriority::Type SortPriority, const FName& ColumnName, EColumnSortMode::Type SortMode)
+{
+	DeploymentTable.SetSort(ColumnName, SortMode);
+	RefreshDeploymentView();
+}
 
-	if (!IpifyRequest->ProcessRequest())
+void FEdgegapSettingsDetails::RefreshDeploymentView()
+{
+	if (DeploymentTable.UpdateView() && DeploymentStatusListItemListView)
 	{
-		UE_LOG(EdgegapLog, Error, TEXT("onDeployApp: Could not process HTTP request"));
-
-		FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
-		Info.ExpireDuration = 3.0f;
-		FSlateNotificationManager::Get().AddNotification(Info);
-
-		return;
+		DeploymentStatusListItemListView->RequestListRefresh();
 	}
 }
 
-void FEdgegapSettingsDetails::Request_GetDeploymentsInfo(FString API_key, TSharedPtr<SButton> InRefreshBtn)
+void FEdgegapSettingsDetails::HandleDeploymentSelectionChanged(TSharedPtr<FDeploymentStatusListItem> InItem, ESelectInfo::Type SelectInfo)
 {
-	const FString endpoint = FString::Printf(TEXT("v1/deployments"));
-
-	FString URL = FString::Printf(TEXT("%s%s"), TEXT(EDGEGAP_API_URL), *endpoint);
-
-	FHttpModule* Http = &FHttpModule::Get();
-	if (!Http)
+	if (!InItem.IsValid())
 	{
-		if (InRefreshBtn)
-		{
-			InRefreshBtn->SetEnabled(true);
-		}
-
-		UE_LOG(EdgegapLog, Error, TEXT("Could not get a pointer to http module!"));
-
-		FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
-		Info.ExpireDuration = 3.0f;
-		FSlateNotificationManager::Get().AddNotification(Info);
-
+		SelectedDeploymentRequestID.Empty();
 		return;
 	}
 
-	FHttpRequestRef Request = Http->CreateRequest();
+	const FString RequestID = InItem->RequestID;
 
-	// Set request fields
-	Request->SetURL(URL);
-	Request->SetVerb("GET");
-	Request->SetHeader(TEXT("User-Agent"), TEXT("X-UnrealEngine-Agent"));
+	SelectedDeploymentRequestID = RequestID;
 
-	Request->SetHeader("Content-Type", "application/json");
-	Request->SetHeader(TEXT("Authorization"), *API_key);
+	FEdgegapDeploymentDetailsPtr Cached = FEdgegapDeploymentDetailsCache::Get().Find(RequestID);
+	SelectedDeploymentDetailsText = Cached.IsValid() ? Cached->ToText() : LOCTEXT("DeploymentDetailsLoading", "Loading deployment details...");
 
-	Request->OnProcessRequestComplete().BindLambda([InRefreshBtn, API_key](FHttpRequestPtr Request, FHttpResponsePtr ResponsePtr, bool bWasSuccessful)
+	FEdgegapDeploymentDetailsCache::Get().Request(RequestID, InItem->API_Key, [this, RequestID](FEdgegapDeploymentDetailsPtr Details, const FString& Error)
 	{
-		if (InRefreshBtn)
+		// The panel may have been closed or moved on to another deployment meanwhile
+		if (GetInstance() != this || SelectedDeploymentRequestID != RequestID)
 		{
-			InRefreshBtn->SetEnabled(true);
-		}
-
-		FEdgegapSettingsDetails::GetInstance()->DeployStatusOverrideListSource.Empty();
-
-		if (!bWasSuccessful || ResponsePtr->GetResponseCode() < 200 || ResponsePtr->GetResponseCode() > 299)
-		{
-			FString Response = ResponsePtr->GetContentAsString();
-			UE_LOG(EdgegapLog, Warning, TEXT("Callback_GetDeploymentsInfo: HTTP request failed with code %d and response: %s"), ResponsePtr->GetResponseCode(), *Response);
 			return;
 		}
 
-		FString Response = ResponsePtr->GetContentAsString();
-
-		TSharedPtr<FJsonValue> JsonValue;
-		// Create a reader pointer to read the json data
-		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response);
-
-		if (!FJsonSerializer::Deserialize(Reader, JsonValue))
+		if (!Details.IsValid())
 		{
-			UE_LOG(EdgegapLog, Error, TEXT("Callback_GetDeploymentsInfo: Could not deserialize response into Json, Response:%s"), *Response);
-
-			FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
-			Info.ExpireDuration = 3.0f;
-			FSlateNotificationManager::Get().AddNotification(Info);
-
+			SelectedDeploymentDetailsText = LOCTEXT("DeploymentDetailsFailed", "Could not load deployment details. See logs for more information");
 			return;
 		}
 
-		if (!JsonValue->AsObject()->HasField("data"))
+		SelectedDeploymentDetailsText = Details->ToText();
+	});
+}
+
+void FEdgegapSettingsDetails::Request_StopDeploy(FString RequestID, FString API_key)
+{
+	FEdgegapDeploymentRequests::Stop(RequestID, API_key, [API_key](const FEdgegapRequestResult& Result)
+	{
+		if (!Result.bSucceeded)
 		{
-			FString message = JsonValue->AsObject()->GetStringField("message");
-			UE_LOG(EdgegapLog, Error, TEXT("Callback_GetDeploymentsInfo: Failed, message:%s"), *message);
+			UE_LOG(EdgegapLog, Warning, TEXT("Callback_StopDeploy: %s"), *Result.Error);
 
 			FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
 			Info.ExpireDuration = 3.0f;
@@ -2015,117 +2459,32 @@ void FEdgegapSettingsDetails::Request_GetDeploymentsInfo(FString API_key, TShare
 			return;
 		}
 
-		for (auto deployment : JsonValue->AsObject()->GetArrayField("data"))
-		{
-			FString link;
-
-			if (auto ports_obj = deployment->AsObject()->GetObjectField("ports"))
-			{
-				if (auto obj_field_gameport = ports_obj->GetObjectField("gameport"))
-				{
-					link = ports_obj->GetObjectField("gameport")->GetStringField("link");
-				}
-			}
-
-			if (link.IsEmpty())
-			{
-				link = "Empty";
-			}
-
-			FString RequestID = deployment->AsObject()->GetStringField("request_id");
-			FString Status = deployment->AsObject()->GetStringField("status");
-			bool bReady = deployment->AsObject()->GetBoolField("ready");
-			FEdgegapSettingsDetails* ESD = FEdgegapSettingsDetails::GetInstance();
-			ESD->DeployStatusOverrideListSource.Add(MakeShareable(new FDeploymentStatusListItem(link, Status, RequestID, API_key, bReady)));
-
-			ESD->DeploymentStatusListItemListView->RebuildList();
-			ESD->DeploymentStatusListItemListView->RequestListRefresh();
-		}
-
-		if (auto ESD = FEdgegapSettingsDetails::GetInstance())
-		{
-			auto listView = ESD->DeploymentStatusListItemListView;
-
-			if (listView && &ESD->DeployStatusOverrideListSource)
-			{
-				listView->SetItemsSource(&ESD->DeployStatusOverrideListSource);
-			}
-		}
+		// Coalesces with other stops finishing around the same time
+		FEdgegapDeploymentPoller::Get().ExpectTransition();
+		FEdgegapDeploymentPoller::Get().PollNow(API_key);
 	});
-
-	if (!Request->ProcessRequest())
-	{
-		UE_LOG(EdgegapLog, Error, TEXT("Callback_GetDeploymentsInfo: Could not process HTTP request"));
-
-		FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
-		Info.ExpireDuration = 3.0f;
-		FSlateNotificationManager::Get().AddNotification(Info);
-
-		return;
-	}
 }
 
-void FEdgegapSettingsDetails::Callback_GetDeploymentsInfo(FHttpRequestPtr RequestPtr, FHttpResponsePtr ResponsePtr, bool bWasSuccessful)
+void FEdgegapSettingsDetails::Request_StopDeployments(const TArray<FString>& RequestIDs, FString API_key)
 {
+	bStopInFlight = true;
 
-}
-
-void FEdgegapSettingsDetails::Request_StopDeploy(FString RequestID, FString API_key)
-{
-	const FString endpoint = FString::Printf(TEXT("v1/stop/%s"), *RequestID);
-
-	FString URL = FString::Printf(TEXT("%s%s"), TEXT(EDGEGAP_API_URL), *endpoint);
-
-	FHttpModule* Http = &FHttpModule::Get();
-	if (!Http)
+	FEdgegapDeploymentRequests::StopMany(RequestIDs, API_key, [](int32 NumStopped, int32 NumFailed)
 	{
-		UE_LOG(EdgegapLog, Error, TEXT("Could not get a pointer to http module!"));
-
-		FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
-		Info.ExpireDuration = 3.0f;
-		FSlateNotificationManager::Get().AddNotification(Info);
+		bStopInFlight = false;
 
-		return;
-	}
-
-	FHttpRequestRef Request = Http->CreateRequest();
-
-	Request->SetURL(URL);
-	Request->SetVerb("DELETE");
-	Request->SetHeader(TEXT("User-Agent"), TEXT("X-UnrealEngine-Agent"));
-	Request->SetHeader(TEXT("Authorization"), *API_key);
-
-	Request->OnProcessRequestComplete().BindLambda([this](FHttpRequestPtr Request, FHttpResponsePtr ResponsePtr, bool bWasSuccessful)
-	{
-		if (!bWasSuccessful || ResponsePtr->GetResponseCode() < 200 || ResponsePtr->GetResponseCode() > 299)
+		if (NumFailed > 0)
 		{
-			FString Response = ResponsePtr->GetContentAsString();
-			UE_LOG(EdgegapLog, Warning, TEXT("Callback_StopDeploy: HTTP request failed with code %d and response: %s"), ResponsePtr->GetResponseCode(), *Response);
-			return;
+			FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
+			Info.ExpireDuration = 3.0f;
+			FSlateNotificationManager::Get().AddNotification(Info);
 		}
-
-		const UEdgegapSettings* EdgegapSettings = GetDefault<UEdgegapSettings>();
-
-		const FString _APIToken = EdgegapSettings->APIToken.APIToken;
-
-		Request_GetDeploymentsInfo(_APIToken, nullptr);
 	});
-
-	if (!Request->ProcessRequest())
-	{
-		UE_LOG(EdgegapLog, Error, TEXT("Callback_StopDeploy: Could not process HTTP request"));
-
-		FNotificationInfo Info(LOCTEXT("OperationFailed", "Operation failed. See logs for more information"));
-		Info.ExpireDuration = 3.0f;
-		FSlateNotificationManager::Get().AddNotification(Info);
-
-		return;
-	}
 }
 
 TSharedRef<ITableRow> FEdgegapSettingsDetails::HandleGenerateDeployStatusWidget(TSharedPtr<FDeploymentStatusListItem> InItem, const TSharedRef<STableViewBase>& InOwnerTable)
 {
-	UE_LOG(EdgegapLog, Log, TEXT("HandleGenerateDeployStatusWidget %s : %s : %s : %d"), *InItem->DeploymentIP, *InItem->DeploymentStatus, *InItem->RequestID, InItem->DeploymentReady);
+	UE_LOG(EdgegapLog, Verbose, TEXT("HandleGenerateDeployStatusWidget %s : %s : %s : %d"), *InItem->DeploymentIP, *InItem->DeploymentStatus, *InItem->RequestID, InItem->DeploymentReady);
 	return SNew(SDeployStatusListItem, InOwnerTable).Item(InItem);
 }
 
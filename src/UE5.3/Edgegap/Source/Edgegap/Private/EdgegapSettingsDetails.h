@@ -17,52 +17,44 @@
 #include "Interfaces/ITargetPlatform.h"
 #include "Interfaces/ITargetPlatformModule.h"
 #include "DetailWidgetRow.h"
+#include "Deployments/EdgegapDeploymentTypes.h"
+#include "Deployments/EdgegapDeploymentTable.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(EdgegapLog, Log, All);
 
 DECLARE_DELEGATE_OneParam(FOnIsTokenVerifiedChanged, bool);
 
-class UcmdTaskResultCallack;
-
 template <typename ItemType>
 class SCustomListView : public SListView< ItemType >
 {
 public:
+	/** Sources are only swapped on the game thread, with a finished list (see FEdgegapDeploymentPoller). */
 	void SetListItemsSource(const TArray<ItemType>* InListItemsSource)
 	{
-		AsyncTask(ENamedThreads::GameThread, [this, InListItemsSource] {
-			this->Private_ClearSelection();
-			this->CancelScrollIntoView();
-			this->ClearWidgets();
-			this->RebuildList();
-			this->ItemsSource = InListItemsSource;
-		});
-		
-		TArray<ItemType> x = (*this->ItemsSource);
-	}
-};
-
-
-struct FDeploymentStatusListItem
-{
-public:
-	FString DeploymentIP, DeploymentStatus, RequestID, API_Key;
-	bool DeploymentReady;
-
+		check(IsInGameThread());
 
+		this->Private_ClearSelection();
+		this->CancelScrollIntoView();
+		this->SetItemsSource(InListItemsSource);
+	}
 
-	FDeploymentStatusListItem() {}
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override
+	{
+		SListView< ItemType >::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+		LastTickTime = FPlatformTime::Seconds();
+	}
 
-	FDeploymentStatusListItem(FString InDeploymentIP, FString InDeploymentStatus, FString InRequestID, FString InAPI_Key, bool InDeploymentReady)
-		: DeploymentIP(InDeploymentIP)
-		, DeploymentStatus(InDeploymentStatus)
-		, RequestID(InRequestID)
-		, API_Key(InAPI_Key)
-		, DeploymentReady(InDeploymentReady)
+	/** Slate only ticks widgets it paints, so a list that stopped ticking is hidden (collapsed category, closed or background tab). */
+	bool IsShowing() const
 	{
+		return FPlatformTime::Seconds() - LastTickTime < 2.0;
 	}
+
+private:
+	double LastTickTime = FPlatformTime::Seconds();
 };
 
+
 typedef SCustomListView< TSharedPtr< struct FDeploymentStatusListItem > > SDeploymentStatusListItemListView;
 typedef TSharedPtr<IImageWrapper> IImageWrapperPtr;
 typedef PlatformInfo::FTargetPlatformInfo FPlatformInfo;
@@ -89,39 +81,68 @@ public:
 	}
 };
 
+/** What one Build and Push run works with, read from the settings when it starts and handed from step to step */
+struct FEdgegapBuildAndPushRun
+{
+	FString Tag;
+	FString AppName;
+	FString Registry;
+	FString ImageRepository;
+	FString ImageName;
+	FString PrivateRegistryUsername;
+	FString PrivateRegistryToken;
+	FString APIToken;
+	int32 LatencyEchoPort = 0;
+
+	// The staged LinuxServer folder, set once packaging has a staging directory
+	FString StagedPath;
+};
+
 class FEdgegapSettingsDetails : public IDetailCustomization
 {
 public:
 	static TSharedRef<IDetailCustomization> MakeInstance();
 
+	virtual ~FEdgegapSettingsDetails();
+
 	virtual void CustomizeDetails(IDetailLayoutBuilder& DetailBuilder) override;
 
 	static void PackageProject(const FName IniPlatformName);
 
+	/** Continues the last Build and Push from the first step it didn't finish, see FEdgegapPipelineCheckpoint */
+	static void ResumeBuildAndPush();
+
 	static void SaveAll();
 	static void AddMessageLog(const FText& Text, const FText& Detail, const FString& TutorialLink, const FString& DocumentationLink);
-	static void Containerize(FString DockerFilePath, FString StartScriptPath, FString ServerBuildPath, FString RegistryURL, FString ImageRepository, FString Tag, FString PrivateUsername, FString PrivateToken);
-	static void PushContainer(FString ImageName, FString RegistryURL, FString PrivateUsername, FString PrivateToken, bool LoggedIn=false);
-	static void DockerLogin(FString RegistryURL, FString PrivateUsername, FString PrivateToken);
+	static void Containerize(const FEdgegapBuildAndPushRun& Run, FString DockerFilePath, FString StartScriptPath);
+	static void PushContainer(const FEdgegapBuildAndPushRun& Run, bool LoggedIn=false);
+	static void DockerLogin(const FEdgegapBuildAndPushRun& Run);
 
 	void Request_VerifyToken();
 	void Request_CreateApplication(TSharedPtr<SButton> InCreateApplication_SBtn);
 
 	void Request_RegistryCredentials();
 
-	static void CreateVersion(FString AppName, FString VersionName, FString API_key, FString RegistryURL, FString ImageRepository, FString Tag, FString PrivateUsername, FString PrivateToken);
-	static void onCreateVersionComplete(FHttpRequestPtr RequestPtr, FHttpResponsePtr ResponsePtr, bool bWasSuccessful);
+	/** Registers the run's pushed image as a version of the application, named like its tag */
+	static void CreateVersion(const FEdgegapBuildAndPushRun& Run);
+	static void onCreateVersionComplete(FHttpRequestPtr RequestPtr, FHttpResponsePtr ResponsePtr, bool bWasSuccessful, FString VersionName);
 
 	void Request_DeployApp(FString AppName, FString VersionName, FString API_key, TSharedPtr<SButton> InCreateNewDeployment_SBtn);
+	void Request_DeployApp(FString AppName, FString VersionName, FString API_key, FString PublicIP, TSharedPtr<SButton> InCreateNewDeployment_SBtn);
 
 	void Request_GetDeploymentsInfo(FString API_key, TSharedPtr<SButton> InRefreshBtn);
-	static void Callback_GetDeploymentsInfo(FHttpRequestPtr RequestPtr, FHttpResponsePtr ResponsePtr, bool bWasSuccessful);
 
 	void Request_StopDeploy(FString RequestID, FString API_key);
+	void Request_StopDeployments(const TArray<FString>& RequestIDs, FString API_key);
+
+	void HandleDeploymentsUpdated(const TArray<TSharedPtr<FDeploymentStatusListItem>>& Deployments);
+	void HandleDeploymentsRestored();
+	void HandleDeploymentSelectionChanged(TSharedPtr<FDeploymentStatusListItem> InItem, ESelectInfo::Type SelectInfo);
+	void HandleDeploymentSortChanged(EColumnSortPriority::Type SortPriority, const FName& ColumnName, EColumnSortMode::Type SortMode);
+	void RefreshDeploymentView();
 
-	static FString _ImageName, _RegistryURL, _PrivateUsername, _PrivateToken, _API_key;
-	static FString _AppName, _VersionName;
-	static FString _RecentTag;
+	// From a run's first task until its version is created or a step fails, Resume waits for it
+	static bool bBuildAndPushInFlight;
 
 	FString GetApplicationImageFilename(const bool bInIsGameOverride = false)
 	{
@@ -242,7 +263,19 @@ public:
 	TWeakObjectPtr<UEdgegapSettings> Settings;
 	TSharedRef<ITableRow> HandleGenerateDeployStatusWidget(TSharedPtr<FDeploymentStatusListItem> InItem, const TSharedRef<STableViewBase>& InOwnerTable);
 	TSharedPtr<SDeploymentStatusListItemListView> DeploymentStatusListItemListView;
-	TSharedPtr<SButton> CreateApplication_SBtn, CreateBuilAndPushBtn_SBtn, DeploymentStatuRefresh_SBtn, StartDeployButton, CreateNewDeployment_SBtn;
+	TSharedPtr<SButton> CreateApplication_SBtn, CreateBuilAndPushBtn_SBtn, DeploymentStatuRefresh_SBtn, StartDeployButton, CreateNewDeployment_SBtn, BatchDeploy_SBtn, StopSelected_SBtn, StopAll_SBtn;
+	TSharedPtr<class SEditableTextBox> BatchDeployVersion_STextBox;
+	TSharedPtr<class SMultiLineEditableTextBox> BatchDeployIPs_STextBox;
+
+	// Outlives the panel, the stop buttons stay disabled until the requests in flight are answered
+	static bool bStopInFlight;
+	int32 BatchDeployCount = 10;
+
+	FString SelectedDeploymentRequestID;
+	FText SelectedDeploymentDetailsText;
+
+	// What the list shows: DeployStatusOverrideListSource sorted and filtered
+	FEdgegapDeploymentTable DeploymentTable;
 
 	FDetailWidgetRow* AppNameWidgetRow;
 	FDetailWidgetRow* AppImageWidgetRow;
@@ -0,0 +1,195 @@
+#include "EdgegapMockApiServer.h"
+#include "EdgegapSettings.h"
+#include "EdgegapSettingsDetails.h"
+#include "Deployments/EdgegapDeploymentPoller.h"
+#include "Deployments/EdgegapDeploymentRequests.h"
+#include "Deployments/EdgegapRequestFanOut.h"
+#include "HAL/IConsoleManager.h"
+#include "Containers/Ticker.h"
+
+// Console front end for the mock API plus a few benchmarks that run the plugin's request code against it.
+//
+//   Edgegap.Mock.Start [Port]
+//   Edgegap.Mock.Config MaxLatency=0.2 ErrorRate=0.05 RateLimitRate=0.1 PaddingBytes=65536 ...
+//   Edgegap.Mock.Bench.Deploy [Count] [Concurrency]
+//   Edgegap.Mock.Bench.Poll [Iterations]
+
+namespace
+{
+	const TCHAR* MockAPIKey = TEXT("token mock");
+
+	double GetPercentile(TArray<double> Samples, float Percentile)
+	{
+		if (Samples.Num() == 0)
+		{
+			return 0.0;
+		}
+
+		Samples.Sort();
+		return Samples[FMath::Clamp(FMath::CeilToInt(Percentile * Samples.Num()) - 1, 0, Samples.Num() - 1)];
+	}
+
+	void LogLatencies(const TCHAR* Name, const TArray<double>& Samples, double Elapsed)
+	{
+		UE_LOG(EdgegapLog, Display, TEXT("MockBench %s: %d requests in %.2fs, %.1f req/s, latency p50 %.1fms p95 %.1fms max %.1fms"),
+			Name, Samples.Num(), Elapsed, Elapsed > 0.0 ? Samples.Num() / Elapsed : 0.0,
+			GetPercentile(Samples, 0.5f) * 1000.0, GetPercentile(Samples, 0.95f) * 1000.0, GetPercentile(Samples, 1.0f) * 1000.0);
+	}
+
+	bool EnsureMockRunning()
+	{
+		return FEdgegapMockApiServer::Get().IsRunning() || FEdgegapMockApiServer::Get().Start();
+	}
+
+	FAutoConsoleCommand MockStartCommand(
+		TEXT("Edgegap.Mock.Start"),
+		TEXT("Serves a mock Edgegap API on localhost and points the plugin at it. Optional argument: port (default 8089)."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			FEdgegapMockApiServer::Get().Start(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 8089);
+		}));
+
+	FAutoConsoleCommand MockStopCommand(
+		TEXT("Edgegap.Mock.Stop"),
+		TEXT("Stops the mock Edgegap API, requests go to the configured API again."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			FEdgegapMockApiServer::Get().Stop();
+		}));
+
+	FAutoConsoleCommand MockResetCommand(
+		TEXT("Edgegap.Mock.Reset"),
+		TEXT("Drops the mock's deployments and reseeds its fault injection."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			FEdgegapMockApiServer::Get().Reset();
+		}));
+
+	FAutoConsoleCommand MockConfigCommand(
+		TEXT("Edgegap.Mock.Config"),
+		TEXT("Sets mock fault injection as Key=Value pairs: MinLatency, MaxLatency, ErrorRate, ErrorCode, RateLimitRate, RetryAfter, PaddingBytes, ExtraDeployments, ReadyDelay, TerminateDelay, Seed."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			FEdgegapMockApiConfig& Config = FEdgegapMockApiServer::Get().GetConfig();
+
+			for (const FString& Arg : Args)
+			{
+				FParse::Value(*Arg, TEXT("MinLatency="), Config.MinLatency);
+				FParse::Value(*Arg, TEXT("MaxLatency="), Config.MaxLatency);
+				FParse::Value(*Arg, TEXT("ErrorRate="), Config.ErrorRate);
+				FParse::Value(*Arg, TEXT("ErrorCode="), Config.ErrorCode);
+				FParse::Value(*Arg, TEXT("RateLimitRate="), Config.RateLimitRate);
+				FParse::Value(*Arg, TEXT("RetryAfter="), Config.RetryAfter);
+				FParse::Value(*Arg, TEXT("PaddingBytes="), Config.PaddingBytes);
+				FParse::Value(*Arg, TEXT("ExtraDeployments="), Config.ExtraDeployments);
+				FParse::Value(*Arg, TEXT("ReadyDelay="), Config.ReadyDelay);
+				FParse::Value(*Arg, TEXT("TerminateDelay="), Config.TerminateDelay);
+				FParse::Value(*Arg, TEXT("Seed="), Config.Seed);
+			}
+
+			UE_LOG(EdgegapLog, Display, TEXT("MockApi: Latency %.3f-%.3fs, ErrorRate %.2f (%d), RateLimitRate %.2f (Retry-After %.1fs), PaddingBytes %d, ExtraDeployments %d, ReadyDelay %.1fs, TerminateDelay %.1fs, Seed %d"),
+				Config.MinLatency, Config.MaxLatency, Config.ErrorRate, Config.ErrorCode, Config.RateLimitRate, Config.RetryAfter,
+				Config.PaddingBytes, Config.ExtraDeployments, Config.ReadyDelay, Config.TerminateDelay, Config.Seed);
+		}));
+
+	// Deploys Count servers through the batch fan-out, then stops them the same way
+	FAutoConsoleCommand MockBenchDeployCommand(
+		TEXT("Edgegap.Mock.Bench.Deploy"),
+		TEXT("Deploys then stops servers against the mock API and logs throughput, latency and rate limit retries. Optional arguments: count (default 100), concurrency (default BatchDeployConcurrency)."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			if (!EnsureMockRunning())
+			{
+				return;
+			}
+
+			const int32 Count = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100;
+			const int32 Concurrency = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : GetDefault<UEdgegapSettings>()->BatchDeployConcurrency;
+
+			TSharedRef<TArray<double>> Latencies = MakeShared<TArray<double>>();
+			TSharedRef<TArray<FString>> RequestIDs = MakeShared<TArray<FString>>();
+			const int32 RateLimitedBefore = FEdgegapMockApiServer::Get().GetNumRateLimited();
+			const double StartTime = FPlatformTime::Seconds();
+
+			FEdgegapRequestFanOut::Start(Count, Concurrency, [Latencies, RequestIDs](int32 JobIndex, FEdgegapRequestFanOut::FJobDone Done)
+			{
+				const double SentTime = FPlatformTime::Seconds();
+
+				FEdgegapDeploymentRequests::Deploy(TEXT("mock-app"), TEXT("mock-version"), MockAPIKey, { TEXT("127.0.0.1") }, [Latencies, RequestIDs, SentTime, Done](const FEdgegapRequestResult& Result)
+				{
+					Latencies->Add(FPlatformTime::Seconds() - SentTime);
+
+					if (Result.bSucceeded)
+					{
+						RequestIDs->Add(Result.RequestID);
+					}
+
+					Done(Result.bSucceeded, Result.RetryAfter);
+				});
+			}, [Latencies, RequestIDs, RateLimitedBefore, StartTime](int32 NumSucceeded, int32 NumFailed)
+			{
+				LogLatencies(TEXT("Deploy"), *Latencies, FPlatformTime::Seconds() - StartTime);
+				UE_LOG(EdgegapLog, Display, TEXT("MockBench Deploy: %d succeeded, %d failed, %d rate limited responses retried"),
+					NumSucceeded, NumFailed, FEdgegapMockApiServer::Get().GetNumRateLimited() - RateLimitedBefore);
+
+				const double StopStartTime = FPlatformTime::Seconds();
+				FEdgegapDeploymentRequests::StopMany(*RequestIDs, MockAPIKey, [StopStartTime](int32 NumStopped, int32 NumStopFailed)
+				{
+					UE_LOG(EdgegapLog, Display, TEXT("MockBench Stop: %d stopped, %d failed in %.2fs"), NumStopped, NumStopFailed, FPlatformTime::Seconds() - StopStartTime);
+				});
+			});
+		}));
+
+	// Back to back polls, each measured from request to the end of the OnDeploymentsUpdated broadcast,
+	// so with the settings panel open this includes the cost of updating the list
+	FAutoConsoleCommand MockBenchPollCommand(
+		TEXT("Edgegap.Mock.Bench.Poll"),
+		TEXT("Polls v1/deployments back to back against the mock API and logs latency including parsing and UI updates. Optional argument: iterations (default 20). Use Edgegap.Mock.Config ExtraDeployments=N to grow the list."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			if (!EnsureMockRunning())
+			{
+				return;
+			}
+
+			struct FPollBench
+			{
+				int32 Remaining = 0;
+				double StartTime = 0.0;
+				double SentTime = 0.0;
+				TArray<double> Latencies;
+			};
+
+			TSharedRef<FPollBench> Bench = MakeShared<FPollBench>();
+			Bench->Remaining = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 20;
+			Bench->StartTime = FPlatformTime::Seconds();
+
+			TSharedRef<TFunction<void()>> PollNext = MakeShared<TFunction<void()>>();
+			*PollNext = [Bench, WeakPollNext = TWeakPtr<TFunction<void()>>(PollNext)]()
+			{
+				Bench->SentTime = FPlatformTime::Seconds();
+
+				FEdgegapDeploymentPoller::Get().PollNow(MockAPIKey, FSimpleDelegate::CreateLambda([Bench, WeakPollNext]()
+				{
+					Bench->Latencies.Add(FPlatformTime::Seconds() - Bench->SentTime);
+
+					TSharedPtr<TFunction<void()>> PollNext = WeakPollNext.Pin();
+					if (--Bench->Remaining > 0 && PollNext.IsValid())
+					{
+						(*PollNext)();
+						return;
+					}
+
+					LogLatencies(TEXT("Poll"), Bench->Latencies, FPlatformTime::Seconds() - Bench->StartTime);
+				}));
+			};
+
+			// The completion delegates only hold a weak reference, this keeps the chain alive until the last poll
+			FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Bench, PollNext](float DeltaTime)
+			{
+				return Bench->Remaining > 0;
+			}), 0.5f);
+
+			(*PollNext)();
+		}));
+}
@@ -0,0 +1,510 @@
+#include "EdgegapMockApiServer.h"
+#include "EdgegapSettings.h"
+#include "EdgegapSettingsDetails.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "HttpPath.h"
+#include "IHttpRouter.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	FString GetBodyAsString(const FHttpServerRequest& Request)
+	{
+		FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Request.Body.GetData()), Request.Body.Num());
+		return FString(Converted.Length(), Converted.Get());
+	}
+
+	TSharedPtr<FJsonObject> GetBodyAsJson(const FHttpServerRequest& Request)
+	{
+		TSharedPtr<FJsonObject> JsonObject;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(GetBodyAsString(Request));
+		FJsonSerializer::Deserialize(Reader, JsonObject);
+		return JsonObject;
+	}
+}
+
+FEdgegapMockApiServer& FEdgegapMockApiServer::Get()
+{
+	static FEdgegapMockApiServer Instance;
+	return Instance;
+}
+
+bool FEdgegapMockApiServer::Start(uint32 InPort)
+{
+	if (IsRunning())
+	{
+		return Port == InPort;
+	}
+
+	Router = FHttpServerModule::Get().GetHttpRouter(InPort, /* bFailOnBindFailure */ true);
+	if (!Router.IsValid())
+	{
+		UE_LOG(EdgegapLog, Error, TEXT("MockApi: Could not listen on port %u"), InPort);
+		return false;
+	}
+
+	Port = InPort;
+	Reset();
+
+	BindRoute(TEXT("/v1/deploy"), EHttpServerRequestVerbs::VERB_POST, [this](const FHttpServerRequest& Request) { return HandleDeploy(Request); });
+	BindRoute(TEXT("/v1/deployments"), EHttpServerRequestVerbs::VERB_GET, [this](const FHttpServerRequest& Request) { return HandleListDeployments(Request); });
+	BindRoute(TEXT("/v1/stop/:request_id"), EHttpServerRequestVerbs::VERB_DELETE, [this](const FHttpServerRequest& Request) { return HandleStop(Request); });
+	BindRoute(TEXT("/v1/status/:request_id"), EHttpServerRequestVerbs::VERB_GET, [this](const FHttpServerRequest& Request) { return HandleStatus(Request); });
+	BindRoute(TEXT("/v1/deployment/:request_id/container-logs"), EHttpServerRequestVerbs::VERB_GET, [this](const FHttpServerRequest& Request) { return HandleContainerLogs(Request); });
+	BindRoute(TEXT("/v1/app"), EHttpServerRequestVerbs::VERB_POST, [this](const FHttpServerRequest& Request) { return HandleCreateApp(Request); });
+	BindRoute(TEXT("/v1/app/:app_name/version"), EHttpServerRequestVerbs::VERB_POST, [this](const FHttpServerRequest& Request) { return HandleCreateVersion(Request); });
+	BindRoute(TEXT("/v1/wizard/init-quick-start"), EHttpServerRequestVerbs::VERB_POST, [this](const FHttpServerRequest& Request) { return HandleQuickStart(Request); });
+	BindRoute(TEXT("/v1/wizard/registry-credentials"), EHttpServerRequestVerbs::VERB_GET, [this](const FHttpServerRequest& Request) { return HandleRegistryCredentials(Request); });
+	BindRoute(TEXT("/ip"), EHttpServerRequestVerbs::VERB_GET, [this](const FHttpServerRequest& Request) { return HandlePublicIP(Request); });
+
+	FHttpServerModule::Get().StartAllListeners();
+
+	UEdgegapSettings::SetSessionOverride(GetBaseURL(), GetBaseURL() + TEXT("ip"));
+
+	// Optional, deployments just don't list an echo port without it
+	Echo.Start(Port + 1);
+
+	UE_LOG(EdgegapLog, Log, TEXT("MockApi: Serving the Edgegap API on %s"), *GetBaseURL());
+
+	return true;
+}
+
+void FEdgegapMockApiServer::Stop()
+{
+	if (!IsRunning())
+	{
+		return;
+	}
+
+	for (const FHttpRouteHandle& RouteHandle : RouteHandles)
+	{
+		Router->UnbindRoute(RouteHandle);
+	}
+
+	RouteHandles.Empty();
+	Router.Reset();
+	Echo.Stop();
+
+	UEdgegapSettings::SetSessionOverride(FString(), FString());
+
+	// Releases the port, so the next Start (or another process) can bind it. The engine only stops listeners all at
+	// once, whatever else serves HTTP in this editor comes back with the next StartAllListeners.
+	FHttpServerModule::Get().StopAllListeners();
+
+	UE_LOG(EdgegapLog, Log, TEXT("MockApi: Stopped after %d requests (%d injected errors, %d rate limited)"), NumRequests, NumInjectedErrors, NumRateLimited);
+}
+
+FString FEdgegapMockApiServer::GetBaseURL() const
+{
+	return FString::Printf(TEXT("http://localhost:%u/"), Port);
+}
+
+void FEdgegapMockApiServer::Reset()
+{
+	Random.Initialize(Config.Seed);
+	Deployments.Empty();
+	NextDeploymentIndex = 0;
+	NumRequests = 0;
+	NumInjectedErrors = 0;
+	NumRateLimited = 0;
+}
+
+void FEdgegapMockApiServer::BindRoute(const FString& Path, EHttpServerRequestVerbs Verb, FMockHandler Handler)
+{
+	FHttpRouteHandle RouteHandle = Router->BindRoute(FHttpPath(Path), Verb, FHttpRequestHandler::CreateLambda([this, Handler](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+	{
+		++NumRequests;
+
+		// Injected faults come first, like a gateway in front of the real API would
+		if (Config.RateLimitRate > 0.0f && Random.FRand() < Config.RateLimitRate)
+		{
+			++NumRateLimited;
+
+			FMockResponse Response;
+			Response.Code = 429;
+			Response.Body = TEXT("{\"message\":\"Too many requests\"}");
+			Response.Headers.Add(TEXT("Retry-After"), FString::SanitizeFloat(Config.RetryAfter));
+			Respond(OnComplete, MoveTemp(Response));
+			return true;
+		}
+
+		if (Config.ErrorRate > 0.0f && Random.FRand() < Config.ErrorRate)
+		{
+			++NumInjectedErrors;
+
+			FMockResponse Response;
+			Response.Code = Config.ErrorCode;
+			Response.Body = TEXT("{\"message\":\"Injected error\"}");
+			Respond(OnComplete, MoveTemp(Response));
+			return true;
+		}
+
+		UpdateLifecycle();
+		Respond(OnComplete, Handler(Request));
+		return true;
+	}));
+
+	if (RouteHandle.IsValid())
+	{
+		RouteHandles.Add(RouteHandle);
+	}
+	else
+	{
+		UE_LOG(EdgegapLog, Warning, TEXT("MockApi: Could not bind %s"), *Path);
+	}
+}
+
+void FEdgegapMockApiServer::Respond(const FHttpResultCallback& OnComplete, FMockResponse Response)
+{
+	auto Send = [OnComplete](const FMockResponse& Response)
+	{
+		TUniquePtr<FHttpServerResponse> ServerResponse = FHttpServerResponse::Create(Response.Body, TEXT("application/json"));
+		ServerResponse->Code = static_cast<EHttpServerResponseCodes>(Response.Code);
+
+		for (const TPair<FString, FString>& Header : Response.Headers)
+		{
+			ServerResponse->Headers.Add(Header.Key, { Header.Value });
+		}
+
+		OnComplete(MoveTemp(ServerResponse));
+	};
+
+	const float Latency = Config.MaxLatency > Config.MinLatency ? Random.FRandRange(Config.MinLatency, Config.MaxLatency) : Config.MinLatency;
+
+	if (Latency <= 0.0f)
+	{
+		Send(Response);
+		return;
+	}
+
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Send, Response](float DeltaTime)
+	{
+		Send(Response);
+		return false;
+	}), Latency);
+}
+
+FEdgegapMockApiServer::FMockResponse FEdgegapMockApiServer::MakeJsonResponse(int32 Code, TSharedRef<FJsonObject> JsonObject)
+{
+	if (Config.PaddingBytes > 0)
+	{
+		JsonObject->SetStringField(TEXT("padding"), FString::ChrN(Config.PaddingBytes, TEXT('x')));
+	}
+
+	FMockResponse Response;
+	Response.Code = Code;
+
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Response.Body);
+	FJsonSerializer::Serialize(JsonObject, JsonWriter);
+
+	return Response;
+}
+
+void FEdgegapMockApiServer::UpdateLifecycle()
+{
+	const double Now = FPlatformTime::Seconds();
+
+	for (auto It = Deployments.CreateIterator(); It; ++It)
+	{
+		if (It->Value.StopTime > 0.0 && Now - It->Value.StopTime > Config.TerminateDelay)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+TSharedRef<FJsonObject> FEdgegapMockApiServer::MakeDeploymentJson(const FString& RequestID, const FMockDeployment& Deployment) const
+{
+	const double Now = FPlatformTime::Seconds();
+	const bool bReady = Deployment.StopTime <= 0.0 && Now - Deployment.CreatedTime >= Config.ReadyDelay;
+
+	// Walks the same statuses as the real API on the way up, so phase timings can be tried offline
+	const double Progress = Config.ReadyDelay > 0.0f ? (Now - Deployment.CreatedTime) / Config.ReadyDelay : 1.0;
+
+	FString Status = TEXT("Status.DEPLOYING");
+	if (Progress < 0.1)
+	{
+		Status = TEXT("Status.INITIALIZING");
+	}
+	else if (Progress < 0.2)
+	{
+		Status = TEXT("Status.SEEKING");
+	}
+	else if (Progress < 0.3)
+	{
+		Status = TEXT("Status.SEEKED");
+	}
+
+	if (Deployment.StopTime > 0.0)
+	{
+		Status = TEXT("Status.TERMINATING");
+	}
+	else if (bReady)
+	{
+		Status = TEXT("Status.READY");
+	}
+
+	const int32 GamePort = 30000 + (GetTypeHash(RequestID) % 10000);
+
+	TSharedRef<FJsonObject> GamePortObject = MakeShared<FJsonObject>();
+	GamePortObject->SetNumberField(TEXT("external"), GamePort);
+	GamePortObject->SetNumberField(TEXT("internal"), 7777);
+	GamePortObject->SetStringField(TEXT("protocol"), TEXT("UDP"));
+	GamePortObject->SetStringField(TEXT("link"), FString::Printf(TEXT("%s.mock.edgegap.net:%d"), *RequestID, GamePort));
+
+	TSharedRef<FJsonObject> PortsObject = MakeShared<FJsonObject>();
+	PortsObject->SetObjectField(TEXT("gameport"), GamePortObject);
+
+	if (Echo.IsRunning())
+	{
+		TSharedRef<FJsonObject> EchoPortObject = MakeShared<FJsonObject>();
+		EchoPortObject->SetNumberField(TEXT("external"), Echo.GetPort());
+		EchoPortObject->SetNumberField(TEXT("internal"), FEdgegapLatencyEcho::DefaultPort);
+		EchoPortObject->SetStringField(TEXT("protocol"), TEXT("UDP"));
+		PortsObject->SetObjectField(TEXT("echo"), EchoPortObject);
+	}
+
+	struct FMockLocation
+	{
+		const TCHAR* City;
+		const TCHAR* Country;
+		const TCHAR* Continent;
+		double Latitude;
+		double Longitude;
+	};
+
+	// Spread over a few locations so the list has something to sort on
+	static const FMockLocation Locations[] = {
+		{ TEXT("Montreal"), TEXT("Canada"), TEXT("North America"), 45.5, -73.57 },
+		{ TEXT("Frankfurt"), TEXT("Germany"), TEXT("Europe"), 50.11, 8.68 },
+		{ TEXT("Tokyo"), TEXT("Japan"), TEXT("Asia"), 35.68, 139.69 },
+		{ TEXT("Sao Paulo"), TEXT("Brazil"), TEXT("South America"), -23.55, -46.63 },
+	};
+	const FMockLocation& MockLocation = Locations[GetTypeHash(RequestID) % UE_ARRAY_COUNT(Locations)];
+
+	TSharedRef<FJsonObject> LocationObject = MakeShared<FJsonObject>();
+	LocationObject->SetStringField(TEXT("city"), MockLocation.City);
+	LocationObject->SetStringField(TEXT("country"), MockLocation.Country);
+	LocationObject->SetStringField(TEXT("continent"), MockLocation.Continent);
+	LocationObject->SetNumberField(TEXT("latitude"), MockLocation.Latitude);
+	LocationObject->SetNumberField(TEXT("longitude"), MockLocation.Longitude);
+
+	TSharedRef<FJsonObject> DeploymentObject = MakeShared<FJsonObject>();
+	DeploymentObject->SetStringField(TEXT("request_id"), RequestID);
+	DeploymentObject->SetStringField(TEXT("status"), Status);
+	DeploymentObject->SetBoolField(TEXT("ready"), bReady);
+	DeploymentObject->SetStringField(TEXT("public_ip"), TEXT("127.0.0.1"));
+	DeploymentObject->SetStringField(TEXT("app_name"), Deployment.AppName);
+	DeploymentObject->SetStringField(TEXT("app_version"), Deployment.AppVersion);
+	DeploymentObject->SetObjectField(TEXT("ports"), PortsObject);
+	DeploymentObject->SetStringField(TEXT("start_time"), (FDateTime::UtcNow() - FTimespan::FromSeconds(Now - Deployment.CreatedTime)).ToIso8601());
+	DeploymentObject->SetObjectField(TEXT("location"), LocationObject);
+
+	return DeploymentObject;
+}
+
+FEdgegapMockApiServer::FMockResponse FEdgegapMockApiServer::HandleDeploy(const FHttpServerRequest& Request)
+{
+	TSharedPtr<FJsonObject> Body = GetBodyAsJson(Request);
+
+	TSharedRef<FJsonObject> ResponseObject = MakeShared<FJsonObject>();
+
+	FMockDeployment Deployment;
+	if (!Body.IsValid() || !Body->TryGetStringField(TEXT("app_name"), Deployment.AppName) || !Body->TryGetStringField(TEXT("version_name"), Deployment.AppVersion))
+	{
+		ResponseObject->SetStringField(TEXT("message"), TEXT("app_name and version_name are required"));
+		return MakeJsonResponse(400, ResponseObject);
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* IPList = nullptr;
+	if (Body->TryGetArrayField(TEXT("ip_list"), IPList) && IPList->Num() > 0)
+	{
+		Deployment.PublicIP = (*IPList)[0]->AsString();
+	}
+
+	Deployment.CreatedTime = FPlatformTime::Seconds();
+
+	const FString RequestID = FString::Printf(TEXT("mock%08x"), NextDeploymentIndex++);
+	Deployments.Add(RequestID, Deployment);
+
+	ResponseObject->SetStringField(TEXT("request_id"), RequestID);
+	ResponseObject->SetStringField(TEXT("request_dns"), FString::Printf(TEXT("%s.mock.edgegap.net"), *RequestID));
+	ResponseObject->SetStringField(TEXT("request_app"), Deployment.AppName);
+	ResponseObject->SetStringField(TEXT("request_version"), Deployment.AppVersion);
+	ResponseObject->SetNumberField(TEXT("request_user_count"), 1);
+
+	return MakeJsonResponse(200, ResponseObject);
+}
+
+FEdgegapMockApiServer::FMockResponse FEdgegapMockApiServer::HandleListDeployments(const FHttpServerRequest& Request)
+{
+	TArray<TSharedPtr<FJsonValue>> Data;
+	Data.Reserve(Deployments.Num() + Config.ExtraDeployments);
+
+	for (const TPair<FString, FMockDeployment>& Pair : Deployments)
+	{
+		Data.Add(MakeShared<FJsonValueObject>(MakeDeploymentJson(Pair.Key, Pair.Value)));
+	}
+
+	FMockDeployment Extra;
+	Extra.AppName = TEXT("mock-app");
+	Extra.AppVersion = TEXT("extra");
+
+	for (int32 Index = 0; Index < Config.ExtraDeployments; ++Index)
+	{
+		Data.Add(MakeShared<FJsonValueObject>(MakeDeploymentJson(FString::Printf(TEXT("extra%07d"), Index), Extra)));
+	}
+
+	TSharedRef<FJsonObject> ResponseObject = MakeShared<FJsonObject>();
+	ResponseObject->SetArrayField(TEXT("data"), Data);
+	ResponseObject->SetNumberField(TEXT("total_count"), Data.Num());
+
+	return MakeJsonResponse(200, ResponseObject);
+}
+
+FEdgegapMockApiServer::FMockResponse FEdgegapMockApiServer::HandleStop(const FHttpServerRequest& Request)
+{
+	const FString RequestID = Request.PathParams.FindRef(TEXT("request_id"));
+
+	TSharedRef<FJsonObject> ResponseObject = MakeShared<FJsonObject>();
+
+	FMockDeployment* Deployment = Deployments.Find(RequestID);
+	if (!Deployment || Deployment->StopTime > 0.0)
+	{
+		ResponseObject->SetStringField(TEXT("message"), FString::Printf(TEXT("Deployment %s not found"), *RequestID));
+		return MakeJsonResponse(404, ResponseObject);
+	}
+
+	Deployment->StopTime = FPlatformTime::Seconds();
+
+	ResponseObject->SetStringField(TEXT("message"), TEXT("Deployment Stopped"));
+	ResponseObject->SetObjectField(TEXT("deployment_summary"), MakeDeploymentJson(RequestID, *Deployment));
+
+	return MakeJsonResponse(200, ResponseObject);
+}
+
+FEdgegapMockApiServer::FMockResponse FEdgegapMockApiServer::HandleStatus(const FHttpServerRequest& Request)
+{
+	const FString RequestID = Request.PathParams.FindRef(TEXT("request_id"));
+
+	const FMockDeployment* Deployment = Deployments.Find(RequestID);
+	if (!Deployment)
+	{
+		TSharedRef<FJsonObject> ErrorObject = MakeShared<FJsonObject>();
+		ErrorObject->SetStringField(TEXT("message"), FString::Printf(TEXT("Deployment %s not found"), *RequestID));
+		return MakeJsonResponse(404, ErrorObject);
+	}
+
+	TSharedRef<FJsonObject> StatusObject = MakeDeploymentJson(RequestID, *Deployment);
+
+	const double Elapsed = FPlatformTime::Seconds() - Deployment->CreatedTime;
+
+	StatusObject->SetStringField(TEXT("current_status"), StatusObject->GetStringField(TEXT("status")));
+	StatusObject->SetBoolField(TEXT("running"), StatusObject->GetBoolField(TEXT("ready")));
+	StatusObject->SetStringField(TEXT("fqdn"), FString::Printf(TEXT("%s.mock.edgegap.net"), *RequestID));
+	StatusObject->SetNumberField(TEXT("elapsed_time"), FMath::FloorToInt(Elapsed));
+	StatusObject->SetArrayField(TEXT("tags"), { MakeShared<FJsonValueString>(TEXT("mock")) });
+	StatusObject->SetBoolField(TEXT("error"), false);
+
+	return MakeJsonResponse(200, StatusObject);
+}
+
+FEdgegapMockApiServer::FMockResponse FEdgegapMockApiServer::HandleContainerLogs(const FHttpServerRequest& Request)
+{
+	const FString RequestID = Request.PathParams.FindRef(TEXT("request_id"));
+
+	const FMockDeployment* Deployment = Deployments.Find(RequestID);
+	if (!Deployment)
+	{
+		TSharedRef<FJsonObject> ErrorObject = MakeShared<FJsonObject>();
+		ErrorObject->SetStringField(TEXT("message"), FString::Printf(TEXT("Deployment %s not found"), *RequestID));
+		return MakeJsonResponse(404, ErrorObject);
+	}
+
+	// Like the real endpoint, the whole log every time: a line every 100ms since the deployment was created
+	const int32 NumLines = FMath::Min(FMath::FloorToInt((FPlatformTime::Seconds() - Deployment->CreatedTime) * 10.0), 100000);
+
+	FString Logs;
+	Logs.Reserve(NumLines * 64);
+	for (int32 Index = 0; Index < NumLines; ++Index)
+	{
+		Logs += FString::Printf(TEXT("[%08.1f] LogMockServer: %s %s line %d\n"), Index * 0.1, Index % 10 == 0 ? TEXT("Warning:") : TEXT("Display:"), *RequestID, Index);
+	}
+
+	TSharedRef<FJsonObject> LogsObject = MakeShared<FJsonObject>();
+	LogsObject->SetStringField(TEXT("logs"), Logs);
+	LogsObject->SetStringField(TEXT("encoding"), TEXT("UTF-8"));
+	return MakeJsonResponse(200, LogsObject);
+}
+
+FEdgegapMockApiServer::FMockResponse FEdgegapMockApiServer::HandleCreateApp(const FHttpServerRequest& Request)
+{
+	TSharedPtr<FJsonObject> Body = GetBodyAsJson(Request);
+
+	FString AppName;
+	if (!Body.IsValid() || !Body->TryGetStringField(TEXT("name"), AppName))
+	{
+		TSharedRef<FJsonObject> ErrorObject = MakeShared<FJsonObject>();
+		ErrorObject->SetStringField(TEXT("message"), TEXT("name is required"));
+		return MakeJsonResponse(400, ErrorObject);
+	}
+
+	TSharedRef<FJsonObject> ResponseObject = MakeShared<FJsonObject>();
+	ResponseObject->SetStringField(TEXT("name"), AppName);
+	ResponseObject->SetBoolField(TEXT("is_active"), true);
+	ResponseObject->SetStringField(TEXT("create_time"), FDateTime::UtcNow().ToIso8601());
+
+	return MakeJsonResponse(200, ResponseObject);
+}
+
+FEdgegapMockApiServer::FMockResponse FEdgegapMockApiServer::HandleCreateVersion(const FHttpServerRequest& Request)
+{
+	TSharedPtr<FJsonObject> Body = GetBodyAsJson(Request);
+
+	FString VersionName;
+	if (!Body.IsValid() || !Body->TryGetStringField(TEXT("name"), VersionName))
+	{
+		TSharedRef<FJsonObject> ErrorObject = MakeShared<FJsonObject>();
+		ErrorObject->SetStringField(TEXT("message"), TEXT("name is required"));
+		return MakeJsonResponse(400, ErrorObject);
+	}
+
+	TSharedRef<FJsonObject> VersionObject = MakeShared<FJsonObject>();
+	VersionObject->SetStringField(TEXT("name"), VersionName);
+
+	TSharedRef<FJsonObject> ResponseObject = MakeShared<FJsonObject>();
+	ResponseObject->SetBoolField(TEXT("success"), true);
+	ResponseObject->SetObjectField(TEXT("version"), VersionObject);
+
+	return MakeJsonResponse(200, ResponseObject);
+}
+
+FEdgegapMockApiServer::FMockResponse FEdgegapMockApiServer::HandleQuickStart(const FHttpServerRequest& Request)
+{
+	FMockResponse Response;
+	Response.Code = 204;
+	return Response;
+}
+
+FEdgegapMockApiServer::FMockResponse FEdgegapMockApiServer::HandleRegistryCredentials(const FHttpServerRequest& Request)
+{
+	TSharedRef<FJsonObject> ResponseObject = MakeShared<FJsonObject>();
+	ResponseObject->SetStringField(TEXT("registry_url"), FString::Printf(TEXT("localhost:%u"), Port));
+	ResponseObject->SetStringField(TEXT("project"), TEXT("mock-project"));
+	ResponseObject->SetStringField(TEXT("username"), TEXT("mock-user"));
+	ResponseObject->SetStringField(TEXT("token"), TEXT("mock-token"));
+
+	return MakeJsonResponse(200, ResponseObject);
+}
+
+FEdgegapMockApiServer::FMockResponse FEdgegapMockApiServer::HandlePublicIP(const FHttpServerRequest& Request)
+{
+	FMockResponse Response;
+	Response.Body = TEXT("127.0.0.1");
+	return Response;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HttpRouteHandle.h"
+#include "HttpResultCallback.h"
+#include "HttpServerConstants.h"
+#include "EdgegapLatencyEcho.h"
+
+class IHttpRouter;
+struct FHttpServerRequest;
+
+/** Fault injection for the mock API, editable at runtime through Edgegap.Mock.Config */
+struct FEdgegapMockApiConfig
+{
+	// Every response is delayed by a random time in this range
+	float MinLatency = 0.0f;
+	float MaxLatency = 0.0f;
+
+	// Share of requests answered with ErrorCode instead of being handled
+	float ErrorRate = 0.0f;
+	int32 ErrorCode = 500;
+
+	// Share of requests answered with a 429 and Retry-After
+	float RateLimitRate = 0.0f;
+	float RetryAfter = 1.0f;
+
+	// Bytes of filler added to every JSON response
+	int32 PaddingBytes = 0;
+
+	// Ready deployments v1/deployments lists on top of the ones deployed against the mock
+	int32 ExtraDeployments = 0;
+
+	// Simulated deployment lifecycle
+	float ReadyDelay = 2.0f;
+	float TerminateDelay = 2.0f;
+
+	// Seeds the injection so a run can be reproduced
+	int32 Seed = 0;
+};
+
+/**
+ * In-process stand-in for the Edgegap API, served on localhost through the engine's HTTP server.
+ *
+ * Implements the endpoints the plugin calls with a simulated deployment lifecycle. While it runs, it is set as
+ * UEdgegapSettings' session override, so every request goes to it and the plugin can be exercised offline.
+ * Deployments expose an "echo" port answered on localhost, one above the API port, for the latency probe.
+ */
+class FEdgegapMockApiServer
+{
+public:
+	static FEdgegapMockApiServer& Get();
+
+	bool Start(uint32 InPort = 8089);
+	void Stop();
+
+	bool IsRunning() const { return Router.IsValid(); }
+
+	/** e.g. http://localhost:8089/, with the trailing slash the request code expects */
+	FString GetBaseURL() const;
+
+	FEdgegapMockApiConfig& GetConfig() { return Config; }
+
+	/** Drops every simulated deployment and restarts the injection from the seed */
+	void Reset();
+
+	int32 GetNumRequests() const { return NumRequests; }
+	int32 GetNumInjectedErrors() const { return NumInjectedErrors; }
+	int32 GetNumRateLimited() const { return NumRateLimited; }
+
+private:
+	struct FMockResponse
+	{
+		int32 Code = 200;
+		FString Body;
+		TMap<FString, FString> Headers;
+	};
+
+	struct FMockDeployment
+	{
+		FString AppName;
+		FString AppVersion;
+		FString PublicIP;
+		double CreatedTime = 0.0;
+		double StopTime = 0.0;
+	};
+
+	typedef TFunction<FMockResponse(const FHttpServerRequest&)> FMockHandler;
+
+	void BindRoute(const FString& Path, EHttpServerRequestVerbs Verb, FMockHandler Handler);
+	void Respond(const FHttpResultCallback& OnComplete, FMockResponse Response);
+	FMockResponse MakeJsonResponse(int32 Code, TSharedRef<class FJsonObject> JsonObject);
+
+	FMockResponse HandleDeploy(const FHttpServerRequest& Request);
+	FMockResponse HandleListDeployments(const FHttpServerRequest& Request);
+	FMockResponse HandleStop(const FHttpServerRequest& Request);
+	FMockResponse HandleStatus(const FHttpServerRequest& Request);
+	FMockResponse HandleContainerLogs(const FHttpServerRequest& Request);
+	FMockResponse HandleCreateApp(const FHttpServerRequest& Request);
+	FMockResponse HandleCreateVersion(const FHttpServerRequest& Request);
+	FMockResponse HandleQuickStart(const FHttpServerRequest& Request);
+	FMockResponse HandleRegistryCredentials(const FHttpServerRequest& Request);
+	FMockResponse HandlePublicIP(const FHttpServerRequest& Request);
+
+	void UpdateLifecycle();
+	TSharedRef<class FJsonObject> MakeDeploymentJson(const FString& RequestID, const FMockDeployment& Deployment) const;
+
+	TSharedPtr<IHttpRouter> Router;
+	TArray<FHttpRouteHandle> RouteHandles;
+	uint32 Port = 0;
+
+	FEdgegapLatencyEcho Echo;
+
+	FEdgegapMockApiConfig Config;
+	FRandomStream Random;
+
+	TMap<FString, FMockDeployment> Deployments;
+	int32 NextDeploymentIndex = 0;
+
+	int32 NumRequests = 0;
+	int32 NumInjectedErrors = 0;
+	int32 NumRateLimited = 0;
+};
@@ -0,0 +1,364 @@
+#include "EdgegapMockApiServer.h"
+#include "EdgegapSettingsDetails.h"
+#include "Deployments/EdgegapDeploymentPoller.h"
+#include "Deployments/EdgegapDeploymentRequests.h"
+#include "Deployments/EdgegapRequestFanOut.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Automation tests running the plugin's request code against the mock API, under Edgegap.MockApi in the
+// Session Frontend. A mock already started from the console is reused and gets its config back afterwards,
+// but loses its deployments. Other pollers may hit the mock meanwhile, so request counts are not exact.
+
+namespace
+{
+	const TCHAR* MockAPIKey = TEXT("token mock");
+	const uint32 MockTestPort = 8089;
+
+	struct FMockTestState
+	{
+		bool bStartedMock = false;
+		FEdgegapMockApiConfig PreviousConfig;
+	};
+
+	/** Points the plugin at the mock with a test's config, EndMockTest puts things back once the test's latent commands ran */
+	bool BeginMockTest(FAutomationTestBase& Test, const FEdgegapMockApiConfig& TestConfig, FMockTestState& OutState)
+	{
+		FEdgegapMockApiServer& Mock = FEdgegapMockApiServer::Get();
+
+		OutState.bStartedMock = !Mock.IsRunning();
+		if (OutState.bStartedMock && !Mock.Start(MockTestPort))
+		{
+			Test.AddError(FString::Printf(TEXT("Could not start the mock API on port %u"), MockTestPort));
+			return false;
+		}
+
+		OutState.PreviousConfig = Mock.GetConfig();
+		Mock.GetConfig() = TestConfig;
+		Mock.Reset();
+
+		return true;
+	}
+
+	void EndMockTest(const FMockTestState& State)
+	{
+		ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([State]()
+		{
+			FEdgegapMockApiServer& Mock = FEdgegapMockApiServer::Get();
+			Mock.GetConfig() = State.PreviousConfig;
+			Mock.Reset();
+
+			if (State.bStartedMock)
+			{
+				Mock.Stop();
+			}
+			return true;
+		}));
+	}
+
+	void WaitUntil(FAutomationTestBase& Test, const FString& What, float Timeout, TFunction<bool()> Condition)
+	{
+		ADD_LATENT_AUTOMATION_COMMAND(FUntilCommand(MoveTemp(Condition), [&Test, What]()
+		{
+			Test.AddError(FString::Printf(TEXT("Timed out waiting for %s"), *What));
+			return true;
+		}, Timeout));
+	}
+
+	/** Polls back to back through the shared poller until Condition holds on the polled list */
+	void PollUntil(FAutomationTestBase& Test, const FString& What, float Timeout, TFunction<bool(const TArray<TSharedPtr<FDeploymentStatusListItem>>&)> Condition)
+	{
+		struct FPollState
+		{
+			bool bInFlight = false;
+			bool bDone = false;
+		};
+
+		TSharedRef<FPollState> State = MakeShared<FPollState>();
+
+		WaitUntil(Test, What, Timeout, [State, Condition]()
+		{
+			if (!State->bInFlight && !State->bDone)
+			{
+				State->bInFlight = true;
+
+				FEdgegapDeploymentPoller::Get().PollNow(MockAPIKey, FSimpleDelegate::CreateLambda([State, Condition]()
+				{
+					State->bInFlight = false;
+					State->bDone = Condition(FEdgegapDeploymentPoller::Get().GetDeployments());
+				}));
+			}
+
+			return State->bDone;
+		});
+	}
+
+	TSharedPtr<FDeploymentStatusListItem> FindDeployment(const TArray<TSharedPtr<FDeploymentStatusListItem>>& Deployments, const FString& RequestID)
+	{
+		const TSharedPtr<FDeploymentStatusListItem>* Found = Deployments.FindByPredicate([&RequestID](const TSharedPtr<FDeploymentStatusListItem>& Deployment)
+		{
+			return Deployment->RequestID == RequestID;
+		});
+
+		return Found ? *Found : nullptr;
+	}
+
+	/** Deploys once, OutResult is set when the request finished */
+	void Deploy(TSharedRef<TOptional<FEdgegapRequestResult>> OutResult)
+	{
+		FEdgegapDeploymentRequests::Deploy(TEXT("mock-app"), TEXT("mock-version"), MockAPIKey, { TEXT("127.0.0.1") }, [OutResult](const FEdgegapRequestResult& Result)
+		{
+			*OutResult = Result;
+		});
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEdgegapMockApiDeployTest, "Edgegap.MockApi.Deploy", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FEdgegapMockApiDeployTest::RunTest(const FString& Parameters)
+{
+	FMockTestState MockState;
+	if (!BeginMockTest(*this, FEdgegapMockApiConfig(), MockState))
+	{
+		return false;
+	}
+
+	TSharedRef<TOptional<FEdgegapRequestResult>> Result = MakeShared<TOptional<FEdgegapRequestResult>>();
+	Deploy(Result);
+
+	WaitUntil(*this, TEXT("the deploy request"), 10.0f, [Result]() { return Result->IsSet(); });
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Result]()
+	{
+		if (Result->IsSet())
+		{
+			TestTrue(TEXT("Deploy succeeded"), Result->GetValue().bSucceeded);
+			TestFalse(TEXT("Deploy returned a request ID"), Result->GetValue().RequestID.IsEmpty());
+		}
+		return true;
+	}));
+
+	EndMockTest(MockState);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEdgegapMockApiPollLifecycleTest, "Edgegap.MockApi.PollLifecycle", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FEdgegapMockApiPollLifecycleTest::RunTest(const FString& Parameters)
+{
+	FEdgegapMockApiConfig Config;
+	Config.ReadyDelay = 2.0f;
+
+	FMockTestState MockState;
+	if (!BeginMockTest(*this, Config, MockState))
+	{
+		return false;
+	}
+
+	TSharedRef<TOptional<FEdgegapRequestResult>> Result = MakeShared<TOptional<FEdgegapRequestResult>>();
+	Deploy(Result);
+
+	WaitUntil(*this, TEXT("the deploy request"), 10.0f, [Result]() { return Result->IsSet(); });
+
+	TSharedRef<bool> bSawTransitioning = MakeShared<bool>(false);
+
+	PollUntil(*this, TEXT("the deployment to be ready"), 15.0f, [Result, bSawTransitioning](const TArray<TSharedPtr<FDeploymentStatusListItem>>& Deployments)
+	{
+		const TSharedPtr<FDeploymentStatusListItem> Deployment = Result->IsSet() ? FindDeployment(Deployments, Result->GetValue().RequestID) : nullptr;
+		if (!Deployment.IsValid())
+		{
+			return false;
+		}
+
+		*bSawTransitioning |= Deployment->IsTransitioning();
+		return Deployment->DeploymentReady;
+	});
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Result, bSawTransitioning]()
+	{
+		const TSharedPtr<FDeploymentStatusListItem> Deployment = Result->IsSet() ? FindDeployment(FEdgegapDeploymentPoller::Get().GetDeployments(), Result->GetValue().RequestID) : nullptr;
+
+		TestTrue(TEXT("Deployment was listed while on its way to ready"), *bSawTransitioning);
+		if (TestTrue(TEXT("Deployment is listed"), Deployment.IsValid()))
+		{
+			TestTrue(TEXT("Deployment is ready"), Deployment->DeploymentReady);
+			TestEqual(TEXT("Deployment status"), Deployment->DeploymentStatus, FString(TEXT("Status.READY")));
+		}
+		return true;
+	}));
+
+	EndMockTest(MockState);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEdgegapMockApiRetryAfterTest, "Edgegap.MockApi.RetryAfter", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FEdgegapMockApiRetryAfterTest::RunTest(const FString& Parameters)
+{
+	FEdgegapMockApiConfig Config;
+	Config.RateLimitRate = 1.0f;
+	Config.RetryAfter = 1.0f;
+
+	FMockTestState MockState;
+	if (!BeginMockTest(*this, Config, MockState))
+	{
+		return false;
+	}
+
+	struct FRetryState
+	{
+		TArray<double> SentTimes;
+		double RateLimitedTime = 0.0;
+		double RetryAfter = 0.0;
+		bool bFinished = false;
+		int32 NumSucceeded = 0;
+	};
+
+	TSharedRef<FRetryState> State = MakeShared<FRetryState>();
+
+	FEdgegapRequestFanOut::Start(1, 1, [State](int32 JobIndex, FEdgegapRequestFanOut::FJobDone Done)
+	{
+		State->SentTimes.Add(FPlatformTime::Seconds());
+
+		FEdgegapDeploymentRequests::Deploy(TEXT("mock-app"), TEXT("mock-version"), MockAPIKey, { TEXT("127.0.0.1") }, [State, Done](const FEdgegapRequestResult& Result)
+		{
+			if (Result.RetryAfter > 0.0 && State->RateLimitedTime == 0.0)
+			{
+				State->RateLimitedTime = FPlatformTime::Seconds();
+				State->RetryAfter = Result.RetryAfter;
+
+				// Lets the retry through
+				FEdgegapMockApiServer::Get().GetConfig().RateLimitRate = 0.0f;
+			}
+
+			Done(Result.bSucceeded, Result.RetryAfter);
+		});
+	}, [State](int32 NumSucceeded, int32 NumFailed)
+	{
+		State->bFinished = true;
+		State->NumSucceeded = NumSucceeded;
+	});
+
+	WaitUntil(*this, TEXT("the rate limited deploy to be retried"), 10.0f, [State]() { return State->bFinished; });
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State, Config]()
+	{
+		TestEqual(TEXT("Retry-After reached the caller"), State->RetryAfter, static_cast<double>(Config.RetryAfter));
+		TestEqual(TEXT("Deploy attempts"), State->SentTimes.Num(), 2);
+		TestEqual(TEXT("Deploys succeeded"), State->NumSucceeded, 1);
+
+		if (State->SentTimes.Num() == 2)
+		{
+			const double RetryDelay = State->SentTimes[1] - State->RateLimitedTime;
+			TestTrue(FString::Printf(TEXT("Retried after %.2fs, Retry-After was %.2fs"), RetryDelay, Config.RetryAfter), RetryDelay >= Config.RetryAfter - KINDA_SMALL_NUMBER);
+		}
+		return true;
+	}));
+
+	EndMockTest(MockState);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEdgegapMockApiErrorInjectionTest, "Edgegap.MockApi.ErrorInjection", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FEdgegapMockApiErrorInjectionTest::RunTest(const FString& Parameters)
+{
+	FEdgegapMockApiConfig Config;
+	Config.ErrorRate = 1.0f;
+	Config.ErrorCode = 503;
+
+	FMockTestState MockState;
+	if (!BeginMockTest(*this, Config, MockState))
+	{
+		return false;
+	}
+
+	TSharedRef<TOptional<FEdgegapRequestResult>> Result = MakeShared<TOptional<FEdgegapRequestResult>>();
+	Deploy(Result);
+
+	WaitUntil(*this, TEXT("the deploy request"), 10.0f, [Result]() { return Result->IsSet(); });
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Result]()
+	{
+		if (Result->IsSet())
+		{
+			const FEdgegapRequestResult& Value = Result->GetValue();
+
+			TestFalse(TEXT("Deploy failed"), Value.bSucceeded);
+			TestEqual(TEXT("Not retried"), Value.RetryAfter, 0.0);
+			TestTrue(FString::Printf(TEXT("Error names the injected code: %s"), *Value.Error), Value.Error.Contains(TEXT("503")));
+			TestTrue(TEXT("Error was injected"), FEdgegapMockApiServer::Get().GetNumInjectedErrors() > 0);
+		}
+		return true;
+	}));
+
+	EndMockTest(MockState);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEdgegapMockApiMergeInPlaceTest, "Edgegap.MockApi.MergeInPlace", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FEdgegapMockApiMergeInPlaceTest::RunTest(const FString& Parameters)
+{
+	FEdgegapMockApiConfig Config;
+	Config.ReadyDelay = 1.0f;
+	Config.ExtraDeployments = 3;
+
+	FMockTestState MockState;
+	if (!BeginMockTest(*this, Config, MockState))
+	{
+		return false;
+	}
+
+	TSharedRef<TOptional<FEdgegapRequestResult>> Result = MakeShared<TOptional<FEdgegapRequestResult>>();
+	Deploy(Result);
+
+	WaitUntil(*this, TEXT("the deploy request"), 10.0f, [Result]() { return Result->IsSet(); });
+
+	// The items of the first poll that lists the new deployment, usually before it is ready
+	TSharedRef<TArray<TSharedPtr<FDeploymentStatusListItem>>> FirstItems = MakeShared<TArray<TSharedPtr<FDeploymentStatusListItem>>>();
+
+	PollUntil(*this, TEXT("the deployment to be listed"), 10.0f, [Result, FirstItems](const TArray<TSharedPtr<FDeploymentStatusListItem>>& Deployments)
+	{
+		if (!Result->IsSet() || !FindDeployment(Deployments, Result->GetValue().RequestID).IsValid())
+		{
+			return false;
+		}
+
+		*FirstItems = Deployments;
+		return true;
+	});
+
+	PollUntil(*this, TEXT("the deployment to be ready"), 10.0f, [Result](const TArray<TSharedPtr<FDeploymentStatusListItem>>& Deployments)
+	{
+		const TSharedPtr<FDeploymentStatusListItem> Deployment = Result->IsSet() ? FindDeployment(Deployments, Result->GetValue().RequestID) : nullptr;
+		return Deployment.IsValid() && Deployment->DeploymentReady;
+	});
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Result, FirstItems, Config]()
+	{
+		const TArray<TSharedPtr<FDeploymentStatusListItem>>& Deployments = FEdgegapDeploymentPoller::Get().GetDeployments();
+
+		TestEqual(TEXT("Listed deployments"), Deployments.Num(), Config.ExtraDeployments + 1);
+
+		for (const TSharedPtr<FDeploymentStatusListItem>& First : *FirstItems)
+		{
+			const TSharedPtr<FDeploymentStatusListItem> Latest = FindDeployment(Deployments, First->RequestID);
+			TestTrue(FString::Printf(TEXT("%s kept its item across polls"), *First->RequestID), Latest.IsValid() && Latest == First);
+		}
+
+		// Changes land in the item views already hold
+		const TSharedPtr<FDeploymentStatusListItem> Deployment = Result->IsSet() ? FindDeployment(*FirstItems, Result->GetValue().RequestID) : nullptr;
+		if (TestTrue(TEXT("Deployment was in the first list"), Deployment.IsValid()))
+		{
+			TestTrue(TEXT("First item updated to ready"), Deployment->DeploymentReady);
+		}
+		return true;
+	}));
+
+	EndMockTest(MockState);
+	return true;
+}
+
+#endif
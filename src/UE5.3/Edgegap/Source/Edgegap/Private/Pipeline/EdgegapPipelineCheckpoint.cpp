@@ -0,0 +1,225 @@
+#include "EdgegapPipelineCheckpoint.h"
+#include "EdgegapSettingsDetails.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#define LOCTEXT_NAMESPACE "EdgegapPipelineCheckpoint"
+
+FEdgegapPipelineCheckpoint& FEdgegapPipelineCheckpoint::Get()
+{
+	static FEdgegapPipelineCheckpoint Instance;
+	return Instance;
+}
+
+FEdgegapPipelineCheckpoint::FEdgegapPipelineCheckpoint()
+{
+	Load();
+}
+
+void FEdgegapPipelineCheckpoint::Begin(const FString& InTag)
+{
+	Tag = InTag;
+	StagedPath.Reset();
+	StagedFingerprint.Reset();
+	ImageName.Reset();
+	ImageID.Reset();
+	PushedDigest.Reset();
+	VersionName.Reset();
+	NextStage = EEdgegapPipelineStage::Package;
+	Save();
+}
+
+void FEdgegapPipelineCheckpoint::CompletePackage(const FString& InStagedPath)
+{
+	StagedPath = InStagedPath;
+	StagedFingerprint = FingerprintStagedBuild(InStagedPath);
+	NextStage = EEdgegapPipelineStage::Containerize;
+	Save();
+}
+
+void FEdgegapPipelineCheckpoint::CompleteContainerize(const FString& InImageName, const FString& InImageID)
+{
+	ImageName = InImageName;
+	ImageID = InImageID;
+	NextStage = EEdgegapPipelineStage::Push;
+	Save();
+}
+
+void FEdgegapPipelineCheckpoint::CompletePush(const FString& InPushedDigest)
+{
+	PushedDigest = InPushedDigest;
+	NextStage = EEdgegapPipelineStage::CreateVersion;
+	Save();
+}
+
+void FEdgegapPipelineCheckpoint::CompleteVersion(const FString& InVersionName)
+{
+	VersionName = InVersionName;
+	NextStage = EEdgegapPipelineStage::Done;
+	Save();
+}
+
+bool FEdgegapPipelineCheckpoint::CanResume() const
+{
+	return !Tag.IsEmpty() && NextStage != EEdgegapPipelineStage::Package && NextStage != EEdgegapPipelineStage::Done;
+}
+
+FText FEdgegapPipelineCheckpoint::ValidateInputs(const FString& CurrentImageName) const
+{
+	if (!CanResume())
+	{
+		return LOCTEXT("NothingToResume", "There is no unfinished Build and Push to resume.");
+	}
+
+	if (NextStage == EEdgegapPipelineStage::Containerize)
+	{
+		if (!FPaths::DirectoryExists(StagedPath))
+		{
+			return FText::Format(LOCTEXT("StagedBuildMissing", "The staged build in {0} is gone."), FText::FromString(StagedPath));
+		}
+		if (FingerprintStagedBuild(StagedPath) != StagedFingerprint)
+		{
+			return FText::Format(LOCTEXT("StagedBuildChanged", "The staged build in {0} changed since it was packaged."), FText::FromString(StagedPath));
+		}
+		return FText();
+	}
+
+	if (NextStage == EEdgegapPipelineStage::Push && ImageID.IsEmpty())
+	{
+		return LOCTEXT("ImageIDMissing", "The ID of the built image wasn't recorded, so it can't be told apart from another image of the same name.");
+	}
+
+	// The image was built, it is pushed and registered under the name it was built with
+	if (ImageName != CurrentImageName)
+	{
+		return FText::Format(LOCTEXT("ImageNameChanged", "The image was built as {0}, but the registry, repository or application name changed since."), FText::FromString(ImageName));
+	}
+
+	return FText();
+}
+
+FText FEdgegapPipelineCheckpoint::DescribeResume() const
+{
+	if (!CanResume())
+	{
+		return LOCTEXT("NoResume", "Resumes a Build and Push that failed or was canceled, from the first step it didn't finish.");
+	}
+
+	FText Step;
+	switch (NextStage)
+	{
+	case EEdgegapPipelineStage::Containerize:
+		Step = LOCTEXT("ResumeContainerize", "building the container image");
+		break;
+	case EEdgegapPipelineStage::Push:
+		Step = LOCTEXT("ResumePush", "pushing the image");
+		break;
+	default:
+		Step = LOCTEXT("ResumeCreateVersion", "creating the version");
+		break;
+	}
+
+	return FText::Format(LOCTEXT("ResumeDescription", "Resume Build and Push {0} from {1}"), FText::FromString(Tag), Step);
+}
+
+FString FEdgegapPipelineCheckpoint::GetImageIDFilePath()
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("Edgegap") / TEXT("ImageID.txt"));
+}
+
+FString FEdgegapPipelineCheckpoint::FingerprintStagedBuild(const FString& InStagedPath)
+{
+	TArray<FString> Entries;
+	IFileManager::Get().IterateDirectoryStatRecursively(*InStagedPath, [&Entries, &InStagedPath](const TCHAR* Path, const FFileStatData& StatData)
+	{
+		const FString CleanName = FPaths::GetCleanFilename(Path);
+		if (StatData.bIsDirectory || CleanName == TEXT("Dockerfile") || CleanName == TEXT("StartServer.sh"))
+		{
+			return true;
+		}
+
+		FString RelativePath = Path;
+		FPaths::MakePathRelativeTo(RelativePath, *(InStagedPath / TEXT("")));
+		Entries.Add(FString::Printf(TEXT("%s|%lld|%lld"), *RelativePath, StatData.FileSize, StatData.ModificationTime.GetTicks()));
+		return true;
+	});
+
+	// Directories aren't listed in any particular order
+	Entries.Sort();
+
+	FSHA1 Hash;
+	for (const FString& Entry : Entries)
+	{
+		FTCHARToUTF8 Utf8(*Entry);
+		Hash.Update(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+		Hash.Update(reinterpret_cast<const uint8*>("\n"), 1);
+	}
+	Hash.Final();
+
+	uint8 Digest[FSHA1::DigestSize];
+	Hash.GetHash(Digest);
+	return FString::Printf(TEXT("%d:%s"), Entries.Num(), *BytesToHex(Digest, FSHA1::DigestSize));
+}
+
+void FEdgegapPipelineCheckpoint::Load()
+{
+	FString JsonString;
+	if (!FFileHelper::LoadFileToString(JsonString, *GetCheckpointPath()))
+	{
+		return;
+	}
+
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+
+	int32 Stage = 0;
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid() || !JsonObject->TryGetStringField(TEXT("tag"), Tag) || !JsonObject->TryGetNumberField(TEXT("next_stage"), Stage))
+	{
+		UE_LOG(EdgegapLog, Warning, TEXT("PipelineCheckpoint: Ignoring unreadable %s"), *GetCheckpointPath());
+		Tag.Reset();
+		return;
+	}
+
+	NextStage = (EEdgegapPipelineStage)FMath::Clamp(Stage, 0, (int32)EEdgegapPipelineStage::Done);
+	JsonObject->TryGetStringField(TEXT("staged_path"), StagedPath);
+	JsonObject->TryGetStringField(TEXT("staged_fingerprint"), StagedFingerprint);
+	JsonObject->TryGetStringField(TEXT("image_name"), ImageName);
+	JsonObject->TryGetStringField(TEXT("image_id"), ImageID);
+	JsonObject->TryGetStringField(TEXT("pushed_digest"), PushedDigest);
+	JsonObject->TryGetStringField(TEXT("version_name"), VersionName);
+}
+
+void FEdgegapPipelineCheckpoint::Save() const
+{
+	FString JsonString;
+	TSharedRef<TJsonWriter<TCHAR>> JsonWriter = TJsonWriterFactory<TCHAR>::Create(&JsonString);
+
+	JsonWriter->WriteObjectStart();
+	JsonWriter->WriteValue(TEXT("tag"), Tag);
+	JsonWriter->WriteValue(TEXT("next_stage"), (int32)NextStage);
+	JsonWriter->WriteValue(TEXT("staged_path"), StagedPath);
+	JsonWriter->WriteValue(TEXT("staged_fingerprint"), StagedFingerprint);
+	JsonWriter->WriteValue(TEXT("image_name"), ImageName);
+	JsonWriter->WriteValue(TEXT("image_id"), ImageID);
+	JsonWriter->WriteValue(TEXT("pushed_digest"), PushedDigest);
+	JsonWriter->WriteValue(TEXT("version_name"), VersionName);
+	JsonWriter->WriteObjectEnd();
+	JsonWriter->Close();
+
+	if (!FFileHelper::SaveStringToFile(JsonString, *GetCheckpointPath()))
+	{
+		UE_LOG(EdgegapLog, Warning, TEXT("PipelineCheckpoint: Could not write %s"), *GetCheckpointPath());
+	}
+}
+
+FString FEdgegapPipelineCheckpoint::GetCheckpointPath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("Edgegap") / TEXT("PipelineCheckpoint.json");
+}
+
+#undef LOCTEXT_NAMESPACE
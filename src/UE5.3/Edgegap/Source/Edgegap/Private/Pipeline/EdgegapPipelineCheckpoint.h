@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** The steps of Build and Push, in order. Docker login isn't one, it runs again before every push. */
+enum class EEdgegapPipelineStage : uint8
+{
+	Package,
+	Containerize,
+	Push,
+	CreateVersion,
+	Done
+};
+
+/**
+ * What the last Build and Push run got done, saved to Saved/Edgegap/PipelineCheckpoint.json after every step so a
+ * failed or canceled run can resume from the first step it didn't finish instead of cooking again.
+ *
+ * Resuming checks that the completed steps' results are still what the next step expects: the staged build's files,
+ * and the image name, which changes with the registry, repository and application settings. Game thread only.
+ */
+class FEdgegapPipelineCheckpoint
+{
+public:
+	static FEdgegapPipelineCheckpoint& Get();
+
+	/** Starts over with a new run, forgetting the previous one */
+	void Begin(const FString& InTag);
+
+	void CompletePackage(const FString& InStagedPath);
+	void CompleteContainerize(const FString& InImageName, const FString& InImageID);
+	void CompletePush(const FString& InPushedDigest);
+	void CompleteVersion(const FString& InVersionName);
+
+	/** Whether a run stopped after at least one step and before its last one */
+	bool CanResume() const;
+
+	/** Why the next step can't use what the previous ones left, empty when it can */
+	FText ValidateInputs(const FString& CurrentImageName) const;
+
+	/** "Resume 2024-05-02_14-10 from pushing the image" */
+	FText DescribeResume() const;
+
+	EEdgegapPipelineStage GetNextStage() const { return NextStage; }
+	const FString& GetTag() const { return Tag; }
+	const FString& GetStagedPath() const { return StagedPath; }
+	const FString& GetImageName() const { return ImageName; }
+	const FString& GetImageID() const { return ImageID; }
+
+	/** Where docker build --iidfile writes the ID of the image it built */
+	static FString GetImageIDFilePath();
+
+	/** Names, sizes and times of the staged build's files, the files Containerize copies in left out */
+	static FString FingerprintStagedBuild(const FString& InStagedPath);
+
+private:
+	FEdgegapPipelineCheckpoint();
+
+	void Load();
+	void Save() const;
+
+	static FString GetCheckpointPath();
+
+	FString Tag;
+	FString StagedPath;
+	FString StagedFingerprint;
+	FString ImageName;
+	FString ImageID;
+	FString PushedDigest;
+	FString VersionName;
+	EEdgegapPipelineStage NextStage = EEdgegapPipelineStage::Package;
+};
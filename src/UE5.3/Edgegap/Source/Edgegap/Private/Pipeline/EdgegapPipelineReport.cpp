@@ -0,0 +1,127 @@
+#include "EdgegapPipelineReport.h"
+#include "EdgegapSettingsDetails.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+FEdgegapPipelineReport& FEdgegapPipelineReport::Get()
+{
+	static FEdgegapPipelineReport Instance;
+	return Instance;
+}
+
+void FEdgegapPipelineReport::Begin(const FString& InTag)
+{
+	Tag = InTag;
+	StartTime = FDateTime::UtcNow();
+	Stages.Reset();
+	bRunning = true;
+}
+
+void FEdgegapPipelineReport::AddStage(const FString& Name, const FUcmdResult& Result)
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	FEdgegapPipelineStage& Stage = Stages.AddDefaulted_GetRef();
+	Stage.Name = Name;
+	Stage.Result = LexToString(Result.Result);
+	Stage.ExitCode = Result.ExitCode;
+	Stage.Seconds = Result.WallSeconds;
+	Stage.Usage = Result.Usage;
+}
+
+void FEdgegapPipelineReport::Finish(const FString& Result)
+{
+	if (!bRunning)
+	{
+		return;
+	}
+	bRunning = false;
+
+	double TotalSeconds = 0.0;
+	for (const FEdgegapPipelineStage& Stage : Stages)
+	{
+		TotalSeconds += Stage.Seconds;
+	}
+
+	UE_LOG(EdgegapLog, Log, TEXT("Build and Push %s: %s after %.0f s"), *Tag, *Result, TotalSeconds);
+	for (const FEdgegapPipelineStage& Stage : Stages)
+	{
+		UE_LOG(EdgegapLog, Log, TEXT("    %s: %s after %.0f s, %s"), *Stage.Name, *Stage.Result, Stage.Seconds, *Stage.Usage.ToString());
+	}
+
+	Write(Result);
+	PruneReportDir();
+}
+
+FString FEdgegapPipelineReport::GetReportDir()
+{
+	return FPaths::ProjectSavedDir() / TEXT("Edgegap") / TEXT("PipelineReports");
+}
+
+void FEdgegapPipelineReport::Write(const FString& Result) const
+{
+	FString JsonString;
+	TSharedRef<TJsonWriter<TCHAR>> JsonWriter = TJsonWriterFactory<TCHAR>::Create(&JsonString);
+
+	JsonWriter->WriteObjectStart();
+	JsonWriter->WriteValue(TEXT("tag"), Tag);
+	JsonWriter->WriteValue(TEXT("started"), StartTime.ToIso8601());
+	JsonWriter->WriteValue(TEXT("result"), Result);
+	JsonWriter->WriteArrayStart(TEXT("stages"));
+
+	for (const FEdgegapPipelineStage& Stage : Stages)
+	{
+		const FUcmdResourceUsage& Usage = Stage.Usage;
+
+		JsonWriter->WriteObjectStart();
+		JsonWriter->WriteValue(TEXT("name"), Stage.Name);
+		JsonWriter->WriteValue(TEXT("result"), Stage.Result);
+		JsonWriter->WriteValue(TEXT("exit_code"), Stage.ExitCode);
+		JsonWriter->WriteValue(TEXT("seconds"), Stage.Seconds);
+		JsonWriter->WriteValue(TEXT("samples"), Usage.NumSamples);
+		JsonWriter->WriteValue(TEXT("cpu_seconds"), Usage.CpuSeconds);
+		JsonWriter->WriteValue(TEXT("average_cpu_load"), Usage.AverageCpuLoad);
+		JsonWriter->WriteValue(TEXT("peak_cpu_load"), Usage.PeakCpuLoad);
+		JsonWriter->WriteValue(TEXT("average_memory_bytes"), Usage.AverageMemoryBytes);
+		JsonWriter->WriteValue(TEXT("peak_memory_bytes"), Usage.PeakMemoryBytes);
+		JsonWriter->WriteValue(TEXT("read_bytes"), Usage.ReadBytes);
+		JsonWriter->WriteValue(TEXT("write_bytes"), Usage.WriteBytes);
+		JsonWriter->WriteValue(TEXT("peak_read_bytes_per_second"), Usage.PeakReadBytesPerSecond);
+		JsonWriter->WriteValue(TEXT("peak_write_bytes_per_second"), Usage.PeakWriteBytesPerSecond);
+		JsonWriter->WriteValue(TEXT("peak_processes"), Usage.PeakNumProcesses);
+		JsonWriter->WriteObjectEnd();
+	}
+
+	JsonWriter->WriteArrayEnd();
+	JsonWriter->WriteObjectEnd();
+	JsonWriter->Close();
+
+	const FString Path = GetReportDir() / Tag + TEXT(".json");
+	if (!FFileHelper::SaveStringToFile(JsonString, *Path))
+	{
+		UE_LOG(EdgegapLog, Warning, TEXT("PipelineReport: Could not write %s"), *Path);
+	}
+}
+
+void FEdgegapPipelineReport::PruneReportDir()
+{
+	TArray<FString> Files;
+	IFileManager::Get().FindFiles(Files, *(GetReportDir() / TEXT("*.json")), true, false);
+	if (Files.Num() <= MaxReports)
+	{
+		return;
+	}
+
+	// Tags are start times, oldest sorts first
+	Files.Sort();
+	for (int32 Index = 0; Index < Files.Num() - MaxReports; ++Index)
+	{
+		IFileManager::Get().Delete(*(GetReportDir() / Files[Index]));
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IUCMDHelperModule.h"
+
+/** One UCMD step of a Build and Push run */
+struct FEdgegapPipelineStage
+{
+	FString Name;
+	FString Result;
+	int32 ExitCode = 0;
+	double Seconds = 0.0;
+	FUcmdResourceUsage Usage;
+};
+
+/**
+ * How long each step of a Build and Push run took and what its processes used, logged and written to
+ * Saved/Edgegap/PipelineReports/<tag>.json when the run ends, so runs can be compared across machines and changes.
+ *
+ * Game thread only, which is where the continuations of UCMD results run.
+ */
+class FEdgegapPipelineReport
+{
+public:
+	static FEdgegapPipelineReport& Get();
+
+	/** Starts the report of a new run, dropping the one of a run that never ended */
+	void Begin(const FString& Tag);
+
+	void AddStage(const FString& Name, const FUcmdResult& Result);
+
+	/** Logs and writes the report, if a run began */
+	void Finish(const FString& Result);
+
+	static FString GetReportDir();
+
+	static constexpr int32 MaxReports = 20;
+
+private:
+	void Write(const FString& Result) const;
+
+	/** Deletes the oldest reports beyond MaxReports */
+	static void PruneReportDir();
+
+	FString Tag;
+	FDateTime StartTime;
+	TArray<FEdgegapPipelineStage> Stages;
+	bool bRunning = false;
+};
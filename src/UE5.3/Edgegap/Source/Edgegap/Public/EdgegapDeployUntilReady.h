@@ -0,0 +1,95 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+
+struct FEdgegapDeployParams
+{
+	// Empty fields fall back to the Edgegap plugin settings
+	FString AppName;
+	FString VersionName;
+	FString API_key;
+
+	/** ip_list of the deploy, empty uses this machine's public IP */
+	TArray<FString> PlayerIPs;
+
+	/** Seconds from the call until the deployment has to be ready, 0 uses Batch Ready Timeout */
+	float Timeout = 0.0f;
+};
+
+struct FEdgegapDeployResult
+{
+	bool bSucceeded = false;
+	bool bTimedOut = false;
+
+	/** Set once the deploy request went through, even when waiting for ready failed afterwards */
+	FString RequestID;
+
+	/** host:port of the game port, set on success */
+	FString Address;
+
+	/** Set on failure */
+	FString Error;
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnEdgegapDeployFinished, const FEdgegapDeployResult&);
+
+/**
+ * One deploy in flight. Finishes exactly once, on the game thread, with the deployment ready, failed, timed out or cancelled.
+ */
+class EDGEGAP_API FEdgegapDeployHandle : public TSharedFromThis<FEdgegapDeployHandle>
+{
+public:
+	/** Empty until the deploy request went through */
+	const FString& GetRequestID() const { return Result.RequestID; }
+
+	bool IsFinished() const { return bFinished; }
+
+	/** Only meaningful once finished */
+	const FEdgegapDeployResult& GetResult() const { return Result; }
+
+	/** Fires once on the game thread, check IsFinished first when binding late. */
+	FOnEdgegapDeployFinished& OnFinished() { return Finished; }
+
+	/** Set on the game thread, so only block on it from another thread, or use Then(). */
+	TSharedFuture<FEdgegapDeployResult> GetFuture() const { return Future; }
+
+	/** Stops waiting, a deployment that was already requested keeps running. */
+	void Cancel();
+
+private:
+	friend class FEdgegapDeployUntilReady;
+	friend class FEdgegapReadyWaiter;
+
+	FEdgegapDeployHandle();
+
+	/** Publishes Result as it is now, later calls do nothing. */
+	void Finish();
+
+	FEdgegapDeployParams Params;
+	double StartTime = 0.0;
+	double Deadline = 0.0;
+
+	// Non zero while the deploy request waits out a rate limit
+	double RetryTime = 0.0;
+
+	FEdgegapDeployResult Result;
+	bool bFinished = false;
+
+	TPromise<FEdgegapDeployResult> Promise;
+	TSharedFuture<FEdgegapDeployResult> Future;
+	FOnEdgegapDeployFinished Finished;
+};
+
+/**
+ * Deploys a version and resolves with its address once it is ready, for editor tools and automation.
+ *
+ * Waiting is not a loop per caller: every pending deploy is matched against the shared deployments poller,
+ * so any number of them cost one v1/deployments request per poll.
+ */
+class EDGEGAP_API FEdgegapDeployUntilReady
+{
+public:
+	/** Must be called on the game thread. */
+	static TSharedRef<FEdgegapDeployHandle> Start(const FEdgegapDeployParams& Params);
+};
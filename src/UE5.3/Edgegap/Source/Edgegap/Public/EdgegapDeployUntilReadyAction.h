@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "EdgegapDeployUntilReady.h"
+#include "EdgegapDeployUntilReadyAction.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FEdgegapDeployUntilReadyPin, const FString&, Address, const FString&, RequestID, const FString&, Error);
+
+/** Blueprint node around FEdgegapDeployUntilReady, for editor utility widgets and automation */
+UCLASS()
+class EDGEGAP_API UEdgegapDeployUntilReadyAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Deploys a version and waits until it is ready, Address is the host:port of the game port.
+	 * Empty names use the Edgegap plugin settings, a Timeout of 0 uses Batch Ready Timeout.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Edgegap", meta = (BlueprintInternalUseOnly = "true"))
+	static UEdgegapDeployUntilReadyAction* DeployUntilReady(const FString& AppName, const FString& VersionName, float TimeoutSeconds = 0.0f);
+
+	UPROPERTY(BlueprintAssignable)
+	FEdgegapDeployUntilReadyPin OnReady;
+
+	UPROPERTY(BlueprintAssignable)
+	FEdgegapDeployUntilReadyPin OnFailed;
+
+	virtual void Activate() override;
+
+private:
+	void HandleFinished(const FEdgegapDeployResult& Result);
+
+	FEdgegapDeployParams Params;
+	TSharedPtr<FEdgegapDeployHandle> Handle;
+};
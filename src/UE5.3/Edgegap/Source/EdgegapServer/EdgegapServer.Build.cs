@@ -0,0 +1,17 @@
+using UnrealBuildTool;
+
+public class EdgegapServer : ModuleRules
+{
+	public EdgegapServer(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[] {
+				"Core",
+				"Sockets",
+				"Networking"
+			}
+		);
+	}
+}
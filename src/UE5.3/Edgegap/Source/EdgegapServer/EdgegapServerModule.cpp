@@ -0,0 +1,28 @@
+#include "EdgegapServerModule.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FEdgegapServerModule, EdgegapServer);
+
+void FEdgegapServerModule::StartupModule()
+{
+	if (!IsRunningDedicatedServer())
+	{
+		return;
+	}
+
+	// -EdgegapEchoPort=0 turns the echo off
+	int32 Port = FEdgegapLatencyEcho::DefaultPort;
+	FParse::Value(FCommandLine::Get(), TEXT("EdgegapEchoPort="), Port);
+
+	if (Port > 0)
+	{
+		LatencyEcho.Start(Port);
+	}
+}
+
+void FEdgegapServerModule::ShutdownModule()
+{
+	LatencyEcho.Stop();
+}
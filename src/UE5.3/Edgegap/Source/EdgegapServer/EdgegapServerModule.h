@@ -0,0 +1,16 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleInterface.h"
+#include "EdgegapLatencyEcho.h"
+
+/** Runs alongside the packaged dedicated server to answer the editor's latency probes. */
+class FEdgegapServerModule : public IModuleInterface
+{
+public:
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+
+private:
+	FEdgegapLatencyEcho LatencyEcho;
+};
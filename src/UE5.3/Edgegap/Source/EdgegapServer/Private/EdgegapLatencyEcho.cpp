@@ -0,0 +1,70 @@
+#include "EdgegapLatencyEcho.h"
+#include "Common/UdpSocketBuilder.h"
+#include "Common/UdpSocketReceiver.h"
+#include "SocketSubsystem.h"
+#include "Sockets.h"
+
+DEFINE_LOG_CATEGORY_STATIC(EdgegapServerLog, Log, All);
+
+const uint8 FEdgegapLatencyEcho::Magic[4] = { 'E', 'G', 'L', 'P' };
+
+FEdgegapLatencyEcho::~FEdgegapLatencyEcho()
+{
+	Stop();
+}
+
+bool FEdgegapLatencyEcho::Start(int32 Port)
+{
+	Stop();
+
+	Socket = FUdpSocketBuilder(TEXT("EdgegapLatencyEcho"))
+		.AsNonBlocking()
+		.AsReusable()
+		.BoundToPort(Port)
+		.Build();
+
+	if (!Socket)
+	{
+		UE_LOG(EdgegapServerLog, Warning, TEXT("LatencyEcho: Could not bind UDP port %d"), Port);
+		return false;
+	}
+
+	BoundPort = Port;
+
+	FSocket* EchoSocket = Socket;
+	Receiver = MakeUnique<FUdpSocketReceiver>(Socket, FTimespan::FromMilliseconds(100), TEXT("EdgegapLatencyEcho"));
+	Receiver->OnDataReceived().BindLambda([EchoSocket](const FArrayReaderPtr& Data, const FIPv4Endpoint& Sender)
+	{
+		if (!IsProbe(Data->GetData(), Data->Num()))
+		{
+			return;
+		}
+
+		int32 BytesSent = 0;
+		EchoSocket->SendTo(Data->GetData(), Data->Num(), BytesSent, *Sender.ToInternetAddr());
+	});
+	Receiver->Start();
+
+	UE_LOG(EdgegapServerLog, Log, TEXT("LatencyEcho: Listening on UDP port %d"), Port);
+	return true;
+}
+
+void FEdgegapLatencyEcho::Stop()
+{
+	// Joins the receiver thread before the socket goes away
+	Receiver.Reset();
+
+	if (Socket)
+	{
+		Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+		Socket = nullptr;
+	}
+
+	BoundPort = 0;
+}
+
+bool FEdgegapLatencyEcho::IsProbe(const uint8* Data, int32 Size)
+{
+	return Size >= UE_ARRAY_COUNT(Magic) && Size <= MaxPacketSize && FMemory::Memcmp(Data, Magic, UE_ARRAY_COUNT(Magic)) == 0;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FSocket;
+class FUdpSocketReceiver;
+
+/**
+ * UDP echo for latency probes. Datagrams that start with the probe magic and fit in MaxPacketSize are sent back
+ * unchanged from a receiver thread, so the round trip doesn't include the server's frame time. Anything else is dropped.
+ *
+ * The game port belongs to the net driver, the echo listens on its own port (exposed as "echo" on the app version).
+ */
+class EDGEGAPSERVER_API FEdgegapLatencyEcho
+{
+public:
+	static constexpr int32 DefaultPort = 7778;
+	static constexpr int32 MaxPacketSize = 64;
+
+	/** First bytes of every probe */
+	static const uint8 Magic[4];
+
+	~FEdgegapLatencyEcho();
+
+	bool Start(int32 Port);
+	void Stop();
+
+	bool IsRunning() const { return Socket != nullptr; }
+	int32 GetPort() const { return BoundPort; }
+
+	static bool IsProbe(const uint8* Data, int32 Size);
+
+private:
+	FSocket* Socket = nullptr;
+	TUniquePtr<FUdpSocketReceiver> Receiver;
+	int32 BoundPort = 0;
+};
@@ -5,9 +5,144 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleInterface.h"
 #include "Modules/ModuleManager.h"
+#include "Async/Future.h"
 
 struct FSlateBrush;
 
+/** A program and its arguments, started as they are without a shell in between */
+struct UCMDHELPER_API FUcmdCommand
+{
+	// "docker", or a path. A bare name is looked up in PATH.
+	FString Executable;
+	TArray<FString> Arguments;
+
+	// Written to the process' standard input, which is then closed. Never logged.
+	FString StdIn;
+
+	FUcmdCommand() = default;
+	FUcmdCommand(const FString& InExecutable, TArray<FString> InArguments)
+		: Executable(InExecutable)
+		, Arguments(MoveTemp(InArguments))
+	{
+	}
+
+	/** The command as it would be typed, for logs */
+	FString ToString() const;
+
+	/**
+	 * Splits a command line at unquoted whitespace and removes the quotes: -project="C:/My Game/X.uproject" gives -project=C:/My Game/X.uproject.
+	 * Backslashes in front of a quote are read the way CommandLineToArgvW does, so it undoes QuoteArgument.
+	 */
+	static TArray<FString> ParseArguments(const FString& CommandLine);
+
+	/** Quotes an argument for a command line, only where it needs it */
+	static FString QuoteArgument(const FString& Argument);
+
+	/** Quotes an argument for a .bat or .cmd file so cmd.exe passes it on unchanged, false if it has a line break, which can't be */
+	static bool QuoteBatchArgument(const FString& Argument, FString& OutQuoted);
+};
+
+/** What a task's process and its children used, sampled every UCMD.ResourceSampleInterval seconds while it ran */
+struct UCMDHELPER_API FUcmdResourceUsage
+{
+	// Zero when the platform can't read the counters, or the task ended before the first sample
+	int32 NumSamples = 0;
+	double WallSeconds = 0.0;
+
+	// User and kernel time of the whole tree. A load of 2 is two cores busy.
+	double CpuSeconds = 0.0;
+	double AverageCpuLoad = 0.0;
+	double PeakCpuLoad = 0.0;
+
+	// Resident memory summed over the processes, pages they share count once per process
+	int64 AverageMemoryBytes = 0;
+	int64 PeakMemoryBytes = 0;
+
+	// Storage I/O on Linux and Mac, all I/O including network on Windows
+	int64 ReadBytes = 0;
+	int64 WriteBytes = 0;
+	double PeakReadBytesPerSecond = 0.0;
+	double PeakWriteBytesPerSecond = 0.0;
+
+	int32 PeakNumProcesses = 0;
+
+	/** "CPU 512 s (average 3.1, peak 7.8 cores), memory average 2.10 GB, peak 6.40 GB, read..." */
+	FString ToString() const;
+};
+
+/** How a task ended */
+enum class EUcmdTaskResult : uint8
+{
+	None,
+	// Exited with code 0
+	Completed,
+	// Exited with another code
+	Failed,
+	Canceled,
+	// Its program couldn't be found or started
+	FailedToStart
+};
+
+/** "Completed", "Failed", "Canceled" or "FailedToStart", for logs */
+UCMDHELPER_API const TCHAR* LexToString(EUcmdTaskResult Result);
+
+/** Everything a task left behind, handed to the continuations of its future on the game thread */
+struct FUcmdResult
+{
+	EUcmdTaskResult Result = EUcmdTaskResult::None;
+	int32 ExitCode = 0;
+
+	// From the start of the process to its end, zero when it never started
+	double WallSeconds = 0.0;
+
+	// CPU time is Usage.CpuSeconds
+	FUcmdResourceUsage Usage;
+
+	// The last lines of standard output and standard error, as they came
+	TArray<FString> OutputTail;
+
+	// The task's complete output, empty when it never started
+	FString LogPath;
+
+	// Whatever the caller passed when creating the task
+	TSharedPtr<void> UserContext;
+
+	bool Succeeded() const { return Result == EUcmdTaskResult::Completed; }
+};
+
+/** Interactive tasks start before batch ones, and a batch task gives way when an interactive one waits for its resource */
+enum class EUcmdTaskPriority : uint8
+{
+	Batch,
+	Interactive
+};
+
+/** What a task mostly uses, each with its own limit of tasks running at once */
+enum class EUcmdTaskResource : uint8
+{
+	// RunUAT, one at a time
+	UAT,
+	// UCMD.MaxDockerTasks at a time
+	Docker,
+	// UCMD.MaxOtherTasks at a time
+	Other
+};
+
+/** A queued or running task */
+struct FUcmdTaskQueueEntry
+{
+	uint32 TaskID = 0;
+	FText TaskName;
+	FText PlatformDisplayName;
+	EUcmdTaskPriority Priority = EUcmdTaskPriority::Interactive;
+	EUcmdTaskResource Resource = EUcmdTaskResource::Other;
+	bool bRunning = false;
+	// Since it was queued, or since it started
+	double Seconds = 0.0;
+	// How many times it gave way to an interactive task and went back to the queue
+	int32 NumPreemptions = 0;
+};
+
 /**
  * The public interface to this module
  */
@@ -37,12 +172,18 @@ public:
 		return FModuleManager::Get().IsModuleLoaded( "UCMDHelper" );
 	}
 
-	/** Used to callback into calling code when a UAT task completes. First param is the result type, second param is the runtime in sec. */
-	typedef TFunction<void(FString, double)> UcmdTaskResultCallack;
-
-	/** Creates and starts up a UAT Task
+	/** Creates a UAT Task and starts it as soon as its resource has room for it
 	  * @param	ResultLocation	The folder where the result of the task will be stored  
+	  * @param	Priority	Batch tasks wait for interactive ones, and are restarted later when one needs their place
+	  * @param	UserContext	Handed back in the result
+	  * @return	Set on the game thread once the task ended and its messages reached the Message Log, so Then and Next continuations run there
 	  */
-	virtual void CreateUcmdTask(const FString& CommandLine, const FText& PlatformDisplayName, const FText& TaskName, const FText& TaskShortName, const FSlateBrush* TaskIcon, bool PowerShell, UcmdTaskResultCallack ResultCallback = UcmdTaskResultCallack(), const FString& ResultLocation = FString()) = 0;
+	virtual TFuture<FUcmdResult> CreateUcmdTask(const FUcmdCommand& Command, const FText& PlatformDisplayName, const FText& TaskName, const FText& TaskShortName, const FSlateBrush* TaskIcon, const FString& ResultLocation = FString(), EUcmdTaskPriority Priority = EUcmdTaskPriority::Interactive, TSharedPtr<void> UserContext = nullptr) = 0;
+
+	/** Running tasks first, then queued ones in the order they will start */
+	virtual void GetTaskQueue(TArray<FUcmdTaskQueueEntry>& OutEntries) const = 0;
+
+	/** Cancels a running task, or takes a queued one out of the queue */
+	virtual void CancelTask(uint32 TaskID) = 0;
 };
 
@@ -0,0 +1,185 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SUCMDProgressView.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Docking/TabManager.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Notifications/SProgressBar.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/SHeaderRow.h"
+
+#define LOCTEXT_NAMESPACE "UCMDHelper"
+
+namespace
+{
+	const FName ProgressTabName("UcmdDockerProgress");
+
+	const FName LayerColumn("Layer");
+	const FName StatusColumn("Status");
+	const FName BytesColumn("Bytes");
+	const FName ProgressColumn("Progress");
+
+	class SUcmdLayerRow : public SMultiColumnTableRow<TSharedPtr<FUcmdDockerLayer>>
+	{
+	public:
+		SLATE_BEGIN_ARGS(SUcmdLayerRow) { }
+		SLATE_END_ARGS()
+
+		void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable, TSharedPtr<FUcmdDockerLayer> InLayer)
+		{
+			Layer = InLayer;
+			SMultiColumnTableRow<TSharedPtr<FUcmdDockerLayer>>::Construct(FSuperRowType::FArguments(), OwnerTable);
+		}
+
+		virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+		{
+			if (ColumnName == ProgressColumn)
+			{
+				const TOptional<float> Percent = Layer->bDone ? 1.0f : Layer->BytesTotal > 0 ? TOptional<float>((float)Layer->BytesDone / Layer->BytesTotal) : TOptional<float>();
+				return SNew(SBox)
+					.Padding(2)
+					[
+						SNew(SProgressBar)
+						.Percent(Percent)
+					];
+			}
+
+			FText Text;
+			if (ColumnName == LayerColumn)
+			{
+				Text = FText::FromString(Layer->ID);
+			}
+			else if (ColumnName == StatusColumn)
+			{
+				Text = FText::FromString(Layer->Status);
+			}
+			else if (ColumnName == BytesColumn && Layer->BytesTotal > 0)
+			{
+				Text = FText::Format(LOCTEXT("LayerBytes", "{0} / {1} MB"), FText::AsNumber(Layer->BytesDone / 1.0e6), FText::AsNumber(Layer->BytesTotal / 1.0e6));
+			}
+			else if (ColumnName == BytesColumn && Layer->BytesDone > 0)
+			{
+				Text = FText::Format(LOCTEXT("LayerBytesNoTotal", "{0} MB"), FText::AsNumber(Layer->BytesDone / 1.0e6));
+			}
+
+			return SNew(STextBlock).Text(Text);
+		}
+
+	private:
+		TSharedPtr<FUcmdDockerLayer> Layer;
+	};
+}
+
+void SUcmdProgressView::RegisterTabSpawner()
+{
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(ProgressTabName, FOnSpawnTab::CreateLambda([](const FSpawnTabArgs& Args)
+	{
+		return SNew(SDockTab)
+			.TabRole(ETabRole::NomadTab)
+			.Label(LOCTEXT("ProgressTabLabel", "Docker Progress"))
+			[
+				SNew(SUcmdProgressView)
+			];
+	}))
+		.SetDisplayName(LOCTEXT("ProgressTabLabel", "Docker Progress"))
+		.SetMenuType(ETabSpawnerMenuType::Hidden);
+}
+
+void SUcmdProgressView::UnregisterTabSpawner()
+{
+	if (FSlateApplication::IsInitialized())
+	{
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(ProgressTabName);
+	}
+}
+
+void SUcmdProgressView::OpenTab()
+{
+	FGlobalTabmanager::Get()->TryInvokeTab(FTabId(ProgressTabName));
+}
+
+void SUcmdProgressView::Construct(const FArguments& InArgs)
+{
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(4)
+		[
+			SNew(STextBlock)
+			.Text_Lambda([this]() { return HeaderText; })
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(4, 0, 4, 4)
+		[
+			SNew(STextBlock)
+			.Text_Lambda([this]() { return SummaryText; })
+		]
+		+ SVerticalBox::Slot()
+		.FillHeight(1)
+		[
+			SAssignNew(ListView, SListView<TSharedPtr<FUcmdDockerLayer>>)
+			.ListItemsSource(&Layers)
+			.OnGenerateRow(this, &SUcmdProgressView::GenerateRow)
+			.SelectionMode(ESelectionMode::None)
+			.HeaderRow
+			(
+				SNew(SHeaderRow)
+				+ SHeaderRow::Column(LayerColumn).DefaultLabel(LOCTEXT("LayerColumn", "Layer")).FillWidth(0.2f)
+				+ SHeaderRow::Column(StatusColumn).DefaultLabel(LOCTEXT("StatusColumn", "Status")).FillWidth(0.3f)
+				+ SHeaderRow::Column(BytesColumn).DefaultLabel(LOCTEXT("BytesColumn", "Bytes")).FillWidth(0.2f)
+				+ SHeaderRow::Column(ProgressColumn).DefaultLabel(LOCTEXT("ProgressColumn", "Progress")).FillWidth(0.3f)
+			)
+		]
+	];
+
+	Refresh(0.0, 0.0f);
+	RegisterActiveTimer(0.5f, FWidgetActiveTimerDelegate::CreateSP(this, &SUcmdProgressView::Refresh));
+}
+
+EActiveTimerReturnType SUcmdProgressView::Refresh(double InCurrentTime, float InDeltaTime)
+{
+	TSharedPtr<FUcmdDockerProgress> Progress = FUcmdDockerProgress::GetCurrent();
+	if (!Progress.IsValid())
+	{
+		HeaderText = LOCTEXT("NoDockerTask", "No docker build or push ran yet.");
+		return EActiveTimerReturnType::Continue;
+	}
+
+	const FUcmdDockerProgressSnapshot Snapshot = Progress->GetSnapshot();
+
+	HeaderText = Snapshot.NumSteps > 0 && !Snapshot.StepName.IsEmpty()
+		? FText::Format(LOCTEXT("HeaderWithStep", "{0}: {1}"), FText::FromString(Snapshot.TaskName), FText::FromString(Snapshot.StepName))
+		: FText::FromString(Snapshot.TaskName);
+
+	SummaryText = FText::Format(Snapshot.bFinished ? LOCTEXT("SummaryFinished", "Finished after {0}s. {1}") : LOCTEXT("SummaryRunning", "Running for {0}s. {1}"),
+		FText::AsNumber(FMath::RoundToInt(Snapshot.ElapsedSeconds)), Snapshot.Describe());
+
+	// Layers only get added, update the rows in place so the list keeps its scroll position
+	for (int32 Index = 0; Index < Snapshot.Layers.Num(); ++Index)
+	{
+		if (Index < Layers.Num())
+		{
+			*Layers[Index] = Snapshot.Layers[Index];
+		}
+		else
+		{
+			Layers.Add(MakeShared<FUcmdDockerLayer>(Snapshot.Layers[Index]));
+		}
+	}
+	Layers.SetNum(Snapshot.Layers.Num());
+
+	ListView->RebuildList();
+
+	return EActiveTimerReturnType::Continue;
+}
+
+TSharedRef<ITableRow> SUcmdProgressView::GenerateRow(TSharedPtr<FUcmdDockerLayer> Layer, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SUcmdLayerRow, OwnerTable, Layer);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,34 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+#include "UCMDDockerProgress.h"
+
+/** Per layer progress of the latest docker build or push, refreshed twice a second */
+class SUcmdProgressView : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SUcmdProgressView) { }
+	SLATE_END_ARGS()
+
+	static void RegisterTabSpawner();
+	static void UnregisterTabSpawner();
+
+	static void OpenTab();
+
+	void Construct(const FArguments& InArgs);
+
+private:
+	EActiveTimerReturnType Refresh(double InCurrentTime, float InDeltaTime);
+
+	TSharedRef<ITableRow> GenerateRow(TSharedPtr<FUcmdDockerLayer> Layer, const TSharedRef<STableViewBase>& OwnerTable);
+
+	TSharedPtr<SListView<TSharedPtr<FUcmdDockerLayer>>> ListView;
+	TArray<TSharedPtr<FUcmdDockerLayer>> Layers;
+
+	FText HeaderText;
+	FText SummaryText;
+};
@@ -0,0 +1,169 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SUCMDTaskQueueView.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Docking/TabManager.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/SHeaderRow.h"
+
+#define LOCTEXT_NAMESPACE "UCMDHelper"
+
+namespace
+{
+	const FName TaskQueueTabName("UcmdTaskQueue");
+
+	const FName TaskColumn("Task");
+	const FName PlatformColumn("Platform");
+	const FName PriorityColumn("Priority");
+	const FName StateColumn("State");
+	const FName CancelColumn("Cancel");
+
+	FText GetResourceText(EUcmdTaskResource Resource)
+	{
+		switch (Resource)
+		{
+		case EUcmdTaskResource::UAT:
+			return LOCTEXT("ResourceUAT", "UAT");
+		case EUcmdTaskResource::Docker:
+			return LOCTEXT("ResourceDocker", "Docker");
+		default:
+			return LOCTEXT("ResourceOther", "Other");
+		}
+	}
+
+	class SUcmdTaskRow : public SMultiColumnTableRow<TSharedPtr<FUcmdTaskQueueEntry>>
+	{
+	public:
+		SLATE_BEGIN_ARGS(SUcmdTaskRow) { }
+		SLATE_END_ARGS()
+
+		void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable, TSharedPtr<FUcmdTaskQueueEntry> InEntry)
+		{
+			Entry = InEntry;
+			SMultiColumnTableRow<TSharedPtr<FUcmdTaskQueueEntry>>::Construct(FSuperRowType::FArguments(), OwnerTable);
+		}
+
+		virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+		{
+			if (ColumnName == CancelColumn)
+			{
+				const uint32 TaskID = Entry->TaskID;
+				return SNew(SButton)
+					.Text(Entry->bRunning ? LOCTEXT("CancelTask", "Cancel") : LOCTEXT("RemoveTask", "Remove"))
+					.OnClicked_Lambda([TaskID]()
+					{
+						IUCMDHelperModule::Get().CancelTask(TaskID);
+						return FReply::Handled();
+					});
+			}
+
+			FText Text;
+			if (ColumnName == TaskColumn)
+			{
+				Text = Entry->TaskName;
+			}
+			else if (ColumnName == PlatformColumn)
+			{
+				Text = Entry->PlatformDisplayName;
+			}
+			else if (ColumnName == PriorityColumn)
+			{
+				Text = Entry->Priority == EUcmdTaskPriority::Interactive ? LOCTEXT("PriorityInteractive", "Interactive") : LOCTEXT("PriorityBatch", "Batch");
+			}
+			else if (ColumnName == StateColumn)
+			{
+				const int32 Seconds = FMath::FloorToInt(Entry->Seconds);
+				const FText Duration = FText::FromString(FString::Printf(TEXT("%d:%02d"), Seconds / 60, Seconds % 60));
+				Text = Entry->bRunning
+					? FText::Format(LOCTEXT("StateRunning", "Running on {0} for {1}"), GetResourceText(Entry->Resource), Duration)
+					: FText::Format(LOCTEXT("StateQueued", "Waiting for {0} for {1}"), GetResourceText(Entry->Resource), Duration);
+
+				if (Entry->NumPreemptions > 0)
+				{
+					Text = FText::Format(LOCTEXT("StatePreempted", "{0}, made way {1} {1}|plural(one=time,other=times)"), Text, Entry->NumPreemptions);
+				}
+			}
+
+			return SNew(STextBlock).Text(Text);
+		}
+
+	private:
+		TSharedPtr<FUcmdTaskQueueEntry> Entry;
+	};
+}
+
+void SUcmdTaskQueueView::RegisterTabSpawner()
+{
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(TaskQueueTabName, FOnSpawnTab::CreateLambda([](const FSpawnTabArgs& Args)
+	{
+		return SNew(SDockTab)
+			.TabRole(ETabRole::NomadTab)
+			.Label(LOCTEXT("TaskQueueTabLabel", "UCMD Tasks"))
+			[
+				SNew(SUcmdTaskQueueView)
+			];
+	}))
+		.SetDisplayName(LOCTEXT("TaskQueueTabLabel", "UCMD Tasks"))
+		.SetMenuType(ETabSpawnerMenuType::Hidden);
+}
+
+void SUcmdTaskQueueView::UnregisterTabSpawner()
+{
+	if (FSlateApplication::IsInitialized())
+	{
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(TaskQueueTabName);
+	}
+}
+
+void SUcmdTaskQueueView::OpenTab()
+{
+	FGlobalTabmanager::Get()->TryInvokeTab(FTabId(TaskQueueTabName));
+}
+
+void SUcmdTaskQueueView::Construct(const FArguments& InArgs)
+{
+	ChildSlot
+	[
+		SAssignNew(ListView, SListView<TSharedPtr<FUcmdTaskQueueEntry>>)
+		.ListItemsSource(&Entries)
+		.OnGenerateRow(this, &SUcmdTaskQueueView::GenerateRow)
+		.SelectionMode(ESelectionMode::None)
+		.HeaderRow
+		(
+			SNew(SHeaderRow)
+			+ SHeaderRow::Column(TaskColumn).DefaultLabel(LOCTEXT("TaskColumn", "Task")).FillWidth(0.25f)
+			+ SHeaderRow::Column(PlatformColumn).DefaultLabel(LOCTEXT("PlatformColumn", "Platform")).FillWidth(0.15f)
+			+ SHeaderRow::Column(PriorityColumn).DefaultLabel(LOCTEXT("PriorityColumn", "Priority")).FillWidth(0.15f)
+			+ SHeaderRow::Column(StateColumn).DefaultLabel(LOCTEXT("StateColumn", "State")).FillWidth(0.45f)
+			+ SHeaderRow::Column(CancelColumn).DefaultLabel(FText()).FixedWidth(80.0f)
+		)
+	];
+
+	Refresh(0.0, 0.0f);
+	RegisterActiveTimer(0.5f, FWidgetActiveTimerDelegate::CreateSP(this, &SUcmdTaskQueueView::Refresh));
+}
+
+EActiveTimerReturnType SUcmdTaskQueueView::Refresh(double InCurrentTime, float InDeltaTime)
+{
+	TArray<FUcmdTaskQueueEntry> NewEntries;
+	IUCMDHelperModule::Get().GetTaskQueue(NewEntries);
+
+	Entries.Reset();
+	for (FUcmdTaskQueueEntry& Entry : NewEntries)
+	{
+		Entries.Add(MakeShared<FUcmdTaskQueueEntry>(MoveTemp(Entry)));
+	}
+
+	ListView->RebuildList();
+
+	return EActiveTimerReturnType::Continue;
+}
+
+TSharedRef<ITableRow> SUcmdTaskQueueView::GenerateRow(TSharedPtr<FUcmdTaskQueueEntry> Entry, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SUcmdTaskRow, OwnerTable, Entry);
+}
+
+#undef LOCTEXT_NAMESPACE
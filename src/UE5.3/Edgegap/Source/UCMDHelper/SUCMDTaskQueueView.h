@@ -0,0 +1,31 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+#include "IUCMDHelperModule.h"
+
+/** Running and queued UCMD tasks, refreshed twice a second */
+class SUcmdTaskQueueView : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SUcmdTaskQueueView) { }
+	SLATE_END_ARGS()
+
+	static void RegisterTabSpawner();
+	static void UnregisterTabSpawner();
+
+	static void OpenTab();
+
+	void Construct(const FArguments& InArgs);
+
+private:
+	EActiveTimerReturnType Refresh(double InCurrentTime, float InDeltaTime);
+
+	TSharedRef<ITableRow> GenerateRow(TSharedPtr<FUcmdTaskQueueEntry> Entry, const TSharedRef<STableViewBase>& OwnerTable);
+
+	TSharedPtr<SListView<TSharedPtr<FUcmdTaskQueueEntry>>> ListView;
+	TArray<TSharedPtr<FUcmdTaskQueueEntry>> Entries;
+};
@@ -0,0 +1,360 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UCMDDockerProgress.h"
+#include "UCMDOutputMatcher.h"
+#include "Misc/ScopeLock.h"
+
+#define LOCTEXT_NAMESPACE "UCMDHelper"
+
+namespace
+{
+	TSharedPtr<FUcmdDockerProgress> CurrentProgress;
+
+	// Long digests are shortened the way docker push prints them
+	const int32 ShortLayerIDLen = 12;
+
+	FText FormatMB(int64 Bytes)
+	{
+		static const FNumberFormattingOptions Options = FNumberFormattingOptions().SetMinimumFractionalDigits(1).SetMaximumFractionalDigits(1);
+		return FText::AsNumber(Bytes / 1.0e6, &Options);
+	}
+
+	FText FormatDuration(double Seconds)
+	{
+		const int32 TotalSeconds = FMath::CeilToInt(Seconds);
+		return FText::FromString(FString::Printf(TEXT("%d:%02d"), TotalSeconds / 60, TotalSeconds % 60));
+	}
+}
+
+FText FUcmdDockerProgressSnapshot::Describe() const
+{
+	TArray<FText> Parts;
+
+	if (NumSteps > 0)
+	{
+		Parts.Add(FText::Format(LOCTEXT("DockerStep", "step {0}/{1}"), Step, NumSteps));
+	}
+
+	if (BytesTotal > 0)
+	{
+		Parts.Add(FText::Format(LOCTEXT("DockerBytes", "{0} / {1} MB"), FormatMB(BytesDone), FormatMB(BytesTotal)));
+	}
+	else if (BytesDone > 0)
+	{
+		Parts.Add(FText::Format(LOCTEXT("DockerBytesNoTotal", "{0} MB"), FormatMB(BytesDone)));
+	}
+
+	if (BytesPerSecond >= 0.0 && BytesDone > 0)
+	{
+		Parts.Add(FText::Format(LOCTEXT("DockerRate", "{0} MB/s"), FormatMB((int64)BytesPerSecond)));
+	}
+
+	if (EtaSeconds >= 0.0)
+	{
+		Parts.Add(FText::Format(LOCTEXT("DockerEta", "ETA {0}"), FormatDuration(EtaSeconds)));
+	}
+
+	if (Layers.Num() > 0 && BytesTotal == 0)
+	{
+		Parts.Add(FText::Format(LOCTEXT("DockerLayers", "{0}/{1} layers done"), NumLayersDone, Layers.Num()));
+	}
+
+	// Tells a stuck push from a slow one
+	if (!bFinished && SecondsSinceChange >= 15.0)
+	{
+		Parts.Add(FText::Format(LOCTEXT("DockerNoProgress", "no progress for {0}"), FormatDuration(SecondsSinceChange)));
+	}
+
+	return FText::Join(LOCTEXT("DockerProgressSeparator", ", "), Parts);
+}
+
+FUcmdDockerProgress::FUcmdDockerProgress(const FString& InTaskName)
+	: TaskName(InTaskName)
+	, StartTime(FPlatformTime::Seconds())
+	, LastChangeTime(StartTime)
+{
+}
+
+void FUcmdDockerProgress::ParseLine(const FString& Line, const FUcmdOutputMatch& Match)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	const int32 NumLayersBefore = Layers.Num();
+	const int32 StepBefore = Step;
+	const int64 BytesBefore = Samples.Num() > 0 ? Samples.Last().Value : 0;
+
+	if (Line.StartsWith(TEXT("#")))
+	{
+		ParseBuildKitLine(Line);
+	}
+	else if (Match.Has(EUcmdOutputPattern::DockerProgress))
+	{
+		ParseProgressBar(Line);
+	}
+	else if (Match.Has(EUcmdOutputPattern::DockerStatus))
+	{
+		ParseLayerStatus(Line);
+	}
+
+	AddSample();
+
+	if (Layers.Num() != NumLayersBefore || Step != StepBefore || Samples.Last().Value != BytesBefore || Match.Has(EUcmdOutputPattern::DockerStatus))
+	{
+		LastChangeTime = FPlatformTime::Seconds();
+	}
+}
+
+void FUcmdDockerProgress::MarkFinished()
+{
+	FScopeLock Lock(&CriticalSection);
+	bFinished = true;
+}
+
+bool FUcmdDockerProgress::HasProgress() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return bUnderstoodAnyLine;
+}
+
+FUcmdDockerProgressSnapshot FUcmdDockerProgress::GetSnapshot() const
+{
+	FScopeLock Lock(&CriticalSection);
+
+	const double Now = FPlatformTime::Seconds();
+
+	FUcmdDockerProgressSnapshot Snapshot;
+	Snapshot.TaskName = TaskName;
+	Snapshot.Layers = Layers;
+	Snapshot.Step = Step;
+	Snapshot.NumSteps = NumSteps;
+	Snapshot.StepName = StepName;
+	Snapshot.ElapsedSeconds = Now - StartTime;
+	Snapshot.SecondsSinceChange = Now - LastChangeTime;
+	Snapshot.bFinished = bFinished;
+
+	for (const FUcmdDockerLayer& Layer : Layers)
+	{
+		Snapshot.NumLayersDone += Layer.bDone ? 1 : 0;
+		Snapshot.BytesDone += Layer.BytesDone;
+		Snapshot.BytesTotal += Layer.BytesTotal;
+	}
+
+	// Measured up to now rather than the last sample, so a stall brings the rate down
+	if (Samples.Num() > 1 && !bFinished)
+	{
+		const double Elapsed = Now - Samples[0].Key;
+		if (Elapsed > 0.5)
+		{
+			Snapshot.BytesPerSecond = (Samples.Last().Value - Samples[0].Value) / Elapsed;
+		}
+	}
+
+	if (Snapshot.BytesPerSecond > 0.0 && Snapshot.BytesTotal > Snapshot.BytesDone)
+	{
+		Snapshot.EtaSeconds = (Snapshot.BytesTotal - Snapshot.BytesDone) / Snapshot.BytesPerSecond;
+	}
+
+	return Snapshot;
+}
+
+TSharedPtr<FUcmdDockerProgress> FUcmdDockerProgress::GetCurrent()
+{
+	check(IsInGameThread());
+	return CurrentProgress;
+}
+
+void FUcmdDockerProgress::SetCurrent(const TSharedPtr<FUcmdDockerProgress>& Progress)
+{
+	check(IsInGameThread());
+	CurrentProgress = Progress;
+}
+
+FUcmdDockerLayer& FUcmdDockerProgress::FindOrAddLayer(const FString& ID)
+{
+	const FString ShortID = ID.Left(ShortLayerIDLen);
+
+	if (const int32* Index = LayerIndices.Find(ShortID))
+	{
+		return Layers[*Index];
+	}
+
+	LayerIndices.Add(ShortID, Layers.Num());
+	FUcmdDockerLayer& Layer = Layers.AddDefaulted_GetRef();
+	Layer.ID = ShortID;
+	return Layer;
+}
+
+void FUcmdDockerProgress::ParseBuildKitLine(const FString& Line)
+{
+	TArray<FString> Tokens;
+	Line.ParseIntoArrayWS(Tokens);
+	if (Tokens.Num() < 2)
+	{
+		return;
+	}
+
+	const bool bDone = Tokens.Last() == TEXT("done") || Tokens.Last() == TEXT("DONE");
+
+	// "#7 sha256:<digest> 12.58MB / 45.21MB 2.1s [done]"
+	if (Tokens[1].StartsWith(TEXT("sha256:")))
+	{
+		FUcmdDockerLayer& Layer = FindOrAddLayer(Tokens[1].RightChop(7));
+		Layer.Status = bDone ? TEXT("Done") : TEXT("Downloading");
+
+		if (Tokens.Num() >= 5 && Tokens[3] == TEXT("/"))
+		{
+			ParseSize(Tokens[2], Layer.BytesDone);
+			ParseSize(Tokens[4], Layer.BytesTotal);
+		}
+		if (bDone)
+		{
+			Layer.bDone = true;
+			Layer.BytesDone = FMath::Max(Layer.BytesDone, Layer.BytesTotal);
+		}
+
+		bUnderstoodAnyLine = true;
+		return;
+	}
+
+	// "#4 transferring context: 45.2MB 2.1s [done]", the total isn't known up front
+	if (Tokens[1] == TEXT("transferring") && Tokens.Num() >= 4)
+	{
+		FUcmdDockerLayer& Layer = FindOrAddLayer(TEXT("context"));
+		Layer.Status = bDone ? TEXT("Sent") : TEXT("Sending build context");
+		ParseSize(Tokens[3], Layer.BytesDone);
+		Layer.bDone = bDone;
+
+		bUnderstoodAnyLine = true;
+		return;
+	}
+
+	// "#8 [2/4] COPY . /app" or "#8 [stage-1 2/4] RUN ..."
+	if (Tokens[1].StartsWith(TEXT("[")))
+	{
+		const int32 CloseIndex = Line.Find(TEXT("]"));
+		const int32 OpenIndex = Line.Find(TEXT("["));
+		if (CloseIndex == INDEX_NONE || CloseIndex < OpenIndex)
+		{
+			return;
+		}
+
+		FString Inside = Line.Mid(OpenIndex + 1, CloseIndex - OpenIndex - 1);
+		int32 SpaceIndex = INDEX_NONE;
+		if (Inside.FindLastChar(TEXT(' '), SpaceIndex))
+		{
+			Inside.RightChopInline(SpaceIndex + 1);
+		}
+
+		FString StepText, NumStepsText;
+		if (Inside.Split(TEXT("/"), &StepText, &NumStepsText) && StepText.IsNumeric() && NumStepsText.IsNumeric())
+		{
+			Step = FCString::Atoi(*StepText);
+			NumSteps = FCString::Atoi(*NumStepsText);
+			StepName = Line.RightChop(CloseIndex + 1).TrimStartAndEnd();
+			bUnderstoodAnyLine = true;
+		}
+	}
+}
+
+void FUcmdDockerProgress::ParseProgressBar(const FString& Line)
+{
+	// "5f70bf18a086: Pushing [=====>      ]  12.3MB/45.6MB"
+	FString ID, Rest;
+	if (!Line.Split(TEXT(": "), &ID, &Rest))
+	{
+		return;
+	}
+
+	FString Status, Bar, Bytes;
+	if (!Rest.Split(TEXT(" ["), &Status, &Bar) || !Bar.Split(TEXT("]"), nullptr, &Bytes))
+	{
+		return;
+	}
+
+	FString Done, Total;
+	FUcmdDockerLayer& Layer = FindOrAddLayer(ID.TrimStartAndEnd());
+	Layer.Status = Status;
+	if (Bytes.TrimStartAndEnd().Split(TEXT("/"), &Done, &Total))
+	{
+		ParseSize(Done, Layer.BytesDone);
+		ParseSize(Total, Layer.BytesTotal);
+	}
+
+	bUnderstoodAnyLine = true;
+}
+
+void FUcmdDockerProgress::ParseLayerStatus(const FString& Line)
+{
+	// "5f70bf18a086: Pushed", "5f70bf18a086: Mounted from library/ubuntu"
+	FString ID, Status;
+	if (!Line.Split(TEXT(": "), &ID, &Status) || ID.IsEmpty() || ID.Contains(TEXT(" ")))
+	{
+		return;
+	}
+
+	FUcmdDockerLayer& Layer = FindOrAddLayer(ID);
+	Layer.Status = Status.TrimStartAndEnd();
+	Layer.bDone = Layer.Status == TEXT("Pushed") || Layer.Status == TEXT("Layer already exists") || Layer.Status.StartsWith(TEXT("Mounted from"));
+	if (Layer.bDone)
+	{
+		Layer.BytesDone = FMath::Max(Layer.BytesDone, Layer.BytesTotal);
+	}
+
+	bUnderstoodAnyLine = true;
+}
+
+void FUcmdDockerProgress::AddSample()
+{
+	int64 BytesDone = 0;
+	for (const FUcmdDockerLayer& Layer : Layers)
+	{
+		BytesDone += Layer.BytesDone;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	Samples.Emplace(Now, BytesDone);
+
+	// Keep one sample from before the window, so the rate always spans it
+	int32 NumExpired = 0;
+	while (NumExpired + 1 < Samples.Num() && Samples[NumExpired + 1].Key < Now - RateWindow)
+	{
+		NumExpired++;
+	}
+	Samples.RemoveAt(0, NumExpired, false);
+}
+
+bool FUcmdDockerProgress::ParseSize(const FString& Text, int64& OutBytes)
+{
+	int32 UnitIndex = 0;
+	while (UnitIndex < Text.Len() && (FChar::IsDigit(Text[UnitIndex]) || Text[UnitIndex] == TEXT('.')))
+	{
+		UnitIndex++;
+	}
+
+	if (UnitIndex == 0)
+	{
+		return false;
+	}
+
+	const double Value = FCString::Atod(*Text.Left(UnitIndex));
+	const FString Unit = Text.RightChop(UnitIndex).TrimStartAndEnd();
+
+	double Scale = 1.0;
+	if (Unit.StartsWith(TEXT("k"), ESearchCase::IgnoreCase))
+	{
+		Scale = Unit.Contains(TEXT("i")) ? 1024.0 : 1.0e3;
+	}
+	else if (Unit.StartsWith(TEXT("M")))
+	{
+		Scale = Unit.Contains(TEXT("i")) ? 1024.0 * 1024.0 : 1.0e6;
+	}
+	else if (Unit.StartsWith(TEXT("G")))
+	{
+		Scale = Unit.Contains(TEXT("i")) ? 1024.0 * 1024.0 * 1024.0 : 1.0e9;
+	}
+
+	OutBytes = (int64)(Value * Scale);
+	return true;
+}
+
+#undef LOCTEXT_NAMESPACE
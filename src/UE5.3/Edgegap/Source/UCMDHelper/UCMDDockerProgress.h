@@ -0,0 +1,107 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+struct FUcmdOutputMatch;
+
+/** One layer being pulled or pushed, or the build context being sent */
+struct FUcmdDockerLayer
+{
+	FString ID;
+	FString Status;
+
+	// Zero while docker didn't say
+	int64 BytesDone = 0;
+	int64 BytesTotal = 0;
+
+	bool bDone = false;
+};
+
+/** The state of a docker build or push at one point in time */
+struct FUcmdDockerProgressSnapshot
+{
+	FString TaskName;
+	TArray<FUcmdDockerLayer> Layers;
+
+	int32 NumLayersDone = 0;
+
+	// Over the layers whose size is known
+	int64 BytesDone = 0;
+	int64 BytesTotal = 0;
+
+	// Over the last RateWindow seconds, negative until there are two samples
+	double BytesPerSecond = -1.0;
+	double EtaSeconds = -1.0;
+
+	// "#8 [2/4] COPY . /app"
+	int32 Step = 0;
+	int32 NumSteps = 0;
+	FString StepName;
+
+	double ElapsedSeconds = 0.0;
+	double SecondsSinceChange = 0.0;
+	bool bFinished = false;
+
+	/** "12.3 / 45.6 MB, 4.2 MB/s, ETA 0:07", "3/7 layers", "step 2/4"... */
+	FText Describe() const;
+};
+
+/**
+ * Follows a docker build or push through its output, per layer.
+ *
+ * Bytes are only known where docker prints them: BuildKit's plain progress (docker build --progress=plain) and
+ * the progress bars docker shows on a terminal. Through a pipe, docker push only reports each layer's state.
+ */
+class FUcmdDockerProgress
+{
+public:
+	explicit FUcmdDockerProgress(const FString& InTaskName);
+
+	/** Called on the process' thread with lines the output matcher flagged as docker progress or status */
+	void ParseLine(const FString& Line, const FUcmdOutputMatch& Match);
+
+	void MarkFinished();
+
+	/** Whether any line was understood, the task may not be a docker one at all */
+	bool HasProgress() const;
+
+	FUcmdDockerProgressSnapshot GetSnapshot() const;
+
+	/** The docker task shown in the progress tab. Game thread only. */
+	static TSharedPtr<FUcmdDockerProgress> GetCurrent();
+	static void SetCurrent(const TSharedPtr<FUcmdDockerProgress>& Progress);
+
+	static constexpr double RateWindow = 10.0;
+
+private:
+	FUcmdDockerLayer& FindOrAddLayer(const FString& ID);
+	void ParseBuildKitLine(const FString& Line);
+	void ParseProgressBar(const FString& Line);
+	void ParseLayerStatus(const FString& Line);
+	void AddSample();
+
+	/** "12.58MB", "1.2kB", "512B", as docker prints them (decimal units) */
+	static bool ParseSize(const FString& Text, int64& OutBytes);
+
+	const FString TaskName;
+	const double StartTime;
+
+	mutable FCriticalSection CriticalSection;
+
+	TArray<FUcmdDockerLayer> Layers;
+	TMap<FString, int32> LayerIndices;
+
+	int32 Step = 0;
+	int32 NumSteps = 0;
+	FString StepName;
+
+	// Time and bytes done, oldest first, covering RateWindow
+	TArray<TPair<double, int64>> Samples;
+
+	double LastChangeTime;
+	bool bUnderstoodAnyLine = false;
+	bool bFinished = false;
+};
@@ -17,6 +17,7 @@ namespace UnrealBuildTool.Rules
                     "GameProjectGeneration",
                     "UnrealEd",
 					"Analytics",
+					"Projects",
 			    }
 			);
 		}
@@ -12,14 +12,16 @@
 #include "Misc/MessageDialog.h"
 #include "Misc/Paths.h"
 #include "Stats/Stats.h"
-#include "Misc/MonitoredProcess.h"
+#include "Misc/ScopeLock.h"
 #include "Modules/ModuleManager.h"
 #include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
 #include "Framework/Docking/TabManager.h"
 #include "Editor.h"
 #include "EditorAnalytics.h"
 #include "IUCMDHelperModule.h"
-#include "AssetRegistry/AssetRegistryModule.h"
+#include "UCMDProcess.h"
 
 #include "Editor/MainFrame/Public/Interfaces/IMainFrameModule.h"
 #include "Editor/EditorPerProjectUserSettings.h"
@@ -30,26 +32,31 @@
 #include "Logging/MessageLog.h"
 #include "Developer/MessageLog/Public/IMessageLogListing.h"
 #include "Developer/MessageLog/Public/MessageLogModule.h"
-#include "Misc/UObjectToken.h"
 
 #include "GameProjectGenerationModule.h"
 #include "AnalyticsEventAttribute.h"
 
 #include "ShaderCompiler.h"
 
+#include "UCMDOutputBatch.h"
+#include "UCMDTaskLog.h"
+#include "UCMDDockerProgress.h"
+#include "SUCMDProgressView.h"
+#include "SUCMDTaskQueueView.h"
+
 #define LOCTEXT_NAMESPACE "UCMDHelper"
 
-DEFINE_LOG_CATEGORY_STATIC(UCMDHelper, Log, All);
+DEFINE_LOG_CATEGORY(UCMDHelper);
 
-/* Event Data
-*****************************************************************************/
-struct EventData
-{
-	FString EventName;
-	bool bProjectHasCode;
-	double StartTime;
-	IUCMDHelperModule::UcmdTaskResultCallack ResultCallback;
-};
+static TAutoConsoleVariable<int32> CVarUcmdMaxDockerTasks(
+	TEXT("UCMD.MaxDockerTasks"),
+	2,
+	TEXT("How many docker builds, logins and pushes run at once, the others wait in the UCMD task queue."));
+
+static TAutoConsoleVariable<int32> CVarUcmdMaxOtherTasks(
+	TEXT("UCMD.MaxOtherTasks"),
+	4,
+	TEXT("How many UCMD tasks that are neither UAT nor docker run at once, the others wait in the queue."));
 
 /* FMainFrameActionCallbacks callbacks
 *****************************************************************************/
@@ -72,20 +79,6 @@ public:
 		FMessageLog("PackagingResults").Open(EMessageSeverity::Error, true);
 	}
 
-	static void HandleDismissButtonClicked()
-	{
-		TSharedPtr<SNotificationItem> NotificationItem = ExpireNotificationItemPtr.Pin();
-		if (NotificationItem.IsValid())
-		{
-
-			NotificationItem->SetExpireDuration(0.0f);
-			NotificationItem->SetFadeOutDuration(0.0f);
-			NotificationItem->SetCompletionState(SNotificationItem::CS_Fail);
-			NotificationItem->ExpireAndFadeout();
-			ExpireNotificationItemPtr.Reset();
-		}
-	}
-
 	void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
 	{
 		if (NotificationItemPtr.IsValid())
@@ -114,7 +107,6 @@ public:
 
 			}
 
-			ExpireNotificationItemPtr = NotificationItem;
 			if (bExpireAndFadeout)
 			{
 				NotificationItem->SetExpireDuration(6.0f);
@@ -154,8 +146,6 @@ public:
 
 private:
 
-	static TWeakPtr<SNotificationItem> ExpireNotificationItemPtr;
-
 	SNotificationItem::ECompletionState CompletionState;
 	TWeakPtr<SNotificationItem> NotificationItemPtr;
 	FText Text;
@@ -163,254 +153,473 @@ private:
 	bool bExpireAndFadeout;
 };
 
-TWeakPtr<SNotificationItem> FMainFrameActionsNotificationTask::ExpireNotificationItemPtr;
+DECLARE_CYCLE_STAT(TEXT("Requesting FUCMDHelperModule::HandleUcmdProcessCompleted message dialog to present the error message"), STAT_FUCMDHelperModule_HandleUcmdProcessCompleted_DialogMessage, STATGROUP_TaskGraphTasks);
+
+
+const TCHAR* LexToString(EUcmdTaskResult Result)
+{
+	switch (Result)
+	{
+	case EUcmdTaskResult::Completed:
+		return TEXT("Completed");
+	case EUcmdTaskResult::Failed:
+		return TEXT("Failed");
+	case EUcmdTaskResult::Canceled:
+		return TEXT("Canceled");
+	case EUcmdTaskResult::FailedToStart:
+		return TEXT("FailedToStart");
+	default:
+		return TEXT("None");
+	}
+}
 
 /**
-* Helper class to deal with packaging issues encountered in UCMD.
+* One UCMD process and everything that belongs to it: its notification, output, log, error state and result promise.
+* Tasks share nothing, so several can run at once without touching each other's notification or errors.
+*
+* The process' thread only records how the task ended. The game thread reports the result once the last of the
+* output reached the Message Log, so the notification knows whether the cook found asset errors.
+*
+* A task waits in the module's queue until its resource has room. A batch task that gives way to an interactive one
+* goes back to the queue and runs again from the start, with a new process and log.
 **/
-class FPackagingErrorHandler
+class FUcmdTask : public TSharedFromThis<FUcmdTask>
 {
-
 public:
 
+	FUcmdTask(uint32 InTaskID, const FUcmdCommand& InCommand, EUcmdTaskResource InResource, EUcmdTaskPriority InPriority, const FText& InPlatformDisplayName, const FText& InTaskName, const FString& InEventName, bool bInProjectHasCode, const FString& InResultLocation, TSharedPtr<void> InUserContext)
+		: TaskID(InTaskID)
+		, Command(InCommand)
+		, Resource(InResource)
+		, Priority(InPriority)
+		, PlatformDisplayName(InPlatformDisplayName)
+		, TaskName(InTaskName)
+		, EventName(InEventName)
+		, bProjectHasCode(bInProjectHasCode)
+		, ResultLocation(InResultLocation)
+		, UserContext(MoveTemp(InUserContext))
+		, OutputBatch(MakeShared<FUcmdOutputBatch>(InPlatformDisplayName, InTaskName))
+		, StateTime(FPlatformTime::Seconds())
+	{
+	}
 
-private:
+	/** The notification showing the task's progress and then its result */
+	void SetNotification(TWeakPtr<SNotificationItem> InNotificationItemPtr, const FText& InProgressText)
+	{
+		NotificationItemPtr = InNotificationItemPtr;
+		ProgressText = InProgressText;
+	}
 
-	/**
-	* Create a message to send to the Message Log.
-	*
-	* @Param MessageString - The error we wish to send to the Message Log.
-	* @Param MessageType - The severity of the message, i.e. error, warning etc.
-	**/
-	static void AddMessageToMessageLog(FString MessageString, EMessageSeverity::Type MessageType)
+	/** Starts the process once the queue has room for it. A process that couldn't start is reported like any other result. */
+	bool Launch()
 	{
-		if (!bSawSummary && (MessageType == EMessageSeverity::Error || MessageType == EMessageSeverity::Warning))
-		{
-			FAssetData AssetData;
+		check(bQueued);
+		bQueued = false;
+		StateTime = FPlatformTime::Seconds();
 
-			// Parse the warning/error into an array and check whether there is an asset on the path
-			TArray<FString> MessageArray;
-			MessageString.ParseIntoArray(MessageArray, TEXT(": "), true);
+		if (TSharedPtr<SNotificationItem> NotificationItem = NotificationItemPtr.Pin())
+		{
+			NotificationItem->SetText(ProgressText);
+		}
 
-			FString AssetPath = MessageArray.Num() > 0 ? MessageArray[0] : TEXT("");
-			if (AssetPath.Len())
-			{
-				// Convert from the asset's full path provided by UE_ASSET_LOG back to an AssetData, if possible
-				FString LongPackageName;
-				FPaths::NormalizeFilename(AssetPath);
-				if (!FPaths::IsRelative(AssetPath) && FPackageName::TryConvertFilenameToLongPackageName(AssetPath, LongPackageName))
-				{
-					// Generate qualified asset path and query the registry
-					AssetPath = LongPackageName + TEXT(".") + FPackageName::GetShortName(LongPackageName);
-					FName AssetPathName(*AssetPath, FNAME_Find);
-					if (!AssetPathName.IsNone())
-					{
-						static const FName AssetRegistryModuleName(TEXT("AssetRegistry"));
-						FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryModuleName);
-						AssetData = AssetRegistryModule.Get().GetAssetByObjectPath(AssetPathName, true);
-					}
-				}
-			}
+		Process = MakeShared<FUcmdProcess>(Command, FPaths::RootDir());
+		TaskLog = FUcmdTaskLog::Open(TaskName.ToString(), PlatformDisplayName.ToString());
 
+		Process->OnCanceled().BindSP(this, &FUcmdTask::HandleProcessCanceled);
+		Process->OnCompleted().BindSP(this, &FUcmdTask::HandleProcessCompleted);
+		Process->OnOutput().BindSP(this, &FUcmdTask::HandleProcessOutput);
+		Process->OnErrorOutput().BindSP(this, &FUcmdTask::HandleProcessErrorOutput);
 
-			if (AssetData.IsValid())
-			{
-				// we have asset errors in the cook
-				if (MessageType == EMessageSeverity::Error)
-				{
-					bHasAssetErrors = true;
-				}
+		StartTime = StateTime;
+		if (!Process->Launch())
+		{
+			Finish(EUcmdTaskResult::FailedToStart, 0);
+			return false;
+		}
 
-				TSharedRef<FTokenizedMessage> PackagingMsg = MessageType == EMessageSeverity::Error ? FMessageLog("PackagingResults").Error()
-					: FMessageLog("PackagingResults").Warning();
+		GEditor->PlayEditorSound(TEXT("/Engine/EditorSounds/Notifications/CompileStart_Cue.CompileStart_Cue"));
+		return true;
+	}
 
-				PackagingMsg->AddToken(FTextToken::Create(FText::FromString(MessageArray.Num() > 1 ? MessageArray[1] : MessageString)));
+	/** Cancels the process, or takes the task out of the queue. Game thread only. */
+	void Cancel()
+	{
+		bPreempted = false;
+		if (bQueued)
+		{
+			bQueued = false;
+			Finish(EUcmdTaskResult::Canceled, 0);
+		}
+		else if (Process.IsValid())
+		{
+			Process->Cancel();
+		}
+	}
 
-				if (AssetData.IsValid())
-				{
-					PackagingMsg->AddToken(FUObjectToken::Create(AssetData.GetAsset()));
-				}
+	/** Makes way for an interactive task, the process is canceled and the task goes back to the queue once it ended */
+	void Preempt()
+	{
+		bPreempted = true;
+		Process->Cancel();
+	}
 
-			}
+	/** Whether the task gave way and should run again rather than report its result. Game thread only, once done. */
+	bool ShouldRequeue() const
+	{
+		return bPreempted && Result == EUcmdTaskResult::Canceled;
+	}
 
+	/** Puts a task that gave way back in the queue, keeping its place ahead of batch tasks created after it */
+	void Requeue()
+	{
+		bQueued = true;
+		bPreempted = false;
+		NumPreemptions++;
+		StateTime = FPlatformTime::Seconds();
+
+		Result = EUcmdTaskResult::None;
+		ReturnCode = 0;
+		StartTime = 0.0;
+		OutputBatch = MakeShared<FUcmdOutputBatch>(PlatformDisplayName, TaskName);
+		Process.Reset();
+		ResourceUsage = FUcmdResourceUsage();
+		ErrorTail.Reset();
+		OutputTail.Reset();
+		bMadeProgressCurrent = false;
+
+		if (TSharedPtr<SNotificationItem> NotificationItem = NotificationItemPtr.Pin())
+		{
+			NotificationItem->SetText(MakeQueuedText(ProgressText));
 		}
+	}
+
+	static FText MakeQueuedText(const FText& InProgressText)
+	{
+		return FText::Format(LOCTEXT("UcmdTaskQueuedNotification", "{0} (queued)"), InProgressText);
+	}
 
-		// note: CookResults:Warning: actually outputs some unhandled errors.
-		FText MsgText = FText::FromString(MessageString);
+	FUcmdTaskQueueEntry GetQueueEntry(double Now) const
+	{
+		FUcmdTaskQueueEntry Entry;
+		Entry.TaskID = TaskID;
+		Entry.TaskName = TaskName;
+		Entry.PlatformDisplayName = PlatformDisplayName;
+		Entry.Priority = Priority;
+		Entry.Resource = Resource;
+		Entry.bRunning = !bQueued;
+		Entry.Seconds = Now - StateTime;
+		Entry.NumPreemptions = NumPreemptions;
+		return Entry;
+	}
 
-		TSharedRef<FTokenizedMessage> Message = FTokenizedMessage::Create(MessageType);
-		Message->AddToken(FTextToken::Create(MsgText));
+	uint32 GetTaskID() const { return TaskID; }
+	const FText& GetTaskName() const { return TaskName; }
+	const FText& GetPlatformDisplayName() const { return PlatformDisplayName; }
+	EUcmdTaskResource GetResource() const { return Resource; }
+	EUcmdTaskPriority GetPriority() const { return Priority; }
+	bool IsQueued() const { return bQueued; }
+	bool IsPreempted() const { return bPreempted; }
 
-		FMessageLog MessageLog("PackagingResults");
-		MessageLog.AddMessage(Message);
+	/** When the task was queued, or when it started */
+	double GetStateTime() const { return StateTime; }
 
+	void Dismiss()
+	{
+		TSharedPtr<SNotificationItem> NotificationItem = NotificationItemPtr.Pin();
+		if (NotificationItem.IsValid())
+		{
+			NotificationItem->SetExpireDuration(0.0f);
+			NotificationItem->SetFadeOutDuration(0.0f);
+			NotificationItem->SetCompletionState(SNotificationItem::CS_Fail);
+			NotificationItem->ExpireAndFadeout();
+		}
 	}
 
-	/**
-	* Send Error to the Message Log.
-	*
-	* @Param MessageString - The error we wish to send to the Message Log.
-	* @Param MessageType - The severity of the message, i.e. error, warning etc.
-	**/
-	static void SyncMessageWithMessageLog(FString MessageString, EMessageSeverity::Type MessageType)
-	{
-		DECLARE_CYCLE_STAT(TEXT("FSimpleDelegateGraphTask.SendPackageErrorToMessageLog"),
-			STAT_FSimpleDelegateGraphTask_SendPackageErrorToMessageLog,
-			STATGROUP_TaskGraphTasks);
-
-		// Remove any new line terminators
-		MessageString.ReplaceInline(TEXT("\r"), TEXT(""));
-		MessageString.ReplaceInline(TEXT("\n"), TEXT(""));
-
-		/**
-		* Dispatch the error from packaging to the message log.
-		**/
-		FSimpleDelegateGraphTask::CreateAndDispatchWhenReady(
-			FSimpleDelegateGraphTask::FDelegate::CreateStatic(&FPackagingErrorHandler::AddMessageToMessageLog, MessageString, MessageType),
-			GET_STATID(STAT_FSimpleDelegateGraphTask_SendPackageErrorToMessageLog),
-			nullptr, ENamedThreads::GameThread
-		);
+	/** Shows docker's progress, if the task turned out to be a docker one. Game thread only. */
+	void UpdateNotification()
+	{
+		TSharedPtr<SNotificationItem> NotificationItem = NotificationItemPtr.Pin();
+		if (!NotificationItem.IsValid() || !OutputBatch->GetProgress()->HasProgress())
+		{
+			return;
+		}
+
+		// The progress tab follows the docker task that reported progress last
+		if (!bMadeProgressCurrent)
+		{
+			FUcmdDockerProgress::SetCurrent(OutputBatch->GetProgress());
+			bMadeProgressCurrent = true;
+		}
+
+		// Once finished, the notification shows the task's result instead
+		const FUcmdDockerProgressSnapshot Snapshot = OutputBatch->GetProgress()->GetSnapshot();
+		if (!Snapshot.bFinished)
+		{
+			NotificationItem->SetText(FText::Format(LOCTEXT("UcmdTaskProgressNotification", "{0}\n{1}"), ProgressText, Snapshot.Describe()));
+		}
 	}
 
-	// Whether there are asset errors in the cook, which can be navigated to in the content browser.
-	static bool bHasAssetErrors;
-	// Whether the cook summary has been seen in the log.
-	static bool bSawSummary;
+	const TSharedRef<FUcmdOutputBatch>& GetOutputBatch() const { return OutputBatch; }
 
-public:
+	/** Whether the process ended, or never will, and all of its output was handled. Game thread only. */
+	bool IsDone() const { return !bQueued && OutputBatch->IsDone(); }
 
-	/**
-	* Determine if the output is an communication message we wish to process.
-	*
-	* @Param UCMDOutput - The current line of output from the UCMD package process.
-	**/
-	static bool ProcessAndHandleCookMessageOutput(FString UCMDOutput)
+	/** Whether the process is running, or ended moments ago. Game thread only. */
+	bool IsRunning() const { return !bQueued && !OutputBatch->IsDone(); }
+
+	/** Updates the notification, reports to analytics and calls back. Game thread only, once the task is done. */
+	void ReportResult()
 	{
-		FString LhsUCMDOutputMsg, ParsedCookIssue;
-		if (UCMDOutput.Split(TEXT("Shaders left to compile "), &LhsUCMDOutputMsg, &ParsedCookIssue))
+		FFormatNamedArguments Arguments;
+		Arguments.Add(TEXT("Platform"), PlatformDisplayName);
+		Arguments.Add(TEXT("TaskName"), TaskName);
+
+		TArray<FAnalyticsEventAttribute> ParamArray;
+		ParamArray.Add(FAnalyticsEventAttribute(TEXT("Time"), TimeSec));
+
+		if (Result == EUcmdTaskResult::Canceled)
+		{
+			TGraphTask<FMainFrameActionsNotificationTask>::CreateTask().ConstructAndDispatchWhenReady(
+				NotificationItemPtr,
+				SNotificationItem::CS_Fail,
+				FText::Format(LOCTEXT("UcmdProcessFailedNotification", "{TaskName} canceled!"), Arguments)
+			);
+
+			FEditorAnalytics::ReportEvent(EventName + TEXT(".Canceled"), PlatformDisplayName.ToString(), bProjectHasCode, ParamArray);
+			//	FMessageLog("PackagingResults").Warning(FText::Format(LOCTEXT("UcmdProcessCanceledMessageLog", "{TaskName} for {Platform} canceled by user"), Arguments));
+		}
+		else if (Result == EUcmdTaskResult::Completed)
 		{
-			if (GShaderCompilingManager)
+			if (!ResultLocation.IsEmpty())
 			{
-				if (ParsedCookIssue.IsNumeric())
+				if (TSharedPtr<SNotificationItem> SharedNotificationItemPtr = NotificationItemPtr.Pin())
 				{
-					int32 ShadersLeft = FCString::Atoi(*ParsedCookIssue);
-					GShaderCompilingManager->SetExternalJobs(ShadersLeft);
+					SharedNotificationItemPtr->SetHyperlink(FSimpleDelegate::CreateStatic(&FUcmdTask::HandleUcmdResultHyperlinkNavigate, ResultLocation), LOCTEXT("ShowOutputLocation", "Show in Explorer"));
 				}
+
 			}
-			return false;
-		}
-		return true;
-	}
 
-	/**
-	* Determine if the output is an error we wish to send to the Message Log.
-	*
-	* @Param UCMDOutput - The current line of output from the UCMD package process.
-	**/
-	static void ProcessAndHandleCookErrorOutput(FString UCMDOutput)
-	{
-		FString LhsUCMDOutputMsg, ParsedCookIssue;
+			TGraphTask<FMainFrameActionsNotificationTask>::CreateTask().ConstructAndDispatchWhenReady(
+				NotificationItemPtr,
+				SNotificationItem::CS_Success,
+				FText::Format(LOCTEXT("UcmdProcessSucceededNotification", "{TaskName} complete!"), Arguments)
+			);
 
-		// we don't want to report duplicate warnings/errors to the package results log
-		// so, only add messages between the cook start and the summary
-		if (UCMDOutput.Contains(TEXT("Warning/Error Summary")))
-		{
-			bSawSummary = true;
-		}
+			FEditorAnalytics::ReportEvent(EventName + TEXT(".Completed"), PlatformDisplayName.ToString(), bProjectHasCode, ParamArray);
 
-		// note: CookResults:Warning: actually outputs some unhandled errors.
-		if (UCMDOutput.Split(TEXT("CookResults:Warning: "), &LhsUCMDOutputMsg, &ParsedCookIssue))
-		{
-			SyncMessageWithMessageLog(ParsedCookIssue, EMessageSeverity::Warning);
+			//		FMessageLog("PackagingResults").Info(FText::Format(LOCTEXT("UcmdProcessSuccessMessageLog", "{TaskName} for {Platform} completed successfully"), Arguments));
 		}
-		else if (UCMDOutput.Split(TEXT("CookResults:Error: "), &LhsUCMDOutputMsg, &ParsedCookIssue))
+		else if (Result == EUcmdTaskResult::Failed)
 		{
-			SyncMessageWithMessageLog(ParsedCookIssue, EMessageSeverity::Error);
+			TGraphTask<FMainFrameActionsNotificationTask>::CreateTask().ConstructAndDispatchWhenReady(
+				NotificationItemPtr,
+				SNotificationItem::CS_Fail,
+				FText::Format(LOCTEXT("PackagerFailedNotification", "{TaskName} failed!"), Arguments),
+				OutputBatch->HasAssetErrors() ? LOCTEXT("ShowResultsLogHyperlink", "Show Results Log") : FText(),
+				false);
+
+			FEditorAnalytics::ReportEvent(EventName + TEXT(".Failed"), PlatformDisplayName.ToString(), bProjectHasCode, ReturnCode, ParamArray);
+
+			// Present a message dialog if we want the error message to be prominent.
+			if (FEditorAnalytics::ShouldElevateMessageThroughDialog(ReturnCode))
+			{
+				const int32 FailedReturnCode = ReturnCode;
+				FSimpleDelegateGraphTask::CreateAndDispatchWhenReady(
+					FSimpleDelegateGraphTask::FDelegate::CreateLambda([FailedReturnCode]() {
+						FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(FEditorAnalytics::TranslateErrorCode(FailedReturnCode)));
+						}),
+					GET_STATID(STAT_FUCMDHelperModule_HandleUcmdProcessCompleted_DialogMessage),
+							nullptr,
+							ENamedThreads::GameThread
+							);
+			}
+
+			//		FMessageLog("PackagingResults").Info(FText::Format(LOCTEXT("UcmdProcessFailedMessageLog", "{TaskName} for {Platform} failed"), Arguments));
 		}
-		else if (!bSawSummary && UCMDOutput.Split(TEXT("Warning: "), &LhsUCMDOutputMsg, &ParsedCookIssue))
+		else if (Result == EUcmdTaskResult::FailedToStart)
 		{
-			SyncMessageWithMessageLog(ParsedCookIssue, EMessageSeverity::Warning);
+			GEditor->PlayEditorSound(TEXT("/Engine/EditorSounds/Notifications/CompileFailed_Cue.CompileFailed_Cue"));
+
+			TGraphTask<FMainFrameActionsNotificationTask>::CreateTask().ConstructAndDispatchWhenReady(
+				NotificationItemPtr,
+				SNotificationItem::CS_Fail,
+				LOCTEXT("UcmdLaunchFailedNotification", "Failed to launch Unreal Automation Tool (UCMD)!")
+			);
+
+			FEditorAnalytics::ReportEvent(EventName + TEXT(".Failed"), PlatformDisplayName.ToString(), bProjectHasCode, EAnalyticsErrorCodes::UATLaunchFailure, ParamArray);
 		}
-		else if (!bSawSummary && UCMDOutput.Split(TEXT("Error: "), &LhsUCMDOutputMsg, &ParsedCookIssue))
+
+		// Other tasks running next to this one don't compile shaders
+		if (GShaderCompilingManager && OutputBatch->HandlesCookMessages())
 		{
-			SyncMessageWithMessageLog(ParsedCookIssue, EMessageSeverity::Error);
+			GShaderCompilingManager->SetExternalJobs(0);
 		}
 
+		FUcmdResult TaskResult;
+		TaskResult.Result = Result;
+		TaskResult.ExitCode = ReturnCode;
+		TaskResult.WallSeconds = TimeSec;
+		TaskResult.Usage = ResourceUsage;
+		TaskResult.OutputTail = OutputTail;
+		TaskResult.LogPath = GetLogPath();
+		TaskResult.UserContext = UserContext;
+		ResultPromise.SetValue(MoveTemp(TaskResult));
 	}
 
-	/**
-	* Send the UCMD Packaging error message to the Message Log.
-	*
-	* @Param ErrorCode - The UCMD return code we received and wish to display the error message for.
-	**/
-	static void SendPackagingErrorToMessageLog(int32 ErrorCode)
+	/** Set by ReportResult. Only one caller can have it. */
+	TFuture<FUcmdResult> GetFuture()
 	{
-		SyncMessageWithMessageLog(FEditorAnalytics::TranslateErrorCode(ErrorCode), EMessageSeverity::Error);
+		return ResultPromise.GetFuture();
 	}
 
-	/**
-	* Get Whether the UCMD process returned asset errors via the log
-	**/
-	static bool GetHasAssetErrors() { return bHasAssetErrors; }
+private:
 
-	/**
-	* Clear the asset error state for the UCMD process
-	**/
-	static void ClearAssetErrors() { bHasAssetErrors = false; bSawSummary = false; }
+	FString GetLogPath() const
+	{
+		return TaskLog.IsValid() ? TaskLog->GetPath() : FString();
+	}
 
-};
+	static void HandleUcmdResultHyperlinkNavigate(FString InResultLocation)
+	{
+		if (!InResultLocation.IsEmpty())
+		{
+			FPlatformProcess::ExploreFolder(*(InResultLocation));
+		}
+	}
 
-bool FPackagingErrorHandler::bHasAssetErrors = false;
-bool FPackagingErrorHandler::bSawSummary = false;
+	static void AddToTail(TArray<FString>& Tail, const FString& Line, int32 MaxLines)
+	{
+		Tail.Add(Line);
+		if (Tail.Num() > MaxLines)
+		{
+			Tail.RemoveAt(0);
+		}
+	}
 
-DECLARE_CYCLE_STAT(TEXT("Requesting FUCMDHelperModule::HandleUcmdProcessCompleted message dialog to present the error message"), STAT_FUCMDHelperModule_HandleUcmdProcessCompleted_DialogMessage, STATGROUP_TaskGraphTasks);
+	void HandleProcessOutput(FString Output)
+	{
+		TaskLog->AppendLine(Output);
+		OutputBatch->AddLine(Output);
+		AddToTail(OutputTail, Output, MaxOutputTailLines);
+	}
 
+	/** Standard error goes to the same log and matcher, docker reports its progress there */
+	void HandleProcessErrorOutput(FString Output)
+	{
+		TaskLog->AppendLine(Output);
+		OutputBatch->AddLine(Output);
 
-class  FMonitoredCMDProcess
-	: public FMonitoredProcess
-{
-public:
+		AddToTail(ErrorTail, Output, MaxErrorTailLines);
+		AddToTail(OutputTail, Output, MaxOutputTailLines);
+	}
 
-	FMonitoredCMDProcess(const FString& InURL, const FString& InParams, bool InHidden, bool InCreatePipes)
-		: FMonitoredProcess(InURL, InParams, FPaths::RootDir(), InHidden, InCreatePipes)
+	void HandleProcessCanceled()
 	{
+		Finish(EUcmdTaskResult::Canceled, 0);
 	}
 
+	void HandleProcessCompleted(int32 InReturnCode)
+	{
+		Finish(InReturnCode == 0 ? EUcmdTaskResult::Completed : EUcmdTaskResult::Failed, InReturnCode);
+	}
 
-
-	virtual bool Launch() override
+	/** Records how the task ended, on the process' thread, or on the game thread when it didn't start */
+	void Finish(EUcmdTaskResult InResult, int32 InReturnCode)
 	{
-		if (bIsRunning)
-		{
-			return false;
-		}
+		// Whatever is still pending belongs in the log before the result does
+		OutputBatch->Flush();
+		OutputBatch->GetProgress()->MarkFinished();
 
-		check(Thread == nullptr); // We shouldn't be calling this twice
+		Result = InResult;
+		ReturnCode = InReturnCode;
+		TimeSec = StartTime == 0.0 || InResult == EUcmdTaskResult::FailedToStart ? 0.0 : FPlatformTime::Seconds() - StartTime;
 
-		if (bCreatePipes && !FPlatformProcess::CreatePipe(ReadPipe, WritePipe))
+		ResourceUsage = Process.IsValid() ? Process->GetResourceUsage() : FUcmdResourceUsage();
+		if (TaskLog.IsValid() && ResourceUsage.NumSamples > 0)
 		{
-			return false;
+			TaskLog->AppendLine(FString::Printf(TEXT("Resources: %s"), *ResourceUsage.ToString()));
+			UE_LOG(UCMDHelper, Log, TEXT("%s (%s) used %s"), *TaskName.ToString(), *PlatformDisplayName.ToString(), *ResourceUsage.ToString());
 		}
 
-		ProcessHandle = FPlatformProcess::CreateProc(*URL, *Params, false, Hidden, Hidden, nullptr, 0, *WorkingDir, WritePipe);
-
-		if (!ProcessHandle.IsValid())
+		if (!TaskLog.IsValid())
 		{
-			return false;
+			// Canceled while queued, there is no output
 		}
-
-		static std::atomic<uint32> MonitoredProcessIndex{ 0 };
-		const FString MonitoredProcessName = FString::Printf(TEXT("FMonitoredCMDProcess %d"), MonitoredProcessIndex.fetch_add(1));
-
-		bIsRunning = true;
-		Thread = FRunnableThread::Create(this, *MonitoredProcessName, 128 * 1024, TPri_AboveNormal);
-		if (!FPlatformProcess::SupportsMultithreading())
+		else if (Result == EUcmdTaskResult::Canceled)
+		{
+			TaskLog->Close(bPreempted ? TEXT("Canceled to make way for an interactive task, it will run again") : TEXT("Canceled"));
+		}
+		else if (Result == EUcmdTaskResult::Completed)
 		{
-			StartTime = FDateTime::UtcNow();
+			TaskLog->Close(TEXT("Completed"));
 		}
+		else if (Result == EUcmdTaskResult::FailedToStart)
+		{
+			TaskLog->Close(TEXT("Failed to start"));
+		}
+		else
+		{
+			TaskLog->Close(FString::Printf(TEXT("Failed with exit code %d"), ReturnCode));
+			UE_LOG(UCMDHelper, Warning, TEXT("%s (%s) failed with exit code %d, its output is in %s"), *TaskName.ToString(), *PlatformDisplayName.ToString(), ReturnCode, *TaskLog->GetPath());
+			for (const FString& Line : ErrorTail)
+			{
+				UE_LOG(UCMDHelper, Warning, TEXT("    %s"), *Line);
+			}
 
-		return true;
+			// Send the error to the Message Log.
+			if (TaskName.EqualTo(LOCTEXT("PackagingTaskName", "Packaging")))
+			{
+				OutputBatch->QueuePackagingError(ReturnCode);
+			}
+		}
+
+		// The game thread reports the result once the batch handed over the last message
+		OutputBatch->MarkFinished();
 	}
+
+	const uint32 TaskID;
+	const FUcmdCommand Command;
+	const EUcmdTaskResource Resource;
+	const EUcmdTaskPriority Priority;
+
+	TSharedPtr<FUcmdProcess> Process;
+
+	const FText PlatformDisplayName;
+	const FText TaskName;
+	const FString EventName;
+	const bool bProjectHasCode;
+	const FString ResultLocation;
+	const TSharedPtr<void> UserContext;
+	TPromise<FUcmdResult> ResultPromise;
+
+	TWeakPtr<SNotificationItem> NotificationItemPtr;
+	FText ProgressText;
+
+	// Replaced when the task goes back to the queue
+	TSharedRef<FUcmdOutputBatch> OutputBatch;
+	TSharedPtr<FUcmdTaskLog> TaskLog;
+	bool bMadeProgressCurrent = false;
+
+	// The last lines of standard error, logged when the task fails. Process' thread only.
+	static constexpr int32 MaxErrorTailLines = 10;
+	TArray<FString> ErrorTail;
+
+	// The last lines of both, for the result. Written on the process' thread, read once the task is done.
+	static constexpr int32 MaxOutputTailLines = 50;
+	TArray<FString> OutputTail;
+
+	// Game thread only, except for Finish reading bPreempted
+	bool bQueued = true;
+	std::atomic<bool> bPreempted{ false };
+	int32 NumPreemptions = 0;
+	double StateTime;
+
+	// Set by Finish before the batch is marked finished, read on the game thread after
+	double StartTime = 0.0;
+	double TimeSec = 0.0;
+	FUcmdResourceUsage ResourceUsage;
+	EUcmdTaskResult Result = EUcmdTaskResult::None;
+	int32 ReturnCode = 0;
 };
 
 
@@ -423,52 +632,35 @@ public:
 
 	virtual void StartupModule() override
 	{
+		OutputTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FUCMDHelperModule::HandleOutputTicker));
+		FUcmdTaskLogWriter::Get().Startup();
+		SUcmdProgressView::RegisterTabSpawner();
+		SUcmdTaskQueueView::RegisterTabSpawner();
 	}
 
 	virtual void ShutdownModule() override
 	{
+		FTSTicker::GetCoreTicker().RemoveTicker(OutputTickerHandle);
+		FUcmdTaskLogWriter::Get().Shutdown();
+		SUcmdProgressView::UnregisterTabSpawner();
+		SUcmdTaskQueueView::UnregisterTabSpawner();
 	}
 
-	virtual void CreateUcmdTask(const FString& CommandLine, const FText& PlatformDisplayName, const FText& TaskName, const FText& TaskShortName, const FSlateBrush* TaskIcon, bool PowerShell, UcmdTaskResultCallack ResultCallback, const FString& ResultLocation)
+	virtual TFuture<FUcmdResult> CreateUcmdTask(const FUcmdCommand& Command, const FText& PlatformDisplayName, const FText& TaskName, const FText& TaskShortName, const FSlateBrush* TaskIcon, const FString& ResultLocation, EUcmdTaskPriority Priority, TSharedPtr<void> UserContext) override
 	{
-
-		FString CmdExe = "";
-		#if PLATFORM_WINDOWS
-				if (PowerShell)
-					CmdExe = TEXT("powershell");
-				else
-					CmdExe = TEXT("cmd.exe");
-		#elif PLATFORM_LINUX
-				FString CmdExe = TEXT("/bin/bash");
-		#else
-				FString CmdExe = TEXT("/bin/sh");
-		#endif
-
-				FString FullCommandLine = "";
-		#if PLATFORM_WINDOWS
-				if (PowerShell)
-					FullCommandLine = FString::Printf(TEXT("-command \"%s\""), *CommandLine);
-				else
-					FullCommandLine = FString::Printf(TEXT("/c \"%s\""), *CommandLine);
-
-		#else
-				FString FullCommandLine = FString::Printf(TEXT("%s"), *CommandLine);
-		#endif
-
-
-		TSharedPtr<FMonitoredCMDProcess> UcmdProcess = MakeShareable(new FMonitoredCMDProcess(CmdExe, FullCommandLine, true, true));
-
 		FGameProjectGenerationModule& GameProjectModule = FModuleManager::LoadModuleChecked<FGameProjectGenerationModule>(TEXT("GameProjectGeneration"));
 		bool bHasCode = GameProjectModule.Get().ProjectHasCodeFiles();
 
-		FPackagingErrorHandler::ClearAssetErrors();
+		FString EventName = (Command.Arguments.Contains(TEXT("-package")) ? TEXT("Editor.Package") : TEXT("Editor.Cook"));
+		TSharedRef<FUcmdTask> Task = MakeShared<FUcmdTask>(NextTaskID++, Command, GetTaskResource(Command), Priority, PlatformDisplayName, TaskShortName, EventName, bHasCode, ResultLocation, UserContext);
 
 		// create notification item
 		FFormatNamedArguments Arguments;
 		Arguments.Add(TEXT("Platform"), PlatformDisplayName);
 		Arguments.Add(TEXT("TaskName"), TaskName);
 		FText NotificationFormat = (PlatformDisplayName.IsEmpty()) ? LOCTEXT("UcmdTaskInProgressNotificationNoPlatform", "{TaskName}...") : LOCTEXT("UcmdTaskInProgressNotification", "{TaskName} for {Platform}...");
-		FNotificationInfo Info(FText::Format(NotificationFormat, Arguments));
+		const FText InProgressText = FText::Format(NotificationFormat, Arguments);
+		FNotificationInfo Info(FUcmdTask::MakeQueuedText(InProgressText));
 
 		Info.Image = TaskIcon;
 		Info.bFireAndForget = false;
@@ -480,243 +672,283 @@ public:
 			FNotificationButtonInfo(
 				LOCTEXT("UcmdTaskCancel", "Cancel"),
 				LOCTEXT("UcmdTaskCancelToolTip", "Cancels execution of this task."),
-				FSimpleDelegate::CreateStatic(&FUCMDHelperModule::HandleUcmdCancelButtonClicked, UcmdProcess),
+				FSimpleDelegate::CreateSP(Task, &FUcmdTask::Cancel),
 				SNotificationItem::CS_Pending
 			)
 		);
+		const bool bDockerTask = GetTaskResource(Command) == EUcmdTaskResource::Docker;
+		if (bDockerTask)
+		{
+			Info.ButtonDetails.Add(
+				FNotificationButtonInfo(
+					LOCTEXT("UcmdTaskShowProgress", "Show Progress"),
+					LOCTEXT("UcmdTaskShowProgressToolTip", "Shows the progress of each layer docker is building or pushing."),
+					FSimpleDelegate::CreateStatic(&SUcmdProgressView::OpenTab),
+					SNotificationItem::CS_Pending
+				)
+			);
+		}
+		Info.ButtonDetails.Add(
+			FNotificationButtonInfo(
+				LOCTEXT("UcmdTaskShowTasks", "Show Tasks"),
+				LOCTEXT("UcmdTaskShowTasksToolTip", "Shows the running and queued tasks."),
+				FSimpleDelegate::CreateStatic(&SUcmdTaskQueueView::OpenTab),
+				SNotificationItem::CS_Pending
+			)
+		);
+		// The failed notification stays after the task is gone, so its button keeps the task alive
 		Info.ButtonDetails.Add(
 			FNotificationButtonInfo(
 				LOCTEXT("UcmdTaskDismiss", "Dismiss"),
 				FText(),
-				FSimpleDelegate::CreateStatic(&FMainFrameActionsNotificationTask::HandleDismissButtonClicked),
+				FSimpleDelegate::CreateLambda([Task]() { Task->Dismiss(); }),
 				SNotificationItem::CS_Fail
 			)
 		);
 
 		TSharedPtr<SNotificationItem> NotificationItem = FSlateNotificationManager::Get().AddNotification(Info);
-		TSharedPtr<SNotificationItem> OldNotification = NotificationItemPtr.Pin();
-		if (OldNotification.IsValid())
-		{
-			OldNotification->Fadeout();
-		}
 
 		if (!NotificationItem.IsValid())
 		{
-			return;
+			UE_LOG(UCMDHelper, Warning, TEXT("%s not started, notifications are unavailable"), *TaskName.ToString());
+
+			FUcmdResult NotStarted;
+			NotStarted.Result = EUcmdTaskResult::FailedToStart;
+			NotStarted.UserContext = UserContext;
+			return MakeFulfilledPromise<FUcmdResult>(MoveTemp(NotStarted)).GetFuture();
 		}
 
-		FString EventName = (CommandLine.Contains(TEXT("-package")) ? TEXT("Editor.Package") : TEXT("Editor.Cook"));
 		FEditorAnalytics::ReportEvent(EventName + TEXT(".Start"), PlatformDisplayName.ToString(), bHasCode);
 
 		NotificationItem->SetCompletionState(SNotificationItem::CS_Pending);
 
-		// launch the packager
-		NotificationItemPtr = NotificationItem;
+		Task->SetNotification(NotificationItem, InProgressText);
+		Tasks.Add(Task);
 
-		EventData Data;
-		Data.StartTime = FPlatformTime::Seconds();
-		Data.EventName = EventName;
-		Data.bProjectHasCode = bHasCode;
-		Data.ResultCallback = ResultCallback;
-		UcmdProcess->OnCanceled().BindStatic(&FUCMDHelperModule::HandleUcmdProcessCanceled, NotificationItemPtr, PlatformDisplayName, TaskShortName, Data);
-		UcmdProcess->OnCompleted().BindStatic(&FUCMDHelperModule::HandleUcmdProcessCompleted, NotificationItemPtr, PlatformDisplayName, TaskShortName, Data, ResultLocation);
-		UcmdProcess->OnOutput().BindStatic(&FUCMDHelperModule::HandleUcmdProcessOutput, NotificationItemPtr, PlatformDisplayName, TaskShortName);
+		FEditorDelegates::OnShutdownPostPackagesSaved.Add(FSimpleDelegate::CreateSP(Task, &FUcmdTask::Cancel));
 
-		TWeakPtr<FMonitoredCMDProcess> UcmdProcessPtr(UcmdProcess);
-		FEditorDelegates::OnShutdownPostPackagesSaved.Add(FSimpleDelegate::CreateStatic(&FUCMDHelperModule::HandleUcmdCancelButtonClicked, UcmdProcessPtr));
+		TFuture<FUcmdResult> Result = Task->GetFuture();
 
-		UcmdProcess->Launch();
-		GEditor->PlayEditorSound(TEXT("/Engine/EditorSounds/Notifications/CompileStart_Cue.CompileStart_Cue"));
-	}
+		// launch the packager, unless its resource is busy
+		StartQueuedTasks();
 
-	static void HandleUcmdHyperlinkNavigate()
-	{
-		FGlobalTabmanager::Get()->TryInvokeTab(FName("OutputLog"));
+		return Result;
 	}
 
-	static void HandleUcmdResultHyperlinkNavigate(FString ResultLocation)
+	virtual void GetTaskQueue(TArray<FUcmdTaskQueueEntry>& OutEntries) const override
 	{
-		if (!ResultLocation.IsEmpty())
+		const double Now = FPlatformTime::Seconds();
+
+		TArray<TSharedPtr<FUcmdTask>> SortedTasks = Tasks;
+		SortedTasks.StableSort([](const TSharedPtr<FUcmdTask>& A, const TSharedPtr<FUcmdTask>& B)
+		{
+			if (A->IsQueued() != B->IsQueued())
+			{
+				return !A->IsQueued();
+			}
+			return A->IsQueued() ? StartsBefore(*A, *B) : A->GetStateTime() < B->GetStateTime();
+		});
+
+		for (const TSharedPtr<FUcmdTask>& Task : SortedTasks)
 		{
-			FPlatformProcess::ExploreFolder(*(ResultLocation));
+			OutEntries.Add(Task->GetQueueEntry(Now));
 		}
 	}
 
-	static void HandleUcmdCancelButtonClicked(TSharedPtr<FMonitoredCMDProcess> PackagerProcess)
+	virtual void CancelTask(uint32 TaskID) override
 	{
-		if (PackagerProcess.IsValid())
+		if (const TSharedPtr<FUcmdTask>* Task = Tasks.FindByPredicate([TaskID](const TSharedPtr<FUcmdTask>& Candidate) { return Candidate->GetTaskID() == TaskID; }))
 		{
-			PackagerProcess->Cancel(true);
+			(*Task)->Cancel();
 		}
 	}
 
-	static void HandleUcmdCancelButtonClicked(TWeakPtr<FMonitoredCMDProcess> PackagerProcessPtr)
+	static EUcmdTaskResource GetTaskResource(const FUcmdCommand& Command)
 	{
-		TSharedPtr<FMonitoredCMDProcess> PackagerProcess = PackagerProcessPtr.Pin();
-		if (PackagerProcess.IsValid())
+		const FString Program = FPaths::GetBaseFilename(Command.Executable);
+		if (Program.Equals(TEXT("RunUAT"), ESearchCase::IgnoreCase))
 		{
-			PackagerProcess->Cancel(true);
+			return EUcmdTaskResource::UAT;
 		}
+		if (Program.Equals(TEXT("docker"), ESearchCase::IgnoreCase))
+		{
+			return EUcmdTaskResource::Docker;
+		}
+		return EUcmdTaskResource::Other;
 	}
 
-	static void HandleUcmdProcessCanceled(TWeakPtr<SNotificationItem> NotificationItemPtr, FText PlatformDisplayName, FText TaskName, EventData Event)
+	static int32 GetResourceLimit(EUcmdTaskResource Resource)
 	{
-		FFormatNamedArguments Arguments;
-		Arguments.Add(TEXT("Platform"), PlatformDisplayName);
-		Arguments.Add(TEXT("TaskName"), TaskName);
-
-		TGraphTask<FMainFrameActionsNotificationTask>::CreateTask().ConstructAndDispatchWhenReady(
-			NotificationItemPtr,
-			SNotificationItem::CS_Fail,
-			FText::Format(LOCTEXT("UcmdProcessFailedNotification", "{TaskName} canceled!"), Arguments)
-		);
-
-		TArray<FAnalyticsEventAttribute> ParamArray;
-		const double TimeSec = FPlatformTime::Seconds() - Event.StartTime;
-		ParamArray.Add(FAnalyticsEventAttribute(TEXT("Time"), TimeSec));
-		FEditorAnalytics::ReportEvent(Event.EventName + TEXT(".Canceled"), PlatformDisplayName.ToString(), Event.bProjectHasCode, ParamArray);
-		if (Event.ResultCallback)
+		switch (Resource)
 		{
-			Event.ResultCallback(TEXT("Canceled"), TimeSec);
+		case EUcmdTaskResource::UAT:
+			// A second cook only competes with the first for disk and CPU
+			return 1;
+		case EUcmdTaskResource::Docker:
+			return FMath::Max(1, CVarUcmdMaxDockerTasks.GetValueOnGameThread());
+		default:
+			return FMath::Max(1, CVarUcmdMaxOtherTasks.GetValueOnGameThread());
 		}
-		if (GShaderCompilingManager)
+	}
+
+	/** Interactive tasks first, then in the order they were created */
+	static bool StartsBefore(const FUcmdTask& A, const FUcmdTask& B)
+	{
+		if (A.GetPriority() != B.GetPriority())
 		{
-			GShaderCompilingManager->SetExternalJobs(0);
+			return A.GetPriority() == EUcmdTaskPriority::Interactive;
 		}
-		//	FMessageLog("PackagingResults").Warning(FText::Format(LOCTEXT("UcmdProcessCanceledMessageLog", "{TaskName} for {Platform} canceled by user"), Arguments));
+		return A.GetTaskID() < B.GetTaskID();
 	}
 
-	static void HandleUcmdProcessCompleted(int32 ReturnCode, TWeakPtr<SNotificationItem> NotificationItemPtr, FText PlatformDisplayName, FText TaskName, EventData Event, FString ResultLocation)
+	/**
+	* Starts queued tasks while their resource has room. An interactive task that still has to wait takes the place of
+	* the batch task that started last, which goes back to the queue.
+	**/
+	void StartQueuedTasks()
 	{
-		FFormatNamedArguments Arguments;
-		Arguments.Add(TEXT("Platform"), PlatformDisplayName);
-		Arguments.Add(TEXT("TaskName"), TaskName);
-		const double TimeSec = FPlatformTime::Seconds() - Event.StartTime;
-
-		if (ReturnCode == 0)
+		for (const EUcmdTaskResource Resource : { EUcmdTaskResource::UAT, EUcmdTaskResource::Docker, EUcmdTaskResource::Other })
 		{
-			if (!ResultLocation.IsEmpty())
+			TArray<TSharedPtr<FUcmdTask>> Queued;
+			int32 NumRunning = 0;
+			for (const TSharedPtr<FUcmdTask>& Task : Tasks)
 			{
-				if (TSharedPtr<SNotificationItem> SharedNotificationItemPtr = NotificationItemPtr.Pin())
+				if (Task->GetResource() != Resource)
 				{
-					SharedNotificationItemPtr->SetHyperlink(FSimpleDelegate::CreateStatic(&FUCMDHelperModule::HandleUcmdResultHyperlinkNavigate, ResultLocation), LOCTEXT("ShowOutputLocation", "Show in Explorer"));
+					continue;
+				}
+				if (Task->IsQueued())
+				{
+					Queued.Add(Task);
+				}
+				else if (!Task->IsDone())
+				{
+					NumRunning++;
 				}
-
 			}
 
-			TGraphTask<FMainFrameActionsNotificationTask>::CreateTask().ConstructAndDispatchWhenReady(
-				NotificationItemPtr,
-				SNotificationItem::CS_Success,
-				FText::Format(LOCTEXT("UcmdProcessSucceededNotification", "{TaskName} complete!"), Arguments)
-			);
+			Queued.Sort([](const TSharedPtr<FUcmdTask>& A, const TSharedPtr<FUcmdTask>& B) { return StartsBefore(*A, *B); });
 
-			TArray<FAnalyticsEventAttribute> ParamArray;
-			ParamArray.Add(FAnalyticsEventAttribute(TEXT("Time"), TimeSec));
-			FEditorAnalytics::ReportEvent(Event.EventName + TEXT(".Completed"), PlatformDisplayName.ToString(), Event.bProjectHasCode, ParamArray);
-			if (Event.ResultCallback)
+			const int32 Limit = GetResourceLimit(Resource);
+			int32 NumStarted = 0;
+			for (; NumStarted < Queued.Num() && NumRunning < Limit; ++NumStarted, ++NumRunning)
 			{
-				Event.ResultCallback(TEXT("Completed"), TimeSec);
+				Queued[NumStarted]->Launch();
 			}
 
-			//		FMessageLog("PackagingResults").Info(FText::Format(LOCTEXT("UcmdProcessSuccessMessageLog", "{TaskName} for {Platform} completed successfully"), Arguments));
-		}
-		else
-		{
-			TGraphTask<FMainFrameActionsNotificationTask>::CreateTask().ConstructAndDispatchWhenReady(
-				NotificationItemPtr,
-				SNotificationItem::CS_Fail,
-				FText::Format(LOCTEXT("PackagerFailedNotification", "{TaskName} failed!"), Arguments),
-				FPackagingErrorHandler::GetHasAssetErrors() ? LOCTEXT("ShowResultsLogHyperlink", "Show Results Log") : FText(),
-				false);
-
-			TArray<FAnalyticsEventAttribute> ParamArray;
-			ParamArray.Add(FAnalyticsEventAttribute(TEXT("Time"), TimeSec));
-			FEditorAnalytics::ReportEvent(Event.EventName + TEXT(".Failed"), PlatformDisplayName.ToString(), Event.bProjectHasCode, ReturnCode, ParamArray);
-			if (Event.ResultCallback)
+			int32 NumInteractiveWaiting = 0;
+			for (int32 Index = NumStarted; Index < Queued.Num(); ++Index)
 			{
-				Event.ResultCallback(TEXT("Failed"), TimeSec);
+				NumInteractiveWaiting += Queued[Index]->GetPriority() == EUcmdTaskPriority::Interactive ? 1 : 0;
 			}
 
-			// Send the error to the Message Log.
-			if (TaskName.EqualTo(LOCTEXT("PackagingTaskName", "Packaging")))
+			TArray<TSharedPtr<FUcmdTask>> Preemptible;
+			for (const TSharedPtr<FUcmdTask>& Task : Tasks)
 			{
-				FPackagingErrorHandler::SendPackagingErrorToMessageLog(ReturnCode);
+				if (Task->GetResource() == Resource && Task->IsRunning() && Task->GetPriority() == EUcmdTaskPriority::Batch)
+				{
+					if (Task->IsPreempted())
+					{
+						NumInteractiveWaiting--;
+					}
+					else
+					{
+						Preemptible.Add(Task);
+					}
+				}
 			}
 
-			// Present a message dialog if we want the error message to be prominent.
-			if (FEditorAnalytics::ShouldElevateMessageThroughDialog(ReturnCode))
+			Preemptible.Sort([](const TSharedPtr<FUcmdTask>& A, const TSharedPtr<FUcmdTask>& B) { return A->GetStateTime() > B->GetStateTime(); });
+			for (int32 Index = 0; Index < NumInteractiveWaiting && Index < Preemptible.Num(); ++Index)
 			{
-				FSimpleDelegateGraphTask::CreateAndDispatchWhenReady(
-					FSimpleDelegateGraphTask::FDelegate::CreateLambda([=]() {
-						FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(FEditorAnalytics::TranslateErrorCode(ReturnCode)));
-						}),
-					GET_STATID(STAT_FUCMDHelperModule_HandleUcmdProcessCompleted_DialogMessage),
-							nullptr,
-							ENamedThreads::GameThread
-							);
+				UE_LOG(UCMDHelper, Log, TEXT("%s (%s) makes way for an interactive task, it will run again once there is room"), *Preemptible[Index]->GetTaskName().ToString(), *Preemptible[Index]->GetPlatformDisplayName().ToString());
+				Preemptible[Index]->Preempt();
 			}
+		}
+	}
 
-			//		FMessageLog("PackagingResults").Info(FText::Format(LOCTEXT("UcmdProcessFailedMessageLog", "{TaskName} for {Platform} failed"), Arguments));
+	static void HandleUcmdHyperlinkNavigate()
+	{
+		FGlobalTabmanager::Get()->TryInvokeTab(FName("OutputLog"));
+	}
+
+	bool HandleOutputTicker(float DeltaTime)
+	{
+		const double Now = FPlatformTime::Seconds();
+
+		const bool bFlushOutput = Now >= NextOutputFlushTime;
+		if (bFlushOutput)
+		{
+			NextOutputFlushTime = Now + OutputFlushInterval;
 		}
-		if (GShaderCompilingManager)
+
+		const bool bUpdateProgress = Now >= NextProgressUpdateTime;
+		if (bUpdateProgress)
 		{
-			GShaderCompilingManager->SetExternalJobs(0);
+			NextProgressUpdateTime = Now + ProgressUpdateInterval;
 		}
-	}
 
-	static void HandleUcmdProcessOutput(FString Output, TWeakPtr<SNotificationItem> NotificationItemPtr, FText PlatformDisplayName, FText TaskName)
-	{
-		if (!Output.IsEmpty() && !Output.Equals("\r"))
+		// However much a cook warns, the frame only spends the budget on it and the rest waits for the next one
+		TArray<TSharedRef<FTokenizedMessage>> Messages;
+		for (const TSharedPtr<FUcmdTask>& Task : Tasks)
 		{
-			bool bDisplayLog = true;
-			if (TaskName.EqualTo(LOCTEXT("PackagingTaskName", "Packaging")))
+			const TSharedRef<FUcmdOutputBatch>& OutputBatch = Task->GetOutputBatch();
+			if (bFlushOutput)
 			{
-				// Deal with any cook messages that may have been encountered.
-				bDisplayLog = FPackagingErrorHandler::ProcessAndHandleCookMessageOutput(Output);
+				OutputBatch->FlushIfOlderThan(OutputFlushInterval);
 			}
-			if (bDisplayLog)
+			OutputBatch->DrainMessages(Now + MessageDrainBudget, Messages);
+			if (bUpdateProgress)
 			{
-				UE_LOG(UCMDHelper, Log, TEXT("%s (%s): %s"), *TaskName.ToString(), *PlatformDisplayName.ToString(), *Output);
+				Task->UpdateNotification();
 			}
+		}
 
-			if (TaskName.EqualTo(LOCTEXT("PackagingTaskName", "Packaging")))
+		if (Messages.Num() > 0)
+		{
+			FMessageLog("PackagingResults").AddMessages(Messages);
+		}
+
+		// Continuations of the results may start the next task, so they run once the finished ones are out of the list
+		TArray<TSharedPtr<FUcmdTask>> DoneTasks;
+		Tasks.RemoveAll([&DoneTasks](const TSharedPtr<FUcmdTask>& Task)
+		{
+			if (!Task->IsDone())
 			{
-				// Deal with any cook errors that may have been encountered.
-				FPackagingErrorHandler::ProcessAndHandleCookErrorOutput(Output);
+				return false;
 			}
-			if (TaskName.EqualTo(LOCTEXT("CookingTaskName", "Cooking")))
+			if (Task->ShouldRequeue())
 			{
-				// Deal with any cook errors that may have been encountered.
-				FPackagingErrorHandler::ProcessAndHandleCookErrorOutput(Output);
+				Task->Requeue();
+				return false;
 			}
-		}
-	}
-
-	static void HandleUcmdLaunchFailed(TWeakPtr<SNotificationItem> NotificationItemPtr, FText PlatformDisplayName, FText TaskName, EventData Event)
-	{
-		GEditor->PlayEditorSound(TEXT("/Engine/EditorSounds/Notifications/CompileFailed_Cue.CompileFailed_Cue"));
-
-		TGraphTask<FMainFrameActionsNotificationTask>::CreateTask().ConstructAndDispatchWhenReady(
-			NotificationItemPtr,
-			SNotificationItem::CS_Fail,
-			LOCTEXT("UcmdLaunchFailedNotification", "Failed to launch Unreal Automation Tool (UCMD)!")
-		);
+			DoneTasks.Add(Task);
+			return true;
+		});
 
-		TArray<FAnalyticsEventAttribute> ParamArray;
-		ParamArray.Add(FAnalyticsEventAttribute(TEXT("Time"), 0.0));
-		FEditorAnalytics::ReportEvent(Event.EventName + TEXT(".Failed"), PlatformDisplayName.ToString(), Event.bProjectHasCode, EAnalyticsErrorCodes::UATLaunchFailure, ParamArray);
-		if (Event.ResultCallback)
+		for (const TSharedPtr<FUcmdTask>& Task : DoneTasks)
 		{
-			Event.ResultCallback(TEXT("FailedToStart"), 0.0f);
+			Task->ReportResult();
 		}
+
+		StartQueuedTasks();
+
+		return true;
 	}
 
 private:
-	TWeakPtr<SNotificationItem> NotificationItemPtr;
+	// Queued and running tasks, kept until their messages reached the Message Log and their result was reported
+	static constexpr float OutputFlushInterval = 0.25f;
+	static constexpr double MessageDrainBudget = 0.002;
+	TArray<TSharedPtr<FUcmdTask>> Tasks;
+	uint32 NextTaskID = 1;
+	double NextOutputFlushTime = 0.0;
+	FTSTicker::FDelegateHandle OutputTickerHandle;
+
+	// Docker's byte counts and rate in the task's notification
+	static constexpr double ProgressUpdateInterval = 0.5;
+	double NextProgressUpdateTime = 0.0;
 
 };
 
 IMPLEMENT_MODULE(FUCMDHelperModule, UCMDHelper)
-
-
-#undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -2,3 +2,7 @@
 
 #pragma once
 
+#include "Logging/LogMacros.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(UCMDHelper, Log, All);
+
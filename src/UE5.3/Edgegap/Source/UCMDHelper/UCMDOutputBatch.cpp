@@ -0,0 +1,407 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UCMDOutputBatch.h"
+#include "UCMDHelperModule.h"
+#include "UCMDOutputMatcher.h"
+#include "UCMDDockerProgress.h"
+#include "Misc/Paths.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopeLock.h"
+#include "Modules/ModuleManager.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/UObjectToken.h"
+#include "EditorAnalytics.h"
+#include "ShaderCompiler.h"
+
+#define LOCTEXT_NAMESPACE "UCMDHelper"
+
+/**
+* Helper class to deal with packaging issues encountered in UCMD.
+**/
+class FPackagingErrorHandler
+{
+
+public:
+
+	/**
+	* Create the messages to send to the Message Log. Must be called on the game thread.
+	*
+	* @Param PackagingMessage - The error we wish to send to the Message Log, and its severity.
+	* @Param ErrorState - The state of the task the message came from.
+	* @Param OutMessages - The messages are added here, to be added to the Message Log together.
+	**/
+	static void CreateMessageLogMessages(const FPackagingMessage& PackagingMessage, FPackagingErrorState& ErrorState, TArray<TSharedRef<FTokenizedMessage>>& OutMessages)
+	{
+		const FString& MessageString = PackagingMessage.Text;
+		const EMessageSeverity::Type MessageType = PackagingMessage.Severity;
+
+		if (!PackagingMessage.bAfterSummary && (MessageType == EMessageSeverity::Error || MessageType == EMessageSeverity::Warning))
+		{
+			FAssetData AssetData;
+
+			// Parse the warning/error into an array and check whether there is an asset on the path
+			TArray<FString> MessageArray;
+			MessageString.ParseIntoArray(MessageArray, TEXT(": "), true);
+
+			FString AssetPath = MessageArray.Num() > 0 ? MessageArray[0] : TEXT("");
+			if (AssetPath.Len())
+			{
+				// Convert from the asset's full path provided by UE_ASSET_LOG back to an AssetData, if possible
+				FString LongPackageName;
+				FPaths::NormalizeFilename(AssetPath);
+				if (!FPaths::IsRelative(AssetPath) && FPackageName::TryConvertFilenameToLongPackageName(AssetPath, LongPackageName))
+				{
+					// Generate qualified asset path and query the registry
+					AssetPath = LongPackageName + TEXT(".") + FPackageName::GetShortName(LongPackageName);
+					FName AssetPathName(*AssetPath, FNAME_Find);
+					if (!AssetPathName.IsNone())
+					{
+						static const FName AssetRegistryModuleName(TEXT("AssetRegistry"));
+						FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryModuleName);
+						AssetData = AssetRegistryModule.Get().GetAssetByObjectPath(AssetPathName, true);
+					}
+				}
+			}
+
+
+			if (AssetData.IsValid())
+			{
+				// we have asset errors in the cook
+				if (MessageType == EMessageSeverity::Error)
+				{
+					ErrorState.bHasAssetErrors = true;
+				}
+
+				TSharedRef<FTokenizedMessage> PackagingMsg = FTokenizedMessage::Create(MessageType);
+
+				PackagingMsg->AddToken(FTextToken::Create(FText::FromString(MessageArray.Num() > 1 ? MessageArray[1] : MessageString)));
+
+				if (AssetData.IsValid())
+				{
+					PackagingMsg->AddToken(FUObjectToken::Create(AssetData.GetAsset()));
+				}
+
+				OutMessages.Add(PackagingMsg);
+			}
+
+		}
+
+		// note: CookResults:Warning: actually outputs some unhandled errors.
+		FText MsgText = FText::FromString(MessageString);
+
+		TSharedRef<FTokenizedMessage> Message = FTokenizedMessage::Create(MessageType);
+		Message->AddToken(FTextToken::Create(MsgText));
+
+		OutMessages.Add(Message);
+	}
+
+private:
+
+	/**
+	* Queue Error for the Message Log.
+	*
+	* @Param MessageString - The error we wish to send to the Message Log.
+	* @Param MessageType - The severity of the message, i.e. error, warning etc.
+	* @Param ErrorState - The state of the task the message came from.
+	* @Param OutMessages - The messages found in the output so far, handed to the game thread together.
+	**/
+	static void SyncMessageWithMessageLog(FString MessageString, EMessageSeverity::Type MessageType, const FPackagingErrorState& ErrorState, TArray<FPackagingMessage>& OutMessages)
+	{
+		// Remove any new line terminators
+		MessageString.ReplaceInline(TEXT("\r"), TEXT(""));
+		MessageString.ReplaceInline(TEXT("\n"), TEXT(""));
+
+		OutMessages.Add({ MoveTemp(MessageString), MessageType, ErrorState.bSawSummary });
+	}
+
+public:
+
+	/**
+	* Determine if the output is an communication message we wish to process.
+	*
+	* @Param UCMDOutput - The current line of output from the UCMD package process.
+	* @Param Match - What the output matcher found in the line.
+	* @Param OutShadersLeft - Set to the number of shaders left to compile, if the line reports it.
+	**/
+	static bool ProcessAndHandleCookMessageOutput(const FString& UCMDOutput, const FUcmdOutputMatch& Match, int32& OutShadersLeft)
+	{
+		if (Match.Has(EUcmdOutputPattern::ShadersLeft))
+		{
+			const FString ParsedCookIssue = Match.GetRemainder(UCMDOutput, EUcmdOutputPattern::ShadersLeft);
+			if (ParsedCookIssue.IsNumeric())
+			{
+				OutShadersLeft = FCString::Atoi(*ParsedCookIssue);
+			}
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	* Determine if the output is an error we wish to send to the Message Log.
+	*
+	* @Param UCMDOutput - The current line of output from the UCMD package process.
+	* @Param Match - What the output matcher found in the line.
+	* @Param ErrorState - The state of the task the line came from.
+	* @Param OutMessages - Warnings and errors for the Message Log are added here.
+	**/
+	static void ProcessAndHandleCookErrorOutput(const FString& UCMDOutput, const FUcmdOutputMatch& Match, FPackagingErrorState& ErrorState, TArray<FPackagingMessage>& OutMessages)
+	{
+		// we don't want to report duplicate warnings/errors to the package results log
+		// so, only add messages between the cook start and the summary
+		if (Match.Has(EUcmdOutputPattern::Summary))
+		{
+			ErrorState.bSawSummary = true;
+		}
+
+		// note: CookResults:Warning: actually outputs some unhandled errors.
+		if (Match.Has(EUcmdOutputPattern::CookResultsWarning))
+		{
+			SyncMessageWithMessageLog(Match.GetRemainder(UCMDOutput, EUcmdOutputPattern::CookResultsWarning), EMessageSeverity::Warning, ErrorState, OutMessages);
+		}
+		else if (Match.Has(EUcmdOutputPattern::CookResultsError))
+		{
+			SyncMessageWithMessageLog(Match.GetRemainder(UCMDOutput, EUcmdOutputPattern::CookResultsError), EMessageSeverity::Error, ErrorState, OutMessages);
+		}
+		else if (!ErrorState.bSawSummary && Match.Has(EUcmdOutputPattern::Warning))
+		{
+			SyncMessageWithMessageLog(Match.GetRemainder(UCMDOutput, EUcmdOutputPattern::Warning), EMessageSeverity::Warning, ErrorState, OutMessages);
+		}
+		else if (!ErrorState.bSawSummary && Match.Has(EUcmdOutputPattern::Error))
+		{
+			SyncMessageWithMessageLog(Match.GetRemainder(UCMDOutput, EUcmdOutputPattern::Error), EMessageSeverity::Error, ErrorState, OutMessages);
+		}
+
+	}
+
+	/**
+	* Send the UCMD Packaging error message to the Message Log.
+	*
+	* @Param ErrorCode - The UCMD return code we received and wish to display the error message for.
+	* @Param ErrorState - The state of the task that failed.
+	* @Param OutMessages - The error message is added here.
+	**/
+	static void SendPackagingErrorToMessageLog(int32 ErrorCode, const FPackagingErrorState& ErrorState, TArray<FPackagingMessage>& OutMessages)
+	{
+		SyncMessageWithMessageLog(FEditorAnalytics::TranslateErrorCode(ErrorCode), EMessageSeverity::Error, ErrorState, OutMessages);
+	}
+
+};
+
+FUcmdOutputBatch::FUcmdOutputBatch(const FText& PlatformDisplayName, const FText& TaskName)
+	: LinePrefix(FString::Printf(TEXT("%s (%s): "), *TaskName.ToString(), *PlatformDisplayName.ToString()))
+	, bHandleCookMessages(TaskName.EqualTo(LOCTEXT("PackagingTaskName", "Packaging")))
+	, bHandleCookErrors(bHandleCookMessages || TaskName.EqualTo(LOCTEXT("CookingTaskName", "Cooking")))
+	, Progress(MakeShared<FUcmdDockerProgress>(TaskName.ToString()))
+{
+}
+
+void FUcmdOutputBatch::AddLine(const FString& Line)
+{
+	if (Line.IsEmpty() || Line.Equals(TEXT("\r")))
+	{
+		return;
+	}
+
+	FScopeLock Lock(&CriticalSection);
+
+	if (PendingLines.Num() == 0)
+	{
+		FirstPendingTime = FPlatformTime::Seconds();
+	}
+
+	PendingChars += Line.Len();
+	PendingLines.Add(Line);
+
+	if (PendingLines.Num() >= FUcmdOutputMatcher::MaxChunkLines || PendingChars >= FUcmdOutputMatcher::MaxChunkChars)
+	{
+		FlushLocked();
+	}
+}
+
+void FUcmdOutputBatch::FlushIfOlderThan(double MaxAge)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	if (PendingLines.Num() > 0 && FPlatformTime::Seconds() - FirstPendingTime >= MaxAge)
+	{
+		FlushLocked();
+	}
+}
+
+void FUcmdOutputBatch::Flush()
+{
+	FScopeLock Lock(&CriticalSection);
+	FlushLocked();
+}
+
+void FUcmdOutputBatch::QueueMessages(TArray<FPackagingMessage>&& Messages)
+{
+	if (IsInGameThread())
+	{
+		// Behind whatever the process' thread queued before
+		FPackagingMessage Message;
+		while (MessageQueue.Dequeue(Message))
+		{
+			GameThreadMessages.Add(MoveTemp(Message));
+		}
+		GameThreadMessages.Append(MoveTemp(Messages));
+		return;
+	}
+
+	for (FPackagingMessage& Message : Messages)
+	{
+		MessageQueue.Enqueue(MoveTemp(Message));
+	}
+}
+
+void FUcmdOutputBatch::QueuePackagingError(int32 ReturnCode)
+{
+	TArray<FPackagingMessage> Messages;
+	{
+		FScopeLock Lock(&CriticalSection);
+		FPackagingErrorHandler::SendPackagingErrorToMessageLog(ReturnCode, ErrorState, Messages);
+	}
+	QueueMessages(MoveTemp(Messages));
+}
+
+void FUcmdOutputBatch::DrainMessages(double Deadline, TArray<TSharedRef<FTokenizedMessage>>& OutMessages)
+{
+	int32 NumDrained = 0;
+	for (; NumDrained < GameThreadMessages.Num() && FPlatformTime::Seconds() < Deadline; ++NumDrained)
+	{
+		FPackagingErrorHandler::CreateMessageLogMessages(GameThreadMessages[NumDrained], ErrorState, OutMessages);
+	}
+	GameThreadMessages.RemoveAt(0, NumDrained, false);
+
+	if (GameThreadMessages.Num() > 0)
+	{
+		return;
+	}
+
+	FPackagingMessage Message;
+	while (FPlatformTime::Seconds() < Deadline && MessageQueue.Dequeue(Message))
+	{
+		FPackagingErrorHandler::CreateMessageLogMessages(Message, ErrorState, OutMessages);
+	}
+}
+
+void FUcmdOutputBatch::MarkFinished()
+{
+	Progress->MarkFinished();
+	bFinished = true;
+}
+
+void FUcmdOutputBatch::FlushLocked()
+{
+	if (PendingLines.Num() == 0)
+	{
+		return;
+	}
+
+	const FUcmdOutputMatcher& Matcher = FUcmdOutputMatcher::Get();
+
+	FString LogChunk;
+	LogChunk.Reserve(PendingChars + PendingLines.Num() * (LinePrefix.Len() + 2));
+
+	// Progress bars redraw the same layer many times a second. Of a run of redraws only each layer's last state is
+	// logged, where the run started, so the lines around it keep their order
+	TArray<TPair<FString, const FString*>, TInlineAllocator<8>> ProgressLines;
+
+	auto AppendProgressLines = [this, &LogChunk, &ProgressLines]()
+	{
+		for (const TPair<FString, const FString*>& ProgressLine : ProgressLines)
+		{
+			LogChunk += LinePrefix;
+			LogChunk += *ProgressLine.Value;
+			LogChunk += LINE_TERMINATOR;
+			++NumLoggedLines;
+		}
+		ProgressLines.Reset();
+	};
+
+	int32 ShadersLeft = INDEX_NONE;
+	TArray<FPackagingMessage> Messages;
+
+	for (const FString& Line : PendingLines)
+	{
+		const FUcmdOutputMatch Match = Matcher.Match(Line);
+
+		bool bDisplayLog = true;
+		if (bHandleCookMessages)
+		{
+			// Deal with any cook messages that may have been encountered.
+			bDisplayLog = FPackagingErrorHandler::ProcessAndHandleCookMessageOutput(Line, Match, ShadersLeft);
+		}
+
+		if (Match.Has(EUcmdOutputPattern::DockerProgress) || Match.Has(EUcmdOutputPattern::DockerStatus))
+		{
+			Progress->ParseLine(Line, Match);
+		}
+
+		if (bDisplayLog && Match.Has(EUcmdOutputPattern::DockerProgress))
+		{
+			FString Layer = GetProgressLayer(Line, Match);
+			TPair<FString, const FString*>* Existing = ProgressLines.FindByPredicate([&Layer](const TPair<FString, const FString*>& ProgressLine) { return ProgressLine.Key == Layer; });
+			if (Existing)
+			{
+				Existing->Value = &Line;
+			}
+			else
+			{
+				ProgressLines.Emplace(MoveTemp(Layer), &Line);
+			}
+		}
+		else if (bDisplayLog)
+		{
+			AppendProgressLines();
+
+			LogChunk += LinePrefix;
+			LogChunk += Line;
+			LogChunk += LINE_TERMINATOR;
+			++NumLoggedLines;
+		}
+
+		if (bHandleCookErrors)
+		{
+			// Deal with any cook errors that may have been encountered.
+			FPackagingErrorHandler::ProcessAndHandleCookErrorOutput(Line, Match, ErrorState, Messages);
+		}
+	}
+
+	AppendProgressLines();
+
+	if (ShadersLeft != INDEX_NONE && GShaderCompilingManager)
+	{
+		GShaderCompilingManager->SetExternalJobs(ShadersLeft);
+	}
+
+	if (!LogChunk.IsEmpty())
+	{
+		LogChunk.LeftChopInline(FCString::Strlen(LINE_TERMINATOR), false);
+		UE_LOG(UCMDHelper, Log, TEXT("%s"), *LogChunk);
+	}
+
+	if (Messages.Num() > 0)
+	{
+		QueueMessages(MoveTemp(Messages));
+	}
+
+	PendingLines.Reset();
+	PendingChars = 0;
+}
+
+FString FUcmdOutputBatch::GetProgressLayer(const FString& Line, const FUcmdOutputMatch& Match)
+{
+	int32 End = Match.End[(int32)EUcmdOutputPattern::DockerProgress];
+	if (Line.StartsWith(TEXT("#")))
+	{
+		while (End < Line.Len() && !FChar::IsWhitespace(Line[End]))
+		{
+			++End;
+		}
+	}
+	return Line.Left(End);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,112 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Containers/SpscQueue.h"
+#include "Logging/TokenizedMessage.h"
+#include <atomic>
+
+struct FUcmdOutputMatch;
+class FUcmdDockerProgress;
+
+/**
+* A warning or error found in UCMD output, on its way to the Message Log.
+**/
+struct FPackagingMessage
+{
+	FString Text;
+	EMessageSeverity::Type Severity;
+	// Messages after the cook summary repeat earlier ones, they aren't looked up as assets again
+	bool bAfterSummary;
+};
+
+/**
+* Where one task's output is in the cook, and what the Message Log got from it so far.
+**/
+struct FPackagingErrorState
+{
+	// Whether the cook summary has been seen in the log. Only used on the process' thread.
+	bool bSawSummary = false;
+	// Whether there are asset errors in the cook, which can be navigated to in the content browser. Game thread only.
+	bool bHasAssetErrors = false;
+};
+
+/**
+* Collects the output of one UCMD process and handles it a chunk at a time: each line is matched once against
+* the precompiled patterns, and the chunk goes to the log as a single entry instead of one per line.
+*
+* Warnings and errors for the Message Log go through a single producer/single consumer queue from the process'
+* thread to the game thread, which drains it within a time budget each frame.
+**/
+class FUcmdOutputBatch
+{
+public:
+
+	FUcmdOutputBatch(const FText& PlatformDisplayName, const FText& TaskName);
+
+	const TSharedRef<FUcmdDockerProgress>& GetProgress() const { return Progress; }
+
+	bool HandlesCookMessages() const { return bHandleCookMessages; }
+
+	/** Called on the process' thread for each line of output */
+	void AddLine(const FString& Line);
+
+	/** Handles lines that waited at least MaxAge seconds, so a quiet process still shows up in the log */
+	void FlushIfOlderThan(double MaxAge);
+
+	void Flush();
+
+	/** Called on the process' thread, or on the game thread which then keeps the messages itself */
+	void QueueMessages(TArray<FPackagingMessage>&& Messages);
+
+	/** Queues the Message Log entry explaining the exit code of a failed package */
+	void QueuePackagingError(int32 ReturnCode);
+
+	/** Turns queued messages into Message Log entries until Deadline. Game thread only. */
+	void DrainMessages(double Deadline, TArray<TSharedRef<FTokenizedMessage>>& OutMessages);
+
+	/** Set once the process ended and its last output was flushed */
+	void MarkFinished();
+
+	/** Whether nothing more will come from this process. Game thread only. */
+	bool IsDone() const
+	{
+		return bFinished && GameThreadMessages.Num() == 0 && MessageQueue.IsEmpty();
+	}
+
+	/** Whether the Message Log got errors pointing at assets. Game thread only. */
+	bool HasAssetErrors() const
+	{
+		return ErrorState.bHasAssetErrors;
+	}
+
+	/** Lines that went to the log so far, after progress redraws were folded */
+	int32 GetNumLoggedLines() const { return NumLoggedLines; }
+
+private:
+
+	void FlushLocked();
+
+	/** "5f70bf18a086: Pushing [==>  ]" is keyed by everything up to the bar, "#7 sha256:<digest> 12MB / 45MB" up to the digest's end */
+	static FString GetProgressLayer(const FString& Line, const FUcmdOutputMatch& Match);
+
+	const FString LinePrefix;
+	const bool bHandleCookMessages;
+	const bool bHandleCookErrors;
+
+	const TSharedRef<FUcmdDockerProgress> Progress;
+
+	FCriticalSection CriticalSection;
+	TArray<FString> PendingLines;
+	int32 PendingChars = 0;
+	double FirstPendingTime = 0.0;
+	int32 NumLoggedLines = 0;
+
+	FPackagingErrorState ErrorState;
+
+	TSpscQueue<FPackagingMessage> MessageQueue;
+	TArray<FPackagingMessage> GameThreadMessages;
+	std::atomic<bool> bFinished{ false };
+};
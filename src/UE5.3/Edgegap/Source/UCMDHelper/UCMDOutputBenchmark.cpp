@@ -0,0 +1,248 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UCMDOutputBatch.h"
+#include "UCMDHelperModule.h"
+#include "HAL/IConsoleManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "ShaderCompiler.h"
+
+// Replays recorded process output (a UAT log, or the output of docker build/push saved to a file) through the
+// per line handling UCMDHelper used before, and through FUcmdOutputBatch, which the tasks use.
+//
+//   UCMD.Bench.Output [<LogFile> ...] [-Repeat=N] [-Task=Packaging|Cooking|Containerizing] [-NoLog]
+//
+// Without log files it replays the recordings in the plugin's Resources/UCMDBench. The per line pass logs to the
+// UCMDHelperBench category and the batched one to UCMDHelper, -NoLog measures the matching alone.
+
+#define LOCTEXT_NAMESPACE "UCMDHelper"
+
+DEFINE_LOG_CATEGORY_STATIC(UCMDHelperBench, Log, All);
+
+namespace
+{
+	struct FBenchCounts
+	{
+		int32 Logged = 0;
+		int32 Warnings = 0;
+		int32 Errors = 0;
+	};
+
+	struct FBenchInput
+	{
+		FString Name;
+		FString Task;
+		TArray<FString> Lines;
+	};
+
+	void RunLegacy(const TArray<FString>& Lines, const FText& TaskName, const FText& PlatformDisplayName, bool bLog, FBenchCounts& Counts)
+	{
+		bool bSawSummary = false;
+
+		for (const FString& Output : Lines)
+		{
+			if (Output.IsEmpty() || Output.Equals(TEXT("\r")))
+			{
+				continue;
+			}
+
+			FString Lhs, Rhs;
+			bool bDisplayLog = true;
+			if (TaskName.EqualTo(LOCTEXT("PackagingTaskName", "Packaging")) && Output.Split(TEXT("Shaders left to compile "), &Lhs, &Rhs))
+			{
+				bDisplayLog = false;
+			}
+			if (bDisplayLog)
+			{
+				++Counts.Logged;
+				if (bLog)
+				{
+					UE_LOG(UCMDHelperBench, Log, TEXT("%s (%s): %s"), *TaskName.ToString(), *PlatformDisplayName.ToString(), *Output);
+				}
+			}
+
+			if (TaskName.EqualTo(LOCTEXT("PackagingTaskName", "Packaging")) || TaskName.EqualTo(LOCTEXT("CookingTaskName", "Cooking")))
+			{
+				if (Output.Contains(TEXT("Warning/Error Summary")))
+				{
+					bSawSummary = true;
+				}
+
+				if (Output.Split(TEXT("CookResults:Warning: "), &Lhs, &Rhs))
+				{
+					++Counts.Warnings;
+				}
+				else if (Output.Split(TEXT("CookResults:Error: "), &Lhs, &Rhs))
+				{
+					++Counts.Errors;
+				}
+				else if (!bSawSummary && Output.Split(TEXT("Warning: "), &Lhs, &Rhs))
+				{
+					++Counts.Warnings;
+				}
+				else if (!bSawSummary && Output.Split(TEXT("Error: "), &Lhs, &Rhs))
+				{
+					++Counts.Errors;
+				}
+			}
+		}
+	}
+
+	void RunBatched(const TArray<FString>& Lines, const FText& TaskName, const FText& PlatformDisplayName, FBenchCounts& Counts, double& OutElapsed)
+	{
+		FUcmdOutputBatch OutputBatch(PlatformDisplayName, TaskName);
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (const FString& Line : Lines)
+		{
+			OutputBatch.AddLine(Line);
+		}
+		OutputBatch.Flush();
+		OutElapsed += FPlatformTime::Seconds() - StartTime;
+
+		// The game thread's share, not part of handling the output as it comes in
+		TArray<TSharedRef<FTokenizedMessage>> Messages;
+		OutputBatch.DrainMessages(DBL_MAX, Messages);
+
+		Counts.Logged += OutputBatch.GetNumLoggedLines();
+		for (const TSharedRef<FTokenizedMessage>& Message : Messages)
+		{
+			Counts.Warnings += Message->GetSeverity() == EMessageSeverity::Warning ? 1 : 0;
+			Counts.Errors += Message->GetSeverity() == EMessageSeverity::Error ? 1 : 0;
+		}
+	}
+
+	void LogResult(const FString& Name, int32 NumLines, double Elapsed, const FBenchCounts& Counts)
+	{
+		UE_LOG(UCMDHelperBench, Display, TEXT("UcmdBench %s: %d lines in %.3fs, %.0f lines/s, %.0fns/line (logged %d, warnings %d, errors %d)"),
+			*Name, NumLines, Elapsed, Elapsed > 0.0 ? NumLines / Elapsed : 0.0, NumLines > 0 ? Elapsed * 1.0e9 / NumLines : 0.0,
+			Counts.Logged, Counts.Warnings, Counts.Errors);
+	}
+
+	bool LoadLines(const FString& Path, TArray<FString>& OutLines)
+	{
+		FString Contents;
+		if (!FFileHelper::LoadFileToString(Contents, *Path))
+		{
+			UE_LOG(UCMDHelperBench, Error, TEXT("UcmdBench: Could not read %s"), *Path);
+			return false;
+		}
+
+		TArray<FString> FileLines;
+		Contents.ParseIntoArrayLines(FileLines, false);
+		OutLines.Append(MoveTemp(FileLines));
+		return true;
+	}
+
+	void RunBench(const FBenchInput& Input, int32 Repeat, bool bLog)
+	{
+		const FText TaskName = FText::FromString(Input.Task);
+		const FText PlatformDisplayName = FText::FromString(TEXT("Bench"));
+
+		// The task names are localized, make sure the comparisons see the same text the tasks use
+		const FText LocalizedTaskName = Input.Task == TEXT("Packaging") ? LOCTEXT("PackagingTaskName", "Packaging") : Input.Task == TEXT("Cooking") ? LOCTEXT("CookingTaskName", "Cooking") : TaskName;
+
+		const int32 NumLines = Input.Lines.Num() * Repeat;
+
+		FBenchCounts LegacyCounts;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Pass = 0; Pass < Repeat; ++Pass)
+		{
+			RunLegacy(Input.Lines, LocalizedTaskName, PlatformDisplayName, bLog, LegacyCounts);
+		}
+		const double LegacyElapsed = FPlatformTime::Seconds() - StartTime;
+
+		const ELogVerbosity::Type Verbosity = UCMDHelper.GetVerbosity();
+		if (!bLog)
+		{
+			UCMDHelper.SetVerbosity(ELogVerbosity::NoLogging);
+		}
+
+		FBenchCounts BatchedCounts;
+		double BatchedElapsed = 0.0;
+		for (int32 Pass = 0; Pass < Repeat; ++Pass)
+		{
+			RunBatched(Input.Lines, LocalizedTaskName, PlatformDisplayName, BatchedCounts, BatchedElapsed);
+		}
+
+		UCMDHelper.SetVerbosity(Verbosity);
+
+		// A replayed cook mustn't leave its shader count on the editor's progress
+		if (GShaderCompilingManager)
+		{
+			GShaderCompilingManager->SetExternalJobs(0);
+		}
+
+		LogResult(FString::Printf(TEXT("%s PerLine"), *Input.Name), NumLines, LegacyElapsed, LegacyCounts);
+		LogResult(FString::Printf(TEXT("%s Batched"), *Input.Name), NumLines, BatchedElapsed, BatchedCounts);
+
+		if (LegacyCounts.Warnings != BatchedCounts.Warnings || LegacyCounts.Errors != BatchedCounts.Errors)
+		{
+			UE_LOG(UCMDHelperBench, Warning, TEXT("UcmdBench: Per line and batched handling classified %s differently"), *Input.Name);
+		}
+	}
+
+	FAutoConsoleCommand BenchOutputCommand(
+		TEXT("UCMD.Bench.Output"),
+		TEXT("Replays recorded UAT or docker output files (by default the ones in Resources/UCMDBench) through the per line and the batched output handling and logs lines/s of each. Options: -Repeat=N, -Task=Packaging|Cooking|Containerizing, -NoLog."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			int32 Repeat = 1;
+			bool bLog = true;
+
+			FBenchInput Input;
+			Input.Name = TEXT("Files");
+			Input.Task = TEXT("Packaging");
+
+			for (const FString& Arg : Args)
+			{
+				if (Arg.StartsWith(TEXT("-")))
+				{
+					FParse::Value(*Arg, TEXT("-Repeat="), Repeat);
+					FParse::Value(*Arg, TEXT("-Task="), Input.Task);
+					bLog &= !Arg.Equals(TEXT("-NoLog"), ESearchCase::IgnoreCase);
+				}
+				else if (!LoadLines(Arg, Input.Lines))
+				{
+					return;
+				}
+			}
+
+			Repeat = FMath::Max(Repeat, 1);
+
+			if (Input.Lines.Num() > 0)
+			{
+				RunBench(Input, Repeat, bLog);
+				return;
+			}
+
+			TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("Edgegap"));
+			if (!Plugin.IsValid())
+			{
+				UE_LOG(UCMDHelperBench, Display, TEXT("Usage: UCMD.Bench.Output <LogFile> [<LogFile> ...] [-Repeat=N] [-Task=Packaging|Cooking|Containerizing] [-NoLog]"));
+				return;
+			}
+
+			const FString FixtureDir = FPaths::Combine(Plugin->GetBaseDir(), TEXT("Resources"), TEXT("UCMDBench"));
+			const TPair<const TCHAR*, const TCHAR*> Fixtures[] =
+			{
+				{ TEXT("Packaging.log"), TEXT("Packaging") },
+				{ TEXT("Docker.log"), TEXT("Containerizing") },
+			};
+
+			for (const TPair<const TCHAR*, const TCHAR*>& Fixture : Fixtures)
+			{
+				FBenchInput FixtureInput;
+				FixtureInput.Name = Fixture.Key;
+				FixtureInput.Task = Fixture.Value;
+				if (LoadLines(FPaths::Combine(FixtureDir, Fixture.Key), FixtureInput.Lines))
+				{
+					RunBench(FixtureInput, Repeat, bLog);
+				}
+			}
+		}));
+}
+
+#undef LOCTEXT_NAMESPACE
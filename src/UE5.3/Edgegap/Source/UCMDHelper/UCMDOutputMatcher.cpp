@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UCMDOutputMatcher.h"
+
+const FUcmdOutputMatcher& FUcmdOutputMatcher::Get()
+{
+	static const FUcmdOutputMatcher Instance;
+	return Instance;
+}
+
+FUcmdOutputMatcher::FUcmdOutputMatcher()
+{
+	AddPattern(TEXT("Shaders left to compile "), EUcmdOutputPattern::ShadersLeft);
+	AddPattern(TEXT("Warning/Error Summary"), EUcmdOutputPattern::Summary);
+	AddPattern(TEXT("CookResults:Warning: "), EUcmdOutputPattern::CookResultsWarning);
+	AddPattern(TEXT("CookResults:Error: "), EUcmdOutputPattern::CookResultsError);
+	AddPattern(TEXT("Warning: "), EUcmdOutputPattern::Warning);
+	AddPattern(TEXT("Error: "), EUcmdOutputPattern::Error);
+
+	// Docker's progress bars, only printed when docker thinks it writes to a terminal
+	AddPattern(TEXT("Pushing ["), EUcmdOutputPattern::DockerProgress);
+	AddPattern(TEXT("Downloading ["), EUcmdOutputPattern::DockerProgress);
+	AddPattern(TEXT("Extracting ["), EUcmdOutputPattern::DockerProgress);
+
+	// docker push, one line per layer and state
+	AddPattern(TEXT(": Preparing"), EUcmdOutputPattern::DockerStatus);
+	AddPattern(TEXT(": Waiting"), EUcmdOutputPattern::DockerStatus);
+	AddPattern(TEXT(": Pushed"), EUcmdOutputPattern::DockerStatus);
+	AddPattern(TEXT(": Layer already exists"), EUcmdOutputPattern::DockerStatus);
+	AddPattern(TEXT(": Mounted from"), EUcmdOutputPattern::DockerStatus);
+}
+
+void FUcmdOutputMatcher::AddPattern(const TCHAR* Text, EUcmdOutputPattern Pattern)
+{
+	const FString LowerText = FString(Text).ToLower();
+	check(!LowerText.IsEmpty() && LowerText[0] < 128);
+
+	EntriesByFirstChar[LowerText[0]].Add((uint8)Entries.Num());
+	Entries.Add({ LowerText, Pattern });
+}
+
+FUcmdOutputMatch FUcmdOutputMatcher::Match(const FString& Line) const
+{
+	FUcmdOutputMatch Result;
+
+	const TCHAR* Chars = *Line;
+	const int32 Len = Line.Len();
+
+	for (int32 Index = 0; Index < Len; ++Index)
+	{
+		const uint32 Char = (uint32)FChar::ToLower(Chars[Index]);
+		if (Char >= 128)
+		{
+			continue;
+		}
+
+		for (const uint8 EntryIndex : EntriesByFirstChar[Char])
+		{
+			const FEntry& Entry = Entries[EntryIndex];
+			const uint32 Bit = 1u << (uint32)Entry.Pattern;
+			const int32 EntryLen = Entry.Text.Len();
+
+			if ((Result.Found & Bit) == 0 && Index + EntryLen <= Len && FCString::Strnicmp(Chars + Index, *Entry.Text, EntryLen) == 0)
+			{
+				Result.Found |= Bit;
+				Result.End[(int32)Entry.Pattern] = Index + EntryLen;
+			}
+		}
+	}
+
+	int32 BuildKitEnd = 0;
+	const EUcmdOutputPattern BuildKitPattern = MatchBuildKit(Chars, Len, BuildKitEnd);
+	if (BuildKitPattern != EUcmdOutputPattern::Num && !Result.Has(BuildKitPattern))
+	{
+		Result.Found |= 1u << (uint32)BuildKitPattern;
+		Result.End[(int32)BuildKitPattern] = BuildKitEnd;
+	}
+
+	return Result;
+}
+
+EUcmdOutputPattern FUcmdOutputMatcher::MatchBuildKit(const TCHAR* Line, int32 Len, int32& OutEnd)
+{
+	if (Len < 3 || Line[0] != TEXT('#') || !FChar::IsDigit(Line[1]))
+	{
+		return EUcmdOutputPattern::Num;
+	}
+
+	int32 Index = 1;
+	while (Index < Len && FChar::IsDigit(Line[Index]))
+	{
+		++Index;
+	}
+
+	if (Index >= Len || Line[Index] != TEXT(' '))
+	{
+		return EUcmdOutputPattern::Num;
+	}
+	++Index;
+
+	if (Index < Len && Line[Index] == TEXT('['))
+	{
+		OutEnd = Index + 1;
+		return EUcmdOutputPattern::DockerStatus;
+	}
+
+	static const TCHAR Layer[] = TEXT("sha256:");
+	static const TCHAR Context[] = TEXT("transferring ");
+
+	for (const TCHAR* Marker : { Layer, Context })
+	{
+		const int32 MarkerLen = FCString::Strlen(Marker);
+		if (Index + MarkerLen <= Len && FCString::Strncmp(Line + Index, Marker, MarkerLen) == 0)
+		{
+			OutEnd = Index + MarkerLen;
+			return EUcmdOutputPattern::DockerProgress;
+		}
+	}
+
+	return EUcmdOutputPattern::Num;
+}
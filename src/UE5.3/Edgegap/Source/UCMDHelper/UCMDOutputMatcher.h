@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Markers recognized in UCMD process output */
+enum class EUcmdOutputPattern : uint8
+{
+	ShadersLeft,
+	Summary,
+	CookResultsWarning,
+	CookResultsError,
+	Warning,
+	Error,
+	DockerProgress,
+	DockerStatus,
+	Num
+};
+
+/** Which patterns a line contains, and where the first occurrence of each ends */
+struct FUcmdOutputMatch
+{
+	uint32 Found = 0;
+	int32 End[(int32)EUcmdOutputPattern::Num] = {};
+
+	bool Has(EUcmdOutputPattern Pattern) const
+	{
+		return (Found & (1u << (uint32)Pattern)) != 0;
+	}
+
+	/** The text following the first occurrence of Pattern, like the right side of FString::Split */
+	FString GetRemainder(const FString& Line, EUcmdOutputPattern Pattern) const
+	{
+		return Line.RightChop(End[(int32)Pattern]);
+	}
+};
+
+/**
+ * The markers UCMD output is checked for, compiled once into a table indexed by first character so each line
+ * is scanned a single time for all of them. Case insensitive, like the FString::Split calls it replaces.
+ */
+class FUcmdOutputMatcher
+{
+public:
+	static const FUcmdOutputMatcher& Get();
+
+	FUcmdOutputMatch Match(const FString& Line) const;
+
+	/** Output is handled and logged in chunks of at most this many lines or characters */
+	static constexpr int32 MaxChunkLines = 256;
+	static constexpr int32 MaxChunkChars = 64 * 1024;
+
+private:
+	FUcmdOutputMatcher();
+
+	void AddPattern(const TCHAR* Text, EUcmdOutputPattern Pattern);
+
+	/**
+	 * BuildKit's plain output: progress like "#7 sha256:<layer> 12.58MB / 45.21MB 2.1s" or "#4 transferring context: 45.2MB",
+	 * and build steps like "#8 [2/4] COPY . /app". Returns Num for anything else.
+	 */
+	static EUcmdOutputPattern MatchBuildKit(const TCHAR* Line, int32 Len, int32& OutEnd);
+
+	struct FEntry
+	{
+		FString Text;
+		EUcmdOutputPattern Pattern;
+	};
+
+	TArray<FEntry> Entries;
+
+	// Entries by the lower case ASCII character they start with
+	TArray<uint8, TInlineAllocator<4>> EntriesByFirstChar[128];
+};
@@ -0,0 +1,438 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UCMDProcess.h"
+#include "UCMDHelperModule.h"
+#include "UCMDResourceSampler.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Paths.h"
+
+static TAutoConsoleVariable<float> CVarUcmdResourceSampleInterval(
+	TEXT("UCMD.ResourceSampleInterval"),
+	1.0f,
+	TEXT("Seconds between two samples of the CPU time, memory and I/O of a UCMD task's processes, 0 to not sample."),
+	ECVF_Default);
+
+FString FUcmdCommand::ToString() const
+{
+	FString Result = QuoteArgument(Executable);
+	for (const FString& Argument : Arguments)
+	{
+		Result += TEXT(" ");
+		Result += QuoteArgument(Argument);
+	}
+	return Result;
+}
+
+TArray<FString> FUcmdCommand::ParseArguments(const FString& CommandLine)
+{
+	TArray<FString> Result;
+
+	FString Current;
+	bool bInArgument = false;
+	bool bInQuotes = false;
+	int32 NumBackslashes = 0;
+	for (const TCHAR Char : CommandLine)
+	{
+		if (Char == TEXT('\\'))
+		{
+			NumBackslashes++;
+			bInArgument = true;
+			continue;
+		}
+
+		// The way CommandLineToArgvW reads them: backslashes in front of a quote escape each other and the quote,
+		// anywhere else they are what they are
+		if (Char == TEXT('"'))
+		{
+			Current.Append(FString::ChrN(NumBackslashes / 2, TEXT('\\')));
+			if (NumBackslashes % 2 == 1)
+			{
+				Current.AppendChar(Char);
+			}
+			else
+			{
+				bInQuotes = !bInQuotes;
+			}
+			NumBackslashes = 0;
+			bInArgument = true;
+			continue;
+		}
+
+		Current.Append(FString::ChrN(NumBackslashes, TEXT('\\')));
+		NumBackslashes = 0;
+
+		if (!bInQuotes && FChar::IsWhitespace(Char))
+		{
+			if (bInArgument)
+			{
+				Result.Add(MoveTemp(Current));
+				Current.Reset();
+				bInArgument = false;
+			}
+		}
+		else
+		{
+			Current.AppendChar(Char);
+			bInArgument = true;
+		}
+	}
+
+	Current.Append(FString::ChrN(NumBackslashes, TEXT('\\')));
+
+	if (bInArgument)
+	{
+		Result.Add(MoveTemp(Current));
+	}
+
+	return Result;
+}
+
+FString FUcmdCommand::QuoteArgument(const FString& Argument)
+{
+	bool bNeedsQuotes = Argument.IsEmpty();
+	for (const TCHAR Char : Argument)
+	{
+		bNeedsQuotes |= Char == TEXT(' ') || Char == TEXT('\t') || Char == TEXT('"');
+	}
+
+	if (!bNeedsQuotes)
+	{
+		return Argument;
+	}
+
+	// Backslashes only need escaping in front of a quote, the way CommandLineToArgvW reads them
+	FString Result = TEXT("\"");
+	int32 NumBackslashes = 0;
+	for (const TCHAR Char : Argument)
+	{
+		if (Char == TEXT('\\'))
+		{
+			NumBackslashes++;
+			continue;
+		}
+
+		const int32 NumEscaped = Char == TEXT('"') ? NumBackslashes * 2 + 1 : NumBackslashes;
+		for (int32 Index = 0; Index < NumEscaped; ++Index)
+		{
+			Result.AppendChar(TEXT('\\'));
+		}
+		Result.AppendChar(Char);
+		NumBackslashes = 0;
+	}
+	for (int32 Index = 0; Index < NumBackslashes * 2; ++Index)
+	{
+		Result.AppendChar(TEXT('\\'));
+	}
+	Result.AppendChar(TEXT('"'));
+
+	return Result;
+}
+
+bool FUcmdCommand::QuoteBatchArgument(const FString& Argument, FString& OutQuoted)
+{
+	// cmd.exe ends the command at a line break, however it is quoted
+	if (Argument.Contains(TEXT("\r")) || Argument.Contains(TEXT("\n")))
+	{
+		return false;
+	}
+
+	bool bNeedsQuotes = Argument.IsEmpty();
+	for (const TCHAR Char : Argument)
+	{
+		bNeedsQuotes |= Char == TEXT(' ') || Char == TEXT('\t') || Char == TEXT('"') || FCString::Strchr(TEXT("&|^<>%()!"), Char) != nullptr;
+	}
+
+	if (!bNeedsQuotes)
+	{
+		OutQuoted = Argument;
+		return true;
+	}
+
+	// cmd.exe doesn't know backslash escapes, so a quote inside is doubled, which keeps cmd.exe's idea of what is
+	// quoted in step with the program's. It expands %VAR% even inside quotes, %cd:~,% expands to nothing and
+	// splits the percent from whatever follows it.
+	OutQuoted = TEXT("\"");
+	int32 NumBackslashes = 0;
+	for (const TCHAR Char : Argument)
+	{
+		if (Char == TEXT('\\'))
+		{
+			NumBackslashes++;
+			continue;
+		}
+
+		if (Char == TEXT('"'))
+		{
+			OutQuoted.Append(FString::ChrN(NumBackslashes * 2, TEXT('\\')));
+			OutQuoted += TEXT("\"\"");
+		}
+		else
+		{
+			OutQuoted.Append(FString::ChrN(NumBackslashes, TEXT('\\')));
+			if (Char == TEXT('%'))
+			{
+				OutQuoted += TEXT("%%cd:~,%");
+			}
+			else
+			{
+				OutQuoted.AppendChar(Char);
+			}
+		}
+		NumBackslashes = 0;
+	}
+	OutQuoted.Append(FString::ChrN(NumBackslashes * 2, TEXT('\\')));
+	OutQuoted.AppendChar(TEXT('"'));
+
+	return true;
+}
+
+FUcmdProcess::FUcmdProcess(const FUcmdCommand& InCommand, const FString& InWorkingDir)
+	: Command(InCommand)
+	, WorkingDir(InWorkingDir)
+{
+}
+
+FUcmdProcess::~FUcmdProcess()
+{
+	if (Thread != nullptr)
+	{
+		if (bIsRunning)
+		{
+			Cancel();
+		}
+		Thread->WaitForCompletion();
+		delete Thread;
+	}
+}
+
+bool FUcmdProcess::Launch()
+{
+	check(Thread == nullptr); // We shouldn't be calling this twice
+
+	const FString ExecutablePath = FindExecutable(Command.Executable);
+	if (ExecutablePath.IsEmpty())
+	{
+		UE_LOG(UCMDHelper, Error, TEXT("Could not find %s, make sure it is installed and in PATH"), *Command.Executable);
+		return false;
+	}
+
+	void* StdInRead = nullptr;
+	void* StdInWrite = nullptr;
+	if (!FPlatformProcess::CreatePipe(StdOutRead, StdOutWrite) || !FPlatformProcess::CreatePipe(StdErrRead, StdErrWrite) || !FPlatformProcess::CreatePipe(StdInRead, StdInWrite, true))
+	{
+		FPlatformProcess::ClosePipe(StdInRead, StdInWrite);
+		ClosePipes();
+		return false;
+	}
+
+	// Windows runs batch files through cmd.exe, which reads the command line before the script does
+	const bool bThroughCmd = ExecutablePath.EndsWith(TEXT(".bat")) || ExecutablePath.EndsWith(TEXT(".cmd"));
+
+	FString Params;
+	for (const FString& Argument : Command.Arguments)
+	{
+		if (!Params.IsEmpty())
+		{
+			Params += TEXT(" ");
+		}
+
+		if (!bThroughCmd)
+		{
+			Params += FUcmdCommand::QuoteArgument(Argument);
+			continue;
+		}
+
+		FString Quoted;
+		if (!FUcmdCommand::QuoteBatchArgument(Argument, Quoted))
+		{
+			UE_LOG(UCMDHelper, Error, TEXT("Could not pass an argument with a line break to %s"), *ExecutablePath);
+			FPlatformProcess::ClosePipe(StdInRead, StdInWrite);
+			ClosePipes();
+			return false;
+		}
+		Params += Quoted;
+	}
+
+	ProcessHandle = FPlatformProcess::CreateProc(*ExecutablePath, *Params, false, true, true, &ProcessID, 0, *WorkingDir, StdOutWrite, StdInRead, StdErrWrite);
+	if (!ProcessHandle.IsValid())
+	{
+		UE_LOG(UCMDHelper, Error, TEXT("Could not start %s"), *ExecutablePath);
+		FPlatformProcess::ClosePipe(StdInRead, StdInWrite);
+		ClosePipes();
+		return false;
+	}
+
+	if (!Command.StdIn.IsEmpty())
+	{
+		FTCHARToUTF8 StdIn(*Command.StdIn);
+		FPlatformProcess::WritePipe(StdInWrite, reinterpret_cast<const uint8*>(StdIn.Get()), StdIn.Length());
+	}
+
+	// Closed either way, so a program reading its input sees the end of it instead of waiting
+	FPlatformProcess::ClosePipe(StdInRead, StdInWrite);
+
+	static std::atomic<uint32> ProcessIndex{ 0 };
+	const FString ThreadName = FString::Printf(TEXT("FUcmdProcess %d"), ProcessIndex.fetch_add(1));
+
+	if (FUcmdResourceSampler::IsSupported() && CVarUcmdResourceSampleInterval.GetValueOnGameThread() > 0.0f)
+	{
+		ResourceSampler = MakeUnique<FUcmdResourceSampler>(ProcessID);
+	}
+
+	bIsRunning = true;
+	Thread = FRunnableThread::Create(this, *ThreadName, 128 * 1024, TPri_AboveNormal);
+
+	return true;
+}
+
+void FUcmdProcess::Cancel()
+{
+	bCanceling = true;
+}
+
+FUcmdResourceUsage FUcmdProcess::GetResourceUsage() const
+{
+	return ResourceSampler.IsValid() ? ResourceSampler->GetUsage() : FUcmdResourceUsage();
+}
+
+uint32 FUcmdProcess::Run()
+{
+	const double SampleInterval = CVarUcmdResourceSampleInterval.GetValueOnAnyThread();
+	double NextSampleTime = FPlatformTime::Seconds() + SampleInterval;
+
+	bool bProcessRunning = true;
+	while (bProcessRunning)
+	{
+		FPlatformProcess::Sleep(PollInterval);
+
+		if (ResourceSampler.IsValid() && FPlatformTime::Seconds() >= NextSampleTime)
+		{
+			ResourceSampler->Sample();
+			NextSampleTime = FPlatformTime::Seconds() + SampleInterval;
+		}
+
+		bProcessRunning = FPlatformProcess::IsProcRunning(ProcessHandle);
+		if (bProcessRunning && bCanceling)
+		{
+			FPlatformProcess::TerminateProc(ProcessHandle, true);
+			FPlatformProcess::WaitForProc(ProcessHandle);
+			bProcessRunning = false;
+		}
+
+		ReadOutput(false);
+	}
+
+	// Whatever the process wrote just before exiting, including a last line without a line break
+	ReadOutput(true);
+
+	const bool bCanceled = bCanceling;
+	int32 ReturnCode = -1;
+	if (!bCanceled)
+	{
+		FPlatformProcess::GetProcReturnCode(ProcessHandle, &ReturnCode);
+	}
+
+	ClosePipes();
+	FPlatformProcess::CloseProc(ProcessHandle);
+	bIsRunning = false;
+
+	if (bCanceled)
+	{
+		CanceledDelegate.ExecuteIfBound();
+	}
+	else
+	{
+		CompletedDelegate.ExecuteIfBound(ReturnCode);
+	}
+
+	return 0;
+}
+
+FString FUcmdProcess::FindExecutable(const FString& Executable)
+{
+	if (Executable.Contains(TEXT("/")) || Executable.Contains(TEXT("\\")))
+	{
+		return FPaths::FileExists(Executable) ? Executable : FString();
+	}
+
+	TArray<FString> Dirs;
+	FPlatformMisc::GetEnvironmentVariable(TEXT("PATH")).ParseIntoArray(Dirs, FPlatformMisc::GetPathVarDelimiter());
+#if PLATFORM_MAC
+	// Editors started from the Finder get a short PATH, without where docker is usually installed
+	Dirs.Add(TEXT("/usr/local/bin"));
+	Dirs.Add(TEXT("/opt/homebrew/bin"));
+#endif
+
+#if PLATFORM_WINDOWS
+	static const TCHAR* Extensions[] = { TEXT(".exe"), TEXT(".bat"), TEXT(".cmd"), TEXT("") };
+#else
+	static const TCHAR* Extensions[] = { TEXT("") };
+#endif
+
+	for (const FString& Dir : Dirs)
+	{
+		for (const TCHAR* Extension : Extensions)
+		{
+			const FString Candidate = FPaths::Combine(Dir.TrimQuotes(), Executable + Extension);
+			if (FPaths::FileExists(Candidate))
+			{
+				return Candidate;
+			}
+		}
+	}
+
+	return FString();
+}
+
+void FUcmdProcess::ReadOutput(bool bFinal)
+{
+	ReadLines(StdOutRead, StdOutBuffer, OutputDelegate, bFinal);
+	ReadLines(StdErrRead, StdErrBuffer, ErrorOutputDelegate, bFinal);
+}
+
+void FUcmdProcess::ReadLines(void* Pipe, TArray<uint8>& Buffer, FOnUcmdProcessOutput& Delegate, bool bFinal)
+{
+	TArray<uint8> Data;
+	while (FPlatformProcess::ReadPipeToArray(Pipe, Data) && Data.Num() > 0)
+	{
+		Buffer.Append(Data);
+	}
+
+	// Split on bytes rather than characters, a read can end in the middle of a UTF-8 sequence
+	auto EmitLine = [&Buffer, &Delegate](int32 Start, int32 End)
+	{
+		if (End > Start && Buffer[End - 1] == '\r')
+		{
+			End--;
+		}
+		FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Buffer.GetData() + Start), End - Start);
+		Delegate.ExecuteIfBound(FString(Converter.Length(), Converter.Get()));
+	};
+
+	int32 LineStart = 0;
+	for (int32 Index = 0; Index < Buffer.Num(); ++Index)
+	{
+		if (Buffer[Index] == '\n')
+		{
+			EmitLine(LineStart, Index);
+			LineStart = Index + 1;
+		}
+	}
+
+	if (bFinal && LineStart < Buffer.Num())
+	{
+		EmitLine(LineStart, Buffer.Num());
+		LineStart = Buffer.Num();
+	}
+
+	Buffer.RemoveAt(0, LineStart, false);
+}
+
+void FUcmdProcess::ClosePipes()
+{
+	FPlatformProcess::ClosePipe(StdOutRead, StdOutWrite);
+	FPlatformProcess::ClosePipe(StdErrRead, StdErrWrite);
+	StdOutRead = StdOutWrite = StdErrRead = StdErrWrite = nullptr;
+}
@@ -0,0 +1,88 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/PlatformProcess.h"
+#include "IUCMDHelperModule.h"
+#include <atomic>
+
+class FRunnableThread;
+class FUcmdResourceSampler;
+
+DECLARE_DELEGATE_OneParam(FOnUcmdProcessOutput, FString);
+DECLARE_DELEGATE_OneParam(FOnUcmdProcessCompleted, int32);
+
+/**
+ * A program started directly from its argument list, without PowerShell or bash in between. Windows always runs
+ * .bat and .cmd files through cmd.exe, so their arguments are quoted for cmd.exe as well.
+ *
+ * Its standard input is written from memory and closed right after launch. Standard output and standard error are
+ * read separately, a line at a time, on the process' own thread, which also fires the completed or canceled delegate.
+ * The same thread samples what the process and its children use.
+ */
+class FUcmdProcess : public FRunnable
+{
+public:
+	FUcmdProcess(const FUcmdCommand& InCommand, const FString& InWorkingDir);
+	virtual ~FUcmdProcess();
+
+	/** Starts the process and the thread reading its output, false if it couldn't */
+	bool Launch();
+
+	/** Kills the process and its children. The canceled delegate fires once they are gone. */
+	void Cancel();
+
+	bool IsRunning() const { return bIsRunning; }
+
+	/** What the process and its children used. On the process' thread, or once it ended. */
+	FUcmdResourceUsage GetResourceUsage() const;
+
+	FOnUcmdProcessOutput& OnOutput() { return OutputDelegate; }
+	FOnUcmdProcessOutput& OnErrorOutput() { return ErrorOutputDelegate; }
+	FOnUcmdProcessCompleted& OnCompleted() { return CompletedDelegate; }
+	FSimpleDelegate& OnCanceled() { return CanceledDelegate; }
+
+	// FRunnable
+	virtual uint32 Run() override;
+
+	/** The full path of an executable, looked up in PATH when given a bare name. Empty when there is no such file. */
+	static FString FindExecutable(const FString& Executable);
+
+	static constexpr float PollInterval = 0.01f;
+
+private:
+	void ReadOutput(bool bFinal);
+
+	/** Hands every complete line in the pipe to Delegate, and the unfinished last one too when bFinal */
+	static void ReadLines(void* Pipe, TArray<uint8>& Buffer, FOnUcmdProcessOutput& Delegate, bool bFinal);
+
+	void ClosePipes();
+
+	const FUcmdCommand Command;
+	const FString WorkingDir;
+
+	FProcHandle ProcessHandle;
+	FRunnableThread* Thread = nullptr;
+
+	uint32 ProcessID = 0;
+	TUniquePtr<FUcmdResourceSampler> ResourceSampler;
+
+	void* StdOutRead = nullptr;
+	void* StdOutWrite = nullptr;
+	void* StdErrRead = nullptr;
+	void* StdErrWrite = nullptr;
+
+	// Output since the last line break, per pipe. Process' thread only.
+	TArray<uint8> StdOutBuffer;
+	TArray<uint8> StdErrBuffer;
+
+	std::atomic<bool> bIsRunning{ false };
+	std::atomic<bool> bCanceling{ false };
+
+	FOnUcmdProcessOutput OutputDelegate;
+	FOnUcmdProcessOutput ErrorOutputDelegate;
+	FOnUcmdProcessCompleted CompletedDelegate;
+	FSimpleDelegate CanceledDelegate;
+};
@@ -0,0 +1,96 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "IUCMDHelperModule.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// How commands are split and quoted for the processes UCMDHelper starts, under UCMDHelper.Command in the Session Frontend.
+
+namespace
+{
+	const TCHAR* RoundTripArguments[] =
+	{
+		TEXT("BuildCookRun"),
+		TEXT("-project=C:/My Game/X.uproject"),
+		TEXT(""),
+		TEXT("C:\\Staging\\"),
+		TEXT("C:\\My Staging\\"),
+		TEXT("say \"hi\""),
+		TEXT("a\\\\\"b"),
+		TEXT("tab\there"),
+		TEXT("-ini:Game:[/Script/Engine.GameSession]:MaxPlayers=16"),
+		TEXT("100% & more"),
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUcmdCommandParseArgumentsTest, "UCMDHelper.Command.ParseArguments", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUcmdCommandParseArgumentsTest::RunTest(const FString& Parameters)
+{
+	const TArray<FString> Arguments = FUcmdCommand::ParseArguments(TEXT("  BuildCookRun -project=\"C:/My Game/X.uproject\"   -archivedirectory=C:\\Staging\\ \"\" -noP4 "));
+
+	if (TestEqual(TEXT("Number of arguments"), Arguments.Num(), 5))
+	{
+		TestEqual(TEXT("Plain argument"), Arguments[0], TEXT("BuildCookRun"));
+		TestEqual(TEXT("Quoted part"), Arguments[1], TEXT("-project=C:/My Game/X.uproject"));
+		TestEqual(TEXT("Trailing backslash outside quotes"), Arguments[2], TEXT("-archivedirectory=C:\\Staging\\"));
+		TestEqual(TEXT("Empty quotes"), Arguments[3], TEXT(""));
+		TestEqual(TEXT("Last argument"), Arguments[4], TEXT("-noP4"));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUcmdCommandQuoteRoundTripTest, "UCMDHelper.Command.QuoteRoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUcmdCommandQuoteRoundTripTest::RunTest(const FString& Parameters)
+{
+	TArray<FString> Expected;
+	FString CommandLine;
+	for (const TCHAR* Argument : RoundTripArguments)
+	{
+		Expected.Add(Argument);
+		CommandLine += CommandLine.IsEmpty() ? TEXT("") : TEXT(" ");
+		CommandLine += FUcmdCommand::QuoteArgument(Argument);
+	}
+
+	const TArray<FString> Parsed = FUcmdCommand::ParseArguments(CommandLine);
+
+	if (TestEqual(TEXT("Number of arguments"), Parsed.Num(), Expected.Num()))
+	{
+		for (int32 Index = 0; Index < Expected.Num(); ++Index)
+		{
+			TestEqual(FString::Printf(TEXT("Argument %d of %s"), Index, *CommandLine), Parsed[Index], Expected[Index]);
+		}
+	}
+
+	TestEqual(TEXT("Plain arguments stay unquoted"), FUcmdCommand::QuoteArgument(TEXT("-noP4")), TEXT("-noP4"));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUcmdCommandQuoteBatchArgumentTest, "UCMDHelper.Command.QuoteBatchArgument", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUcmdCommandQuoteBatchArgumentTest::RunTest(const FString& Parameters)
+{
+	auto Quote = [](const TCHAR* Argument)
+	{
+		FString Quoted;
+		return FUcmdCommand::QuoteBatchArgument(Argument, Quoted) ? Quoted : FString(TEXT("<rejected>"));
+	};
+
+	TestEqual(TEXT("Plain argument"), Quote(TEXT("-noP4")), TEXT("-noP4"));
+	TestEqual(TEXT("Empty argument"), Quote(TEXT("")), TEXT("\"\""));
+	TestEqual(TEXT("Command separators"), Quote(TEXT("a&b|c")), TEXT("\"a&b|c\""));
+	TestEqual(TEXT("Redirections and escapes"), Quote(TEXT("<in>^out")), TEXT("\"<in>^out\""));
+	TestEqual(TEXT("Percent"), Quote(TEXT("%PATH%")), TEXT("\"%%cd:~,%PATH%%cd:~,%\""));
+	TestEqual(TEXT("Quote"), Quote(TEXT("say \"hi\"")), TEXT("\"say \"\"hi\"\"\""));
+	TestEqual(TEXT("Backslashes in front of a quote"), Quote(TEXT("a\\\"b")), TEXT("\"a\\\\\"\"b\""));
+	TestEqual(TEXT("Trailing backslash"), Quote(TEXT("C:\\My Staging\\")), TEXT("\"C:\\My Staging\\\\\""));
+	TestEqual(TEXT("Line break"), Quote(TEXT("a\nb")), TEXT("<rejected>"));
+
+	return true;
+}
+
+#endif
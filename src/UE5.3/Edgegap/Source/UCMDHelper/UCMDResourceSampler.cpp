@@ -0,0 +1,356 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UCMDResourceSampler.h"
+#include "HAL/PlatformTime.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <TlHelp32.h>
+#include <Psapi.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#elif PLATFORM_LINUX
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#elif PLATFORM_MAC
+#include <libproc.h>
+#include <sys/resource.h>
+#include <mach/mach_time.h>
+#endif
+
+namespace
+{
+	FString FormatBytes(int64 Bytes)
+	{
+		if (Bytes >= 1000 * 1000 * 1000)
+		{
+			return FString::Printf(TEXT("%.2f GB"), Bytes / 1.0e9);
+		}
+		return FString::Printf(TEXT("%.1f MB"), Bytes / 1.0e6);
+	}
+
+#if PLATFORM_LINUX
+	/** procfs files report a size of zero, so they are read until the end rather than by their size */
+	int32 ReadProcFile(const char* Path, ANSICHAR* Buffer, int32 BufferSize)
+	{
+		const int File = open(Path, O_RDONLY);
+		if (File < 0)
+		{
+			return 0;
+		}
+
+		int32 Size = 0;
+		ssize_t Read;
+		while (Size < BufferSize - 1 && (Read = read(File, Buffer + Size, BufferSize - 1 - Size)) > 0)
+		{
+			Size += (int32)Read;
+		}
+		close(File);
+
+		Buffer[Size] = 0;
+		return Size;
+	}
+#endif
+}
+
+FString FUcmdResourceUsage::ToString() const
+{
+	if (NumSamples == 0)
+	{
+		return TEXT("no resource samples");
+	}
+
+	return FString::Printf(TEXT("CPU %.0f s (average %.1f, peak %.1f cores), memory average %s, peak %s, read %s (peak %s/s), written %s (peak %s/s), up to %d processes"),
+		CpuSeconds, AverageCpuLoad, PeakCpuLoad,
+		*FormatBytes(AverageMemoryBytes), *FormatBytes(PeakMemoryBytes),
+		*FormatBytes(ReadBytes), *FormatBytes((int64)PeakReadBytesPerSecond),
+		*FormatBytes(WriteBytes), *FormatBytes((int64)PeakWriteBytesPerSecond),
+		PeakNumProcesses);
+}
+
+FUcmdResourceSampler::FUcmdResourceSampler(uint32 InRootProcessID)
+	: RootProcessID(InRootProcessID)
+	, StartTime(FPlatformTime::Seconds())
+	, LastSampleTime(StartTime)
+{
+}
+
+void FUcmdResourceSampler::Sample()
+{
+	TMap<uint32, FProcessCounters> Processes;
+	if (!ReadProcessTree(RootProcessID, Processes) || Processes.Num() == 0)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	int64 MemoryBytes = 0;
+	for (const TPair<uint32, FProcessCounters>& Process : Processes)
+	{
+		// Less CPU time than before means the ID now belongs to another process
+		const FProcessCounters* Seen = SeenProcesses.Find(Process.Key);
+		if (Seen != nullptr && Process.Value.CpuSeconds < Seen->CpuSeconds)
+		{
+			Retired.CpuSeconds += Seen->CpuSeconds;
+			Retired.ReadBytes += Seen->ReadBytes;
+			Retired.WriteBytes += Seen->WriteBytes;
+		}
+
+		SeenProcesses.Add(Process.Key, Process.Value);
+		MemoryBytes += Process.Value.MemoryBytes;
+	}
+
+	FProcessCounters Total = Retired;
+	for (const TPair<uint32, FProcessCounters>& Process : SeenProcesses)
+	{
+		Total.CpuSeconds += Process.Value.CpuSeconds;
+		Total.ReadBytes += Process.Value.ReadBytes;
+		Total.WriteBytes += Process.Value.WriteBytes;
+	}
+
+	const double Elapsed = Now - LastSampleTime;
+	if (Elapsed > 0.0)
+	{
+		Usage.PeakCpuLoad = FMath::Max(Usage.PeakCpuLoad, (Total.CpuSeconds - LastTotal.CpuSeconds) / Elapsed);
+		Usage.PeakReadBytesPerSecond = FMath::Max(Usage.PeakReadBytesPerSecond, (Total.ReadBytes - LastTotal.ReadBytes) / Elapsed);
+		Usage.PeakWriteBytesPerSecond = FMath::Max(Usage.PeakWriteBytesPerSecond, (Total.WriteBytes - LastTotal.WriteBytes) / Elapsed);
+	}
+
+	Usage.NumSamples++;
+	Usage.WallSeconds = Now - StartTime;
+	Usage.CpuSeconds = Total.CpuSeconds;
+	Usage.AverageCpuLoad = Usage.WallSeconds > 0.0 ? Total.CpuSeconds / Usage.WallSeconds : 0.0;
+
+	MemoryBytesSum += MemoryBytes;
+	Usage.AverageMemoryBytes = (int64)(MemoryBytesSum / Usage.NumSamples);
+	Usage.PeakMemoryBytes = FMath::Max(Usage.PeakMemoryBytes, MemoryBytes);
+
+	Usage.ReadBytes = Total.ReadBytes;
+	Usage.WriteBytes = Total.WriteBytes;
+	Usage.PeakNumProcesses = FMath::Max(Usage.PeakNumProcesses, Processes.Num());
+
+	LastSampleTime = Now;
+	LastTotal = Total;
+}
+
+bool FUcmdResourceSampler::IsSupported()
+{
+#if PLATFORM_WINDOWS || PLATFORM_LINUX || PLATFORM_MAC
+	return true;
+#else
+	return false;
+#endif
+}
+
+#if PLATFORM_WINDOWS
+
+bool FUcmdResourceSampler::ReadProcessTree(uint32 RootProcessID, TMap<uint32, FProcessCounters>& OutProcesses)
+{
+	HANDLE Snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+	if (Snapshot == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	TMultiMap<uint32, uint32> Children;
+	PROCESSENTRY32 Entry;
+	Entry.dwSize = sizeof(Entry);
+	for (BOOL bHasEntry = Process32First(Snapshot, &Entry); bHasEntry; bHasEntry = Process32Next(Snapshot, &Entry))
+	{
+		Children.Add(Entry.th32ParentProcessID, Entry.th32ProcessID);
+	}
+	CloseHandle(Snapshot);
+
+	// The parent ID of an orphan can be reused by one of its descendants, so each process is visited once
+	TArray<uint32> Pending = { RootProcessID };
+	TSet<uint32> Visited;
+	while (Pending.Num() > 0)
+	{
+		const uint32 ProcessID = Pending.Pop(false);
+		bool bAlreadyVisited = false;
+		Visited.Add(ProcessID, &bAlreadyVisited);
+		if (bAlreadyVisited)
+		{
+			continue;
+		}
+		Children.MultiFind(ProcessID, Pending);
+
+		HANDLE Process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, 0, ProcessID);
+		if (Process == nullptr)
+		{
+			continue;
+		}
+
+		FProcessCounters& Counters = OutProcesses.Add(ProcessID);
+
+		FILETIME CreationTime, ExitTime, KernelTime, UserTime;
+		if (GetProcessTimes(Process, &CreationTime, &ExitTime, &KernelTime, &UserTime))
+		{
+			const uint64 Ticks = (((uint64)KernelTime.dwHighDateTime << 32) | KernelTime.dwLowDateTime) + (((uint64)UserTime.dwHighDateTime << 32) | UserTime.dwLowDateTime);
+			Counters.CpuSeconds = Ticks * 1.0e-7;
+		}
+
+		PROCESS_MEMORY_COUNTERS Memory;
+		if (GetProcessMemoryInfo(Process, &Memory, sizeof(Memory)))
+		{
+			Counters.MemoryBytes = Memory.WorkingSetSize;
+		}
+
+		// All I/O, files as well as network and devices
+		IO_COUNTERS IO;
+		if (GetProcessIoCounters(Process, &IO))
+		{
+			Counters.ReadBytes = IO.ReadTransferCount;
+			Counters.WriteBytes = IO.WriteTransferCount;
+		}
+
+		CloseHandle(Process);
+	}
+
+	return true;
+}
+
+#elif PLATFORM_LINUX
+
+bool FUcmdResourceSampler::ReadProcessTree(uint32 RootProcessID, TMap<uint32, FProcessCounters>& OutProcesses)
+{
+	static const double TicksPerSecond = (double)sysconf(_SC_CLK_TCK);
+	static const int64 PageSize = sysconf(_SC_PAGESIZE);
+
+	DIR* ProcDir = opendir("/proc");
+	if (ProcDir == nullptr)
+	{
+		return false;
+	}
+
+	TMultiMap<uint32, uint32> Children;
+	TMap<uint32, FProcessCounters> AllProcesses;
+
+	ANSICHAR Buffer[1024];
+	while (dirent* DirEntry = readdir(ProcDir))
+	{
+		char* End = nullptr;
+		const uint32 ProcessID = (uint32)strtoul(DirEntry->d_name, &End, 10);
+		if (ProcessID == 0 || *End != 0)
+		{
+			continue;
+		}
+
+		char Path[64];
+		snprintf(Path, sizeof(Path), "/proc/%u/stat", ProcessID);
+		if (ReadProcFile(Path, Buffer, sizeof(Buffer)) == 0)
+		{
+			continue;
+		}
+
+		// The executable name comes in parentheses and may hold spaces or parentheses itself
+		const ANSICHAR* Fields = FCStringAnsi::Strrchr(Buffer, ')');
+		if (Fields == nullptr)
+		{
+			continue;
+		}
+
+		char State;
+		int ParentID;
+		unsigned long UserTicks, SystemTicks;
+		long ResidentPages;
+		if (sscanf(Fields + 1, " %c %d %*d %*d %*d %*d %*u %*lu %*lu %*lu %*lu %lu %lu %*ld %*ld %*ld %*ld %*ld %*ld %*llu %*lu %ld",
+			&State, &ParentID, &UserTicks, &SystemTicks, &ResidentPages) != 5)
+		{
+			continue;
+		}
+
+		FProcessCounters& Counters = AllProcesses.Add(ProcessID);
+		Counters.CpuSeconds = (UserTicks + SystemTicks) / TicksPerSecond;
+		Counters.MemoryBytes = ResidentPages * PageSize;
+		Children.Add((uint32)ParentID, ProcessID);
+	}
+	closedir(ProcDir);
+
+	TArray<uint32> Pending = { RootProcessID };
+	while (Pending.Num() > 0)
+	{
+		const uint32 ProcessID = Pending.Pop(false);
+		const FProcessCounters* Counters = AllProcesses.Find(ProcessID);
+		if (Counters == nullptr || OutProcesses.Contains(ProcessID))
+		{
+			continue;
+		}
+		Children.MultiFind(ProcessID, Pending);
+
+		FProcessCounters& Process = OutProcesses.Add(ProcessID, *Counters);
+
+		// Bytes that reached or came from storage, readable for our own processes only
+		char Path[64];
+		snprintf(Path, sizeof(Path), "/proc/%u/io", ProcessID);
+		if (ReadProcFile(Path, Buffer, sizeof(Buffer)) > 0)
+		{
+			if (const ANSICHAR* ReadBytes = FCStringAnsi::Strstr(Buffer, "\nread_bytes:"))
+			{
+				Process.ReadBytes = FCStringAnsi::Atoi64(ReadBytes + 12);
+			}
+			if (const ANSICHAR* WriteBytes = FCStringAnsi::Strstr(Buffer, "\nwrite_bytes:"))
+			{
+				Process.WriteBytes = FCStringAnsi::Atoi64(WriteBytes + 13);
+			}
+		}
+	}
+
+	return true;
+}
+
+#elif PLATFORM_MAC
+
+bool FUcmdResourceSampler::ReadProcessTree(uint32 RootProcessID, TMap<uint32, FProcessCounters>& OutProcesses)
+{
+	static const double NanosecondsPerTick = []()
+	{
+		mach_timebase_info_data_t Timebase;
+		mach_timebase_info(&Timebase);
+		return (double)Timebase.numer / Timebase.denom;
+	}();
+
+	TArray<uint32> Pending = { RootProcessID };
+	TArray<pid_t> ChildIDs;
+	while (Pending.Num() > 0)
+	{
+		const uint32 ProcessID = Pending.Pop(false);
+		if (OutProcesses.Contains(ProcessID))
+		{
+			continue;
+		}
+
+		rusage_info_v2 Info;
+		if (proc_pid_rusage((pid_t)ProcessID, RUSAGE_INFO_V2, (rusage_info_t*)&Info) != 0)
+		{
+			continue;
+		}
+
+		FProcessCounters& Counters = OutProcesses.Add(ProcessID);
+		Counters.CpuSeconds = (Info.ri_user_time + Info.ri_system_time) * NanosecondsPerTick * 1.0e-9;
+		Counters.MemoryBytes = Info.ri_resident_size;
+		Counters.ReadBytes = Info.ri_diskio_bytesread;
+		Counters.WriteBytes = Info.ri_diskio_byteswritten;
+
+		ChildIDs.SetNumUninitialized(256);
+		const int NumChildren = proc_listchildpids((pid_t)ProcessID, ChildIDs.GetData(), ChildIDs.Num() * sizeof(pid_t));
+		for (int Index = 0; Index < FMath::Min(NumChildren, ChildIDs.Num()); ++Index)
+		{
+			Pending.Add((uint32)ChildIDs[Index]);
+		}
+	}
+
+	return true;
+}
+
+#else
+
+bool FUcmdResourceSampler::ReadProcessTree(uint32 RootProcessID, TMap<uint32, FProcessCounters>& OutProcesses)
+{
+	return false;
+}
+
+#endif
@@ -0,0 +1,52 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IUCMDHelperModule.h"
+
+/**
+ * Reads the CPU time, resident memory and I/O of a process and all of its children, on the thread polling the process.
+ *
+ * Counters are per process, so a child that starts and ends between two samples is missed, and the last interval
+ * before the process exits is lost. Totals keep the last counters of children that already exited.
+ */
+class FUcmdResourceSampler
+{
+public:
+	explicit FUcmdResourceSampler(uint32 InRootProcessID);
+
+	void Sample();
+
+	const FUcmdResourceUsage& GetUsage() const { return Usage; }
+
+	/** Whether the counters can be read on this platform */
+	static bool IsSupported();
+
+private:
+	struct FProcessCounters
+	{
+		double CpuSeconds = 0.0;
+		int64 MemoryBytes = 0;
+		int64 ReadBytes = 0;
+		int64 WriteBytes = 0;
+	};
+
+	/** The counters of the process and its descendants, by process ID */
+	static bool ReadProcessTree(uint32 RootProcessID, TMap<uint32, FProcessCounters>& OutProcesses);
+
+	const uint32 RootProcessID;
+	const double StartTime;
+
+	// The last counters of every process seen in the tree, exited ones included
+	TMap<uint32, FProcessCounters> SeenProcesses;
+
+	// Processes whose ID was reused by a later one
+	FProcessCounters Retired;
+
+	double LastSampleTime;
+	FProcessCounters LastTotal;
+	double MemoryBytesSum = 0.0;
+
+	FUcmdResourceUsage Usage;
+};
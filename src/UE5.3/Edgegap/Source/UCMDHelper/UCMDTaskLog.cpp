@@ -0,0 +1,284 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UCMDTaskLog.h"
+#include "UCMDHelperModule.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/Paths.h"
+
+FUcmdTaskLog::FUcmdTaskLog(const FString& InPath)
+	: Path(InPath)
+{
+	File.Reset(IFileManager::Get().CreateFileWriter(*Path, FILEWRITE_AllowRead));
+	if (!File)
+	{
+		UE_LOG(UCMDHelper, Warning, TEXT("Could not create task log %s"), *Path);
+	}
+}
+
+TSharedRef<FUcmdTaskLog> FUcmdTaskLog::Open(const FString& TaskName, const FString& PlatformName)
+{
+	const FDateTime Now = FDateTime::Now();
+	const FString BaseName = Now.ToString(TEXT("%Y.%m.%d-%H.%M.%S_")) + FPaths::MakeValidFileName(TaskName.Replace(TEXT(" "), TEXT("_")), TEXT('_'));
+
+	IFileManager::Get().MakeDirectory(*GetLogDir(), true);
+
+	FString LogPath = GetLogDir() / BaseName + TEXT(".log");
+	for (int32 Suffix = 2; IFileManager::Get().FileExists(*LogPath); ++Suffix)
+	{
+		LogPath = GetLogDir() / FString::Printf(TEXT("%s_%d.log"), *BaseName, Suffix);
+	}
+
+	TSharedRef<FUcmdTaskLog> TaskLog = MakeShareable(new FUcmdTaskLog(LogPath));
+	TaskLog->AppendLine(FString::Printf(TEXT("%s (%s), started %s"), *TaskName, *PlatformName, *Now.ToString()));
+
+	FUcmdTaskLogWriter::Get().Add(TaskLog);
+	return TaskLog;
+}
+
+void FUcmdTaskLog::AppendLine(const FString& Line)
+{
+	if (bClosed)
+	{
+		return;
+	}
+
+	FTCHARToUTF8 Utf8(*Line);
+	bool bWakeUpWriter = false;
+
+	{
+		FScopeLock Lock(&BufferLock);
+
+		if (Buffer.Num() + Utf8.Length() + 1 > MaxBufferSize)
+		{
+			DroppedBytes += Utf8.Length() + 1;
+			return;
+		}
+
+		Buffer.Append(Utf8.Get(), Utf8.Length());
+		Buffer.Add('\n');
+
+		bWakeUpWriter = Buffer.Num() >= WakeUpBufferSize;
+	}
+
+	if (bWakeUpWriter)
+	{
+		FUcmdTaskLogWriter::Get().WakeUp();
+	}
+}
+
+void FUcmdTaskLog::Close(const FString& Result)
+{
+	if (bClosed)
+	{
+		return;
+	}
+
+	AppendLine(FString::Printf(TEXT("%s, %s"), *Result, *FDateTime::Now().ToString()));
+	bClosed = true;
+
+	// Held across both so a write the writer thread has in hand lands before the result line, not after the file closed
+	FScopeLock Lock(&FileLock);
+	WriteBuffered();
+	File.Reset();
+}
+
+FString FUcmdTaskLog::GetLogDir()
+{
+	return FPaths::ProjectLogDir() / TEXT("UCMD");
+}
+
+void FUcmdTaskLog::WriteBuffered()
+{
+	// Taken before the swap, so whatever a caller takes out of the buffer reaches the file before the next caller's
+	FScopeLock FileScopeLock(&FileLock);
+
+	TArray<ANSICHAR> Pending;
+	int64 Dropped = 0;
+
+	{
+		FScopeLock Lock(&BufferLock);
+		Swap(Pending, Buffer);
+		Swap(Dropped, DroppedBytes);
+	}
+
+	WriteToFile(Pending.GetData(), Pending.Num());
+
+	if (Dropped > 0)
+	{
+		FTCHARToUTF8 Note(*FString::Printf(TEXT("[%lld bytes of output dropped, the disk did not keep up]\n"), Dropped));
+		WriteToFile(Note.Get(), Note.Length());
+	}
+
+	if (File)
+	{
+		File->Flush();
+	}
+}
+
+void FUcmdTaskLog::WriteToFile(const ANSICHAR* Data, int64 Size)
+{
+	if (!File || Size == 0)
+	{
+		return;
+	}
+
+	if (FileSize > 0 && FileSize + Size > MaxFileSize)
+	{
+		Rotate();
+		if (!File)
+		{
+			return;
+		}
+	}
+
+	File->Serialize(const_cast<ANSICHAR*>(Data), Size);
+	FileSize += Size;
+}
+
+void FUcmdTaskLog::Rotate()
+{
+	File.Reset();
+
+	// Task.log -> Task.1.log -> Task.2.log ..., the oldest part goes
+	IFileManager& FileManager = IFileManager::Get();
+	const FString BasePath = FPaths::GetBaseFilename(Path, false);
+	auto GetRotatedPath = [&BasePath](int32 Index) { return FString::Printf(TEXT("%s.%d.log"), *BasePath, Index); };
+
+	FileManager.Delete(*GetRotatedPath(MaxRotatedFiles), false, false, true);
+	for (int32 Index = MaxRotatedFiles - 1; Index >= 1; --Index)
+	{
+		FileManager.Move(*GetRotatedPath(Index + 1), *GetRotatedPath(Index), true, true, false, true);
+	}
+	FileManager.Move(*GetRotatedPath(1), *Path, true, true, false, true);
+
+	File.Reset(FileManager.CreateFileWriter(*Path, FILEWRITE_AllowRead));
+	FileSize = 0;
+}
+
+FUcmdTaskLogWriter& FUcmdTaskLogWriter::Get()
+{
+	static FUcmdTaskLogWriter Instance;
+	return Instance;
+}
+
+void FUcmdTaskLogWriter::Startup()
+{
+	bStopping = false;
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+
+	if (FPlatformProcess::SupportsMultithreading())
+	{
+		Thread = FRunnableThread::Create(this, TEXT("UcmdTaskLogWriter"), 0, TPri_BelowNormal);
+	}
+}
+
+void FUcmdTaskLogWriter::Shutdown()
+{
+	if (Thread)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	if (WakeEvent)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+		WakeEvent = nullptr;
+	}
+
+	FScopeLock Lock(&LogsLock);
+	for (const TSharedRef<FUcmdTaskLog>& TaskLog : TaskLogs)
+	{
+		TaskLog->Close(TEXT("Editor shut down"));
+	}
+	TaskLogs.Reset();
+}
+
+void FUcmdTaskLogWriter::Add(const TSharedRef<FUcmdTaskLog>& TaskLog)
+{
+	{
+		FScopeLock Lock(&LogsLock);
+		TaskLogs.Add(TaskLog);
+	}
+
+	bPruneLogDir = true;
+}
+
+void FUcmdTaskLogWriter::WakeUp()
+{
+	if (WakeEvent)
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+uint32 FUcmdTaskLogWriter::Run()
+{
+	while (!bStopping)
+	{
+		WakeEvent->Wait(FUcmdTaskLog::WriteIntervalMs);
+
+		WriteAll();
+
+		if (bPruneLogDir.exchange(false))
+		{
+			PruneLogDir();
+		}
+	}
+
+	return 0;
+}
+
+void FUcmdTaskLogWriter::Stop()
+{
+	bStopping = true;
+	WakeUp();
+}
+
+void FUcmdTaskLogWriter::WriteAll()
+{
+	TArray<TSharedRef<FUcmdTaskLog>> OpenLogs;
+	{
+		FScopeLock Lock(&LogsLock);
+		TaskLogs.RemoveAll([](const TSharedRef<FUcmdTaskLog>& TaskLog) { return TaskLog->IsClosed(); });
+		OpenLogs = TaskLogs;
+	}
+
+	for (const TSharedRef<FUcmdTaskLog>& TaskLog : OpenLogs)
+	{
+		TaskLog->WriteBuffered();
+	}
+}
+
+void FUcmdTaskLogWriter::PruneLogDir()
+{
+	const FString LogDir = FUcmdTaskLog::GetLogDir();
+
+	TArray<FString> Files;
+	IFileManager::Get().FindFiles(Files, *(LogDir / TEXT("*.log")), true, false);
+
+	// Rotated parts are named <task log>.<n>.log
+	TArray<FString> TaskLogFiles = Files.FilterByPredicate([](const FString& File) { return !FPaths::GetExtension(FPaths::GetBaseFilename(File)).IsNumeric(); });
+	if (TaskLogFiles.Num() <= FUcmdTaskLog::MaxTaskLogs)
+	{
+		return;
+	}
+
+	// Names start with the start time
+	TaskLogFiles.Sort();
+
+	for (int32 Index = 0; Index < TaskLogFiles.Num() - FUcmdTaskLog::MaxTaskLogs; ++Index)
+	{
+		const FString BasePath = LogDir / FPaths::GetBaseFilename(TaskLogFiles[Index]);
+
+		IFileManager::Get().Delete(*(BasePath + TEXT(".log")), false, false, true);
+		for (int32 Part = 1; Part <= FUcmdTaskLog::MaxRotatedFiles; ++Part)
+		{
+			IFileManager::Get().Delete(*FString::Printf(TEXT("%s.%d.log"), *BasePath, Part), false, false, true);
+		}
+	}
+}
@@ -0,0 +1,110 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+class FArchive;
+class FRunnableThread;
+class FEvent;
+
+/**
+ * The raw output of one UCMD task, in Saved/Logs/UCMD/<start time>_<task>.log.
+ *
+ * Lines are buffered by whichever thread reads the process output and written by FUcmdTaskLogWriter's thread.
+ * A log growing past MaxFileSize is rotated to .1.log, .2.log and so on, keeping the newest output.
+ */
+class FUcmdTaskLog
+{
+public:
+	/** Creates the file and hands it to the writer thread */
+	static TSharedRef<FUcmdTaskLog> Open(const FString& TaskName, const FString& PlatformName);
+
+	/** Any thread */
+	void AppendLine(const FString& Line);
+
+	/** Writes what is left, followed by the task's result */
+	void Close(const FString& Result);
+
+	const FString& GetPath() const { return Path; }
+
+	bool IsClosed() const { return bClosed; }
+
+	static FString GetLogDir();
+
+	static constexpr int64 MaxFileSize = 32 * 1024 * 1024;
+	static constexpr int32 MaxRotatedFiles = 3;
+
+	// Output waiting for the disk beyond this is dropped, and the gap noted in the file
+	static constexpr int32 MaxBufferSize = 8 * 1024 * 1024;
+
+	// Task logs kept in the folder, older ones are deleted with their rotated parts
+	static constexpr int32 MaxTaskLogs = 30;
+
+	// Buffered output that wakes the writer up before its next interval
+	static constexpr int32 WakeUpBufferSize = 1024 * 1024;
+	static constexpr uint32 WriteIntervalMs = 200;
+
+private:
+	friend class FUcmdTaskLogWriter;
+
+	FUcmdTaskLog(const FString& InPath);
+
+	/** Moves the buffer to the file, on the writer thread or when closing */
+	void WriteBuffered();
+
+	void WriteToFile(const ANSICHAR* Data, int64 Size);
+	void Rotate();
+
+	FString Path;
+
+	FCriticalSection BufferLock;
+	TArray<ANSICHAR> Buffer;
+	int64 DroppedBytes = 0;
+
+	FCriticalSection FileLock;
+	TUniquePtr<FArchive> File;
+	int64 FileSize = 0;
+
+	std::atomic<bool> bClosed{ false };
+};
+
+/**
+ * One background thread writing all open task logs, so process output never waits on the disk.
+ */
+class FUcmdTaskLogWriter : public FRunnable
+{
+public:
+	static FUcmdTaskLogWriter& Get();
+
+	void Startup();
+
+	/** Writes and closes whatever is still open */
+	void Shutdown();
+
+	void Add(const TSharedRef<FUcmdTaskLog>& TaskLog);
+
+	/** Called when a buffer filled up, instead of waiting for the next write interval */
+	void WakeUp();
+
+	// FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	void WriteAll();
+
+	/** Deletes the oldest task logs beyond MaxTaskLogs */
+	static void PruneLogDir();
+
+	FCriticalSection LogsLock;
+	TArray<TSharedRef<FUcmdTaskLog>> TaskLogs;
+
+	FRunnableThread* Thread = nullptr;
+	FEvent* WakeEvent = nullptr;
+	std::atomic<bool> bStopping{ false };
+	std::atomic<bool> bPruneLogDir{ true };
+};
@@ -1,5 +1,6 @@
 #!/bin/sh
 
 GAME_PORT=$(echo $ARBITRIUM_PORTS_MAPPING | jq '.ports.gameport.internal')
+ECHO_PORT=$(echo $ARBITRIUM_PORTS_MAPPING | jq '.ports.echo.internal // 0')
 
-$(dirname "$0")/<PROJECT_NAME>Server.sh -log -PORT=$GAME_PORT 
+$(dirname "$0")/<PROJECT_NAME>Server.sh -log -PORT=$GAME_PORT -EdgegapEchoPort=$ECHO_PORT 